@@ -86,6 +86,9 @@ void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 		ResetGroundedEntryMode();
 	}
 
+	RefreshCurvesOnGameThread();
+	RefreshSignificanceOnGameThread();
+
 	RefreshMovementBaseOnGameThread();
 	RefreshViewOnGameThread();
 	RefreshLocomotionOnGameThread();
@@ -109,6 +112,8 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 		return;
 	}
 
+	RefreshSignificance(DeltaTime);
+
 	RefreshLayering();
 	RefreshPose();
 
@@ -155,6 +160,16 @@ void UAlsAnimationInstance::NativePostUpdateAnimation()
 	bPendingUpdate = false;
 }
 
+void UAlsAnimationInstance::NativePostEvaluateAnimation()
+{
+	Super::NativePostEvaluateAnimation();
+
+	// Refresh the curves right after the evaluation, so that the game thread code that runs before the
+	// next animation update (character rotation, camera, footstep effects) reads the latest curve values.
+
+	RefreshCurvesOnGameThread();
+}
+
 FAnimInstanceProxy* UAlsAnimationInstance::CreateAnimInstanceProxy()
 {
 	return new FAlsAnimationInstanceProxy{this};
@@ -178,6 +193,15 @@ FAlsControlRigInput UAlsAnimationInstance::GetControlRigInput() const
 	};
 }
 
+void UAlsAnimationInstance::RefreshCurvesOnGameThread()
+{
+	check(IsInGameThread())
+
+	const auto& Curves{GetProxyOnGameThread<FAlsAnimationInstanceProxy>().GetAnimationCurves(EAnimCurveType::AttributeCurve)};
+
+	CurvesSnapshot.Refresh(Curves, AlsCurvesSnapshot::GetCurveNames());
+}
+
 void UAlsAnimationInstance::RefreshMovementBaseOnGameThread()
 {
 	const auto& BasedMovement{Character->GetBasedMovement()};
@@ -208,73 +232,51 @@ void UAlsAnimationInstance::RefreshMovementBaseOnGameThread()
 
 void UAlsAnimationInstance::RefreshLayering()
 {
-	const auto& Curves{GetProxyOnAnyThread<FAlsAnimationInstanceProxy>().GetAnimationCurves(EAnimCurveType::AttributeCurve)};
-
-	static const auto GetCurveValue{
-		[](const TMap<FName, float>& Curves, const FName& CurveName) -> float
-		{
-			const auto* Value{Curves.Find(CurveName)};
-
-			return Value != nullptr ? *Value : 0.0f;
-		}
-	};
-
-	LayeringState.HeadBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadCurveName());
-	LayeringState.HeadAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadAdditiveCurveName());
-	LayeringState.HeadSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHeadSlotCurveName());
+	LayeringState.HeadBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerHead);
+	LayeringState.HeadAdditiveBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerHeadAdditive);
+	LayeringState.HeadSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerHeadSlot);
 
 	// The mesh space blend will always be 1 unless the local space blend is 1.
 
-	LayeringState.ArmLeftBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftCurveName());
-	LayeringState.ArmLeftAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftAdditiveCurveName());
-	LayeringState.ArmLeftSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftSlotCurveName());
-	LayeringState.ArmLeftLocalSpaceBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmLeftLocalSpaceCurveName());
+	LayeringState.ArmLeftBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmLeft);
+	LayeringState.ArmLeftAdditiveBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmLeftAdditive);
+	LayeringState.ArmLeftSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmLeftSlot);
+	LayeringState.ArmLeftLocalSpaceBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmLeftLocalSpace);
 	LayeringState.ArmLeftMeshSpaceBlendAmount = !FAnimWeight::IsFullWeight(LayeringState.ArmLeftLocalSpaceBlendAmount);
 
 	// The mesh space blend will always be 1 unless the local space blend is 1.
 
-	LayeringState.ArmRightBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightCurveName());
-	LayeringState.ArmRightAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightAdditiveCurveName());
-	LayeringState.ArmRightSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightSlotCurveName());
-	LayeringState.ArmRightLocalSpaceBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerArmRightLocalSpaceCurveName());
+	LayeringState.ArmRightBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmRight);
+	LayeringState.ArmRightAdditiveBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmRightAdditive);
+	LayeringState.ArmRightSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmRightSlot);
+	LayeringState.ArmRightLocalSpaceBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerArmRightLocalSpace);
 	LayeringState.ArmRightMeshSpaceBlendAmount = !FAnimWeight::IsFullWeight(LayeringState.ArmRightLocalSpaceBlendAmount);
 
-	LayeringState.HandLeftBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHandLeftCurveName());
-	LayeringState.HandRightBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerHandRightCurveName());
+	LayeringState.HandLeftBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerHandLeft);
+	LayeringState.HandRightBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerHandRight);
 
-	LayeringState.SpineBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineCurveName());
-	LayeringState.SpineAdditiveBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineAdditiveCurveName());
-	LayeringState.SpineSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerSpineSlotCurveName());
+	LayeringState.SpineBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerSpine);
+	LayeringState.SpineAdditiveBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerSpineAdditive);
+	LayeringState.SpineSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerSpineSlot);
 
-	LayeringState.PelvisBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerPelvisCurveName());
-	LayeringState.PelvisSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerPelvisSlotCurveName());
+	LayeringState.PelvisBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerPelvis);
+	LayeringState.PelvisSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerPelvisSlot);
 
-	LayeringState.LegsBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerLegsCurveName());
-	LayeringState.LegsSlotBlendAmount = GetCurveValue(Curves, UAlsConstants::LayerLegsSlotCurveName());
+	LayeringState.LegsBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerLegs);
+	LayeringState.LegsSlotBlendAmount = CurvesSnapshot.Get(EAlsCurve::LayerLegsSlot);
 }
 
 void UAlsAnimationInstance::RefreshPose()
 {
-	const auto& Curves{GetProxyOnAnyThread<FAlsAnimationInstanceProxy>().GetAnimationCurves(EAnimCurveType::AttributeCurve)};
-
-	static const auto GetCurveValue{
-		[](const TMap<FName, float>& Curves, const FName& CurveName) -> float
-		{
-			const auto* Value{Curves.Find(CurveName)};
+	PoseState.GroundedAmount = CurvesSnapshot.Get(EAlsCurve::PoseGrounded);
+	PoseState.InAirAmount = CurvesSnapshot.Get(EAlsCurve::PoseInAir);
 
-			return Value != nullptr ? *Value : 0.0f;
-		}
-	};
+	PoseState.StandingAmount = CurvesSnapshot.Get(EAlsCurve::PoseStanding);
+	PoseState.CrouchingAmount = CurvesSnapshot.Get(EAlsCurve::PoseCrouching);
 
-	PoseState.GroundedAmount = GetCurveValue(Curves, UAlsConstants::PoseGroundedCurveName());
-	PoseState.InAirAmount = GetCurveValue(Curves, UAlsConstants::PoseInAirCurveName());
+	PoseState.MovingAmount = CurvesSnapshot.Get(EAlsCurve::PoseMoving);
 
-	PoseState.StandingAmount = GetCurveValue(Curves, UAlsConstants::PoseStandingCurveName());
-	PoseState.CrouchingAmount = GetCurveValue(Curves, UAlsConstants::PoseCrouchingCurveName());
-
-	PoseState.MovingAmount = GetCurveValue(Curves, UAlsConstants::PoseMovingCurveName());
-
-	PoseState.GaitAmount = FMath::Clamp(GetCurveValue(Curves, UAlsConstants::PoseGaitCurveName()), 0.0f, 3.0f);
+	PoseState.GaitAmount = FMath::Clamp(CurvesSnapshot.Get(EAlsCurve::PoseGait), 0.0f, 3.0f);
 	PoseState.GaitWalkingAmount = UAlsMath::Clamp01(PoseState.GaitAmount);
 	PoseState.GaitRunningAmount = UAlsMath::Clamp01(PoseState.GaitAmount - 1.0f);
 	PoseState.GaitSprintingAmount = UAlsMath::Clamp01(PoseState.GaitAmount - 2.0f);
@@ -291,6 +293,50 @@ void UAlsAnimationInstance::RefreshPose()
 	PoseState.UnweightedGaitSprintingAmount = UAlsMath::Clamp01(PoseState.UnweightedGaitAmount - 2.0f);
 }
 
+const FAlsAnimationSignificanceTierSettings& UAlsAnimationInstance::GetSignificanceTierSettings() const
+{
+	const auto& Tiers{Settings->Significance.Tiers};
+	if (Tiers.IsEmpty())
+	{
+		static const FAlsAnimationSignificanceTierSettings DefaultTierSettings;
+		return DefaultTierSettings;
+	}
+
+	return Tiers[FMath::Min(SignificanceState.Tier, Tiers.Num() - 1)];
+}
+
+void UAlsAnimationInstance::RefreshSignificanceOnGameThread()
+{
+	check(IsInGameThread())
+
+	SignificanceState.Tier = Character->GetSignificanceTier();
+}
+
+void UAlsAnimationInstance::RefreshSignificance(const float DeltaTime)
+{
+	const auto& TierSettings{GetSignificanceTierSettings()};
+
+	const auto TargetFeetIkAmount{TierSettings.bEnableFeetIk ? 1.0f : 0.0f};
+	const auto TargetGroundPredictionAmount{TierSettings.bEnableGroundPrediction ? 1.0f : 0.0f};
+
+	if (bPendingUpdate || Settings->Significance.HandOffDuration <= UE_KINDA_SMALL_NUMBER)
+	{
+		SignificanceState.FeetIkAmount = TargetFeetIkAmount;
+		SignificanceState.GroundPredictionAmount = TargetGroundPredictionAmount;
+		return;
+	}
+
+	// Fade the features in or out over the hand-off duration, so that a tier change doesn't cause a visible pop.
+
+	const auto HandOffSpeed{1.0f / Settings->Significance.HandOffDuration};
+
+	SignificanceState.FeetIkAmount = FMath::FInterpConstantTo(SignificanceState.FeetIkAmount, TargetFeetIkAmount,
+	                                                          DeltaTime, HandOffSpeed);
+
+	SignificanceState.GroundPredictionAmount = FMath::FInterpConstantTo(SignificanceState.GroundPredictionAmount,
+	                                                                    TargetGroundPredictionAmount, DeltaTime, HandOffSpeed);
+}
+
 void UAlsAnimationInstance::RefreshViewOnGameThread()
 {
 	check(IsInGameThread())
@@ -316,8 +362,8 @@ void UAlsAnimationInstance::RefreshView(const float DeltaTime)
 		ViewState.PitchAmount = 0.5f - ViewState.PitchAngle / 180.0f;
 	}
 
-	const auto ViewAmount{1.0f - GetCurveValueClamped01(UAlsConstants::ViewBlockCurveName())};
-	const auto AimingAmount{GetCurveValueClamped01(UAlsConstants::AllowAimingCurveName())};
+	const auto ViewAmount{1.0f - CurvesSnapshot.GetClamped01(EAlsCurve::ViewBlock)};
+	const auto AimingAmount{CurvesSnapshot.GetClamped01(EAlsCurve::AllowAiming)};
 
 	ViewState.LookAmount = ViewAmount * (1.0f - AimingAmount);
 
@@ -504,8 +550,8 @@ void UAlsAnimationInstance::RefreshGrounded(const float DeltaTime)
 {
 	// Always sample sprint block curve, otherwise issues with inertial blending may occur.
 
-	GroundedState.SprintBlockAmount = GetCurveValueClamped01(UAlsConstants::SprintBlockCurveName());
-	GroundedState.HipsDirectionLockAmount = FMath::Clamp(GetCurveValue(UAlsConstants::HipsDirectionLockCurveName()), -1.0f, 1.0f);
+	GroundedState.SprintBlockAmount = CurvesSnapshot.GetClamped01(EAlsCurve::SprintBlock);
+	GroundedState.HipsDirectionLockAmount = FMath::Clamp(CurvesSnapshot.Get(EAlsCurve::HipsDirectionLock), -1.0f, 1.0f);
 
 	if (LocomotionMode != AlsLocomotionModeTags::Grounded)
 	{
@@ -755,6 +801,88 @@ void UAlsAnimationInstance::RefreshInAirOnGameThread()
 
 	InAirState.bJumped = !bPendingUpdate && (InAirState.bJumped || InAirState.bJumpRequested);
 	InAirState.bJumpRequested = false;
+
+	RefreshGroundPredictionOnGameThread();
+}
+
+void UAlsAnimationInstance::RefreshGroundPredictionOnGameThread()
+{
+	check(IsInGameThread())
+
+	// Consume the result of the sweep submitted during the previous update. Asynchronous traces submitted by all characters
+	// during a frame are executed together by the world in a single batch, off the game thread and the animation worker
+	// threads. The result is only available during the next frame, so if the animation instance skipped a frame, the
+	// result is lost, and the previous time of impact is kept until the next sweep completes.
+
+	auto* World{GetWorld()};
+
+	if (GroundPredictionSweepHandle.IsValid())
+	{
+		FTraceDatum SweepData;
+		if (World->QueryTraceData(GroundPredictionSweepHandle, SweepData))
+		{
+			const auto* Hit{SweepData.OutHits.FindByPredicate([](const FHitResult& OutHit) { return OutHit.bBlockingHit; })};
+
+			const auto bGroundValid{
+				Hit != nullptr && Hit->IsValidBlockingHit() && Hit->ImpactNormal.Z >= LocomotionState.WalkableFloorZ
+			};
+
+			GroundPredictionHitTime = bGroundValid ? Hit->Time : -1.0f;
+
+#if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
+			if (bDisplayDebugTraces)
+			{
+				UAlsUtility::DrawDebugSweepSingleCapsule(World, SweepData.Start, SweepData.End, FRotator::ZeroRotator,
+				                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
+				                                         bGroundValid, Hit != nullptr ? *Hit : FHitResult{},
+				                                         {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
+			}
+#endif
+		}
+
+		GroundPredictionSweepHandle.Invalidate();
+	}
+
+	// Submit a new sweep only if its result is going to be used. This mirrors the checks in
+	// UAlsAnimationInstance::RefreshGroundPredictionAmount(), but uses values from the previous update.
+
+	static constexpr auto VerticalVelocityThreshold{-200.0f};
+
+	const auto VerticalVelocity{UE_REAL_TO_FLOAT(LocomotionState.Velocity.Z)};
+
+	if (LocomotionMode != AlsLocomotionModeTags::InAir || VerticalVelocity > VerticalVelocityThreshold ||
+	    CurvesSnapshot.GetClamped01(EAlsCurve::GroundPredictionBlock) >= 1.0f - UE_KINDA_SMALL_NUMBER ||
+	    (SignificanceState.GroundPredictionAmount <= 0.0f && !GetSignificanceTierSettings().bEnableGroundPrediction))
+	{
+		GroundPredictionHitTime = -1.0f;
+		return;
+	}
+
+	const auto SweepStartLocation{LocomotionState.Location};
+
+	static constexpr auto MinVerticalVelocity{-4000.0f};
+	static constexpr auto MaxVerticalVelocity{-200.0f};
+
+	auto VelocityDirection{LocomotionState.Velocity};
+	VelocityDirection.Z = FMath::Clamp(VelocityDirection.Z, MinVerticalVelocity, MaxVerticalVelocity);
+	VelocityDirection.Normalize();
+
+	static constexpr auto MinSweepDistance{150.0f};
+	static constexpr auto MaxSweepDistance{2000.0f};
+
+	const auto SweepVector{
+		VelocityDirection * FMath::GetMappedRangeValueClamped(FVector2f{MaxVerticalVelocity, MinVerticalVelocity},
+		                                                      {MinSweepDistance, MaxSweepDistance},
+		                                                      VerticalVelocity) * LocomotionState.Scale
+	};
+
+	GroundPredictionSweepHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, SweepStartLocation,
+	                                                         SweepStartLocation + SweepVector, FQuat::Identity,
+	                                                         Settings->InAir.GroundPredictionSweepChannel,
+	                                                         FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius,
+	                                                                                      LocomotionState.CapsuleHalfHeight),
+	                                                         {__FUNCTION__, false, Character},
+	                                                         Settings->InAir.GroundPredictionSweepResponses);
 }
 
 void UAlsAnimationInstance::RefreshInAir(const float DeltaTime)
@@ -788,71 +916,23 @@ void UAlsAnimationInstance::RefreshGroundPredictionAmount()
 	// is falling toward and getting the "time" (range from 0 to 1, 1 being maximum, 0 being about to ground) till impact.
 	// The ground prediction amount curve is used to control how the time affects the final amount for a smooth blend.
 
-	static constexpr auto VerticalVelocityThreshold{-200.0f};
+	// The sweep itself is performed asynchronously, see UAlsAnimationInstance::RefreshGroundPredictionOnGameThread().
 
-	if (InAirState.VerticalVelocity > VerticalVelocityThreshold)
-	{
-		InAirState.GroundPredictionAmount = 0.0f;
-		return;
-	}
+	static constexpr auto VerticalVelocityThreshold{-200.0f};
 
-	const auto AllowanceAmount{1.0f - GetCurveValueClamped01(UAlsConstants::GroundPredictionBlockCurveName())};
-	if (AllowanceAmount <= UE_KINDA_SMALL_NUMBER)
+	if (InAirState.VerticalVelocity > VerticalVelocityThreshold || GroundPredictionHitTime < 0.0f)
 	{
 		InAirState.GroundPredictionAmount = 0.0f;
 		return;
 	}
 
-	const auto SweepStartLocation{LocomotionState.Location};
-
-	static constexpr auto MinVerticalVelocity{-4000.0f};
-	static constexpr auto MaxVerticalVelocity{-200.0f};
-
-	auto VelocityDirection{LocomotionState.Velocity};
-	VelocityDirection.Z = FMath::Clamp(VelocityDirection.Z, MinVerticalVelocity, MaxVerticalVelocity);
-	VelocityDirection.Normalize();
-
-	static constexpr auto MinSweepDistance{150.0f};
-	static constexpr auto MaxSweepDistance{2000.0f};
-
-	const auto SweepVector{
-		VelocityDirection * FMath::GetMappedRangeValueClamped(FVector2f{MaxVerticalVelocity, MinVerticalVelocity},
-		                                                      {MinSweepDistance, MaxSweepDistance},
-		                                                      InAirState.VerticalVelocity) * LocomotionState.Scale
+	const auto AllowanceAmount{
+		(1.0f - CurvesSnapshot.GetClamped01(EAlsCurve::GroundPredictionBlock)) * SignificanceState.GroundPredictionAmount
 	};
 
-	FHitResult Hit;
-	GetWorld()->SweepSingleByChannel(Hit, SweepStartLocation, SweepStartLocation + SweepVector,
-	                                 FQuat::Identity, Settings->InAir.GroundPredictionSweepChannel,
-	                                 FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight),
-	                                 {__FUNCTION__, false, Character}, Settings->InAir.GroundPredictionSweepResponses);
-
-	const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorZ};
-
-#if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
-	if (bDisplayDebugTraces)
-	{
-		if (IsInGameThread())
-		{
-			UAlsUtility::DrawDebugSweepSingleCapsule(GetWorld(), Hit.TraceStart, Hit.TraceEnd, FRotator::ZeroRotator,
-			                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
-			                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
-		}
-		else
-		{
-			DisplayDebugTracesQueue.Emplace([this, Hit, bGroundValid]
-				{
-					UAlsUtility::DrawDebugSweepSingleCapsule(GetWorld(), Hit.TraceStart, Hit.TraceEnd, FRotator::ZeroRotator,
-					                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
-					                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
-				}
-			);
-		}
-	}
-#endif
-
-	InAirState.GroundPredictionAmount = bGroundValid
-		                                    ? Settings->InAir.GroundPredictionAmountCurve->GetFloatValue(Hit.Time) * AllowanceAmount
+	InAirState.GroundPredictionAmount = AllowanceAmount > UE_KINDA_SMALL_NUMBER
+		                                    ? Settings->InAir.GroundPredictionAmountCurve->GetFloatValue(GroundPredictionHitTime) *
+		                                      AllowanceAmount
 		                                    : 0.0f;
 }
 
@@ -893,6 +973,13 @@ void UAlsAnimationInstance::RefreshFeetOnGameThread()
 {
 	check(IsInGameThread())
 
+	if (SignificanceState.FeetIkAmount <= 0.0f && !GetSignificanceTierSettings().bEnableFeetIk)
+	{
+		// Foot IK is fully disabled by the current significance tier, so the target transforms are not used.
+
+		return;
+	}
+
 	const auto* Mesh{GetSkelMeshComponent()};
 
 	const auto FootLeftTargetTransform{
@@ -916,31 +1003,36 @@ void UAlsAnimationInstance::RefreshFeetOnGameThread()
 
 void UAlsAnimationInstance::RefreshFeet(const float DeltaTime)
 {
-	FeetState.FootPlantedAmount = FMath::Clamp(GetCurveValue(UAlsConstants::FootPlantedCurveName()), -1.0f, 1.0f);
-	FeetState.FeetCrossingAmount = GetCurveValueClamped01(UAlsConstants::FeetCrossingCurveName());
+	FeetState.FootPlantedAmount = FMath::Clamp(CurvesSnapshot.Get(EAlsCurve::FootPlanted), -1.0f, 1.0f);
+	FeetState.FeetCrossingAmount = CurvesSnapshot.GetClamped01(EAlsCurve::FeetCrossing);
 
 	FeetState.MinMaxPelvisOffsetZ = FVector2f::ZeroVector;
 
 	const auto ComponentTransformInverse{GetProxyOnAnyThread<FAnimInstanceProxy>().GetComponentTransform().Inverse()};
 
-	RefreshFoot(FeetState.Left, UAlsConstants::FootLeftIkCurveName(), UAlsConstants::FootLeftLockCurveName(),
+	RefreshFoot(FeetState.Left, EAlsCurve::FootLeftIk, EAlsCurve::FootLeftLock,
 	            Settings->Feet.LeftFootLimits, ComponentTransformInverse, DeltaTime);
 
-	RefreshFoot(FeetState.Right, UAlsConstants::FootRightIkCurveName(), UAlsConstants::FootRightLockCurveName(),
+	RefreshFoot(FeetState.Right, EAlsCurve::FootRightIk, EAlsCurve::FootRightLock,
 	            Settings->Feet.RightFootLimits, ComponentTransformInverse, DeltaTime);
 
 	FeetState.MinMaxPelvisOffsetZ.X = UE_REAL_TO_FLOAT(
-		FMath::Min(FeetState.Left.OffsetTargetLocationZ, FeetState.Right.OffsetTargetLocationZ) / LocomotionState.Scale);
+		FMath::Min(FeetState.Left.OffsetTargetLocationZ, FeetState.Right.OffsetTargetLocationZ) / LocomotionState.Scale) *
+		SignificanceState.FeetIkAmount;
 
 	FeetState.MinMaxPelvisOffsetZ.Y = UE_REAL_TO_FLOAT(
-		FMath::Max(FeetState.Left.OffsetTargetLocationZ, FeetState.Right.OffsetTargetLocationZ) / LocomotionState.Scale);
+		FMath::Max(FeetState.Left.OffsetTargetLocationZ, FeetState.Right.OffsetTargetLocationZ) / LocomotionState.Scale) *
+		SignificanceState.FeetIkAmount;
 }
 
-void UAlsAnimationInstance::RefreshFoot(FAlsFootState& FootState, const FName& FootIkCurveName,
-                                        const FName& FootLockCurveName, const FAlsFootLimitsSettings& LimitsSettings,
+void UAlsAnimationInstance::RefreshFoot(FAlsFootState& FootState, const EAlsCurve FootIkCurve,
+                                        const EAlsCurve FootLockCurve, const FAlsFootLimitsSettings& LimitsSettings,
                                         const FTransform& ComponentTransformInverse, const float DeltaTime) const
 {
-	FootState.IkAmount = GetCurveValueClamped01(FootIkCurveName);
+	// When foot IK is disabled by the significance tier, the IK amount reaches zero, which
+	// also releases the foot lock and skips the foot offset traces.
+
+	FootState.IkAmount = CurvesSnapshot.GetClamped01(FootIkCurve) * SignificanceState.FeetIkAmount;
 
 	ProcessFootLockTeleport(FootState);
 
@@ -949,7 +1041,7 @@ void UAlsAnimationInstance::RefreshFoot(FAlsFootState& FootState, const FName& F
 	auto FinalLocation{FootState.TargetLocation};
 	auto FinalRotation{FootState.TargetRotation};
 
-	RefreshFootLock(FootState, FootLockCurveName, ComponentTransformInverse, DeltaTime, FinalLocation, FinalRotation);
+	RefreshFootLock(FootState, FootLockCurve, ComponentTransformInverse, DeltaTime, FinalLocation, FinalRotation);
 
 	const auto PreviousFinalRotation{FinalRotation};
 	RefreshFootOffset(FootState, DeltaTime, FinalLocation, FinalRotation);
@@ -1019,11 +1111,11 @@ void UAlsAnimationInstance::ProcessFootLockBaseChange(FAlsFootState& FootState,
 	}
 }
 
-void UAlsAnimationInstance::RefreshFootLock(FAlsFootState& FootState, const FName& FootLockCurveName,
+void UAlsAnimationInstance::RefreshFootLock(FAlsFootState& FootState, const EAlsCurve FootLockCurve,
                                             const FTransform& ComponentTransformInverse, const float DeltaTime,
                                             FVector& FinalLocation, FQuat& FinalRotation) const
 {
-	auto NewFootLockAmount{GetCurveValueClamped01(FootLockCurveName)};
+	auto NewFootLockAmount{CurvesSnapshot.GetClamped01(FootLockCurve)};
 
 	if (LocomotionState.bMovingSmooth || LocomotionMode != AlsLocomotionModeTags::Grounded)
 	{
@@ -1407,7 +1499,8 @@ void UAlsAnimationInstance::RefreshTransitions()
 {
 	// The allow transitions curve is modified within certain states, so that transitions allowed will be true while in those states.
 
-	TransitionsState.bTransitionsAllowed = FAnimWeight::IsFullWeight(GetCurveValue(UAlsConstants::AllowTransitionsCurveName()));
+	TransitionsState.bTransitionsAllowed = GetSignificanceTierSettings().bEnableTransitions &&
+	                                       FAnimWeight::IsFullWeight(CurvesSnapshot.Get(EAlsCurve::AllowTransitions));
 
 	RefreshDynamicTransition();
 }
@@ -1547,7 +1640,8 @@ void UAlsAnimationInstance::RefreshRotateInPlace(const float DeltaTime)
 
 	// Rotate in place is allowed only if the character is standing still and aiming or in first-person view mode.
 
-	if (LocomotionState.bMoving || LocomotionMode != AlsLocomotionModeTags::Grounded || !IsRotateInPlaceAllowed())
+	if (LocomotionState.bMoving || LocomotionMode != AlsLocomotionModeTags::Grounded ||
+	    !GetSignificanceTierSettings().bEnableRotateInPlace || !IsRotateInPlaceAllowed())
 	{
 		RotateInPlaceState.bRotatingLeft = false;
 		RotateInPlaceState.bRotatingRight = false;
@@ -1608,7 +1702,8 @@ void UAlsAnimationInstance::RefreshTurnInPlace(const float DeltaTime)
 	// Turn in place is allowed only if transitions are allowed, the character
 	// standing still and looking at the camera and not in first-person mode.
 
-	if (LocomotionState.bMoving || LocomotionMode != AlsLocomotionModeTags::Grounded || !IsTurnInPlaceAllowed())
+	if (LocomotionState.bMoving || LocomotionMode != AlsLocomotionModeTags::Grounded ||
+	    !GetSignificanceTierSettings().bEnableTurnInPlace || !IsTurnInPlaceAllowed())
 	{
 		TurnInPlaceState.ActivationDelay = 0.0f;
 		TurnInPlaceState.bFootLockInhibited = false;
@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
+#include "AlsSignificanceSubsystem.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -184,6 +185,26 @@ void AAlsCharacter::BeginPlay()
 	RefreshGait();
 
 	OnOverlayModeChanged(OverlayMode);
+
+	ConfiguredTickInterval = GetActorTickInterval();
+	ConfiguredMeshTickInterval = GetMesh()->GetComponentTickInterval();
+
+	auto* SignificanceSubsystem{GetWorld()->GetSubsystem<UAlsSignificanceSubsystem>()};
+	if (IsValid(SignificanceSubsystem))
+	{
+		SignificanceSubsystem->RegisterCharacter(this);
+	}
+}
+
+void AAlsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto* SignificanceSubsystem{GetWorld()->GetSubsystem<UAlsSignificanceSubsystem>()};
+	if (IsValid(SignificanceSubsystem))
+	{
+		SignificanceSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAlsCharacter::PostNetReceiveLocationAndRotation()
@@ -285,7 +306,12 @@ void AAlsCharacter::Tick(const float DeltaTime)
 	RefreshGroundedRotation(DeltaTime);
 	RefreshInAirRotation(DeltaTime);
 
-	StartMantlingInAir();
+	const auto* SignificanceTierSettings{GetSignificanceTierSettings()};
+	if (SignificanceTierSettings == nullptr || SignificanceTierSettings->bAllowMantlingInAir)
+	{
+		StartMantlingInAir();
+	}
+
 	RefreshMantling();
 	RefreshRagdolling(DeltaTime);
 	RefreshRolling(DeltaTime);
@@ -314,6 +340,90 @@ void AAlsCharacter::Restart()
 	ApplyDesiredStance();
 }
 
+const FAlsCharacterSignificanceTierSettings* AAlsCharacter::GetSignificanceTierSettings() const
+{
+	if (!IsValid(Settings) || !Settings->Significance.bEnableSignificance || Settings->Significance.Tiers.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return &Settings->Significance.Tiers[FMath::Min(SignificanceTier, Settings->Significance.Tiers.Num() - 1)];
+}
+
+void AAlsCharacter::RefreshSignificanceTier(const TConstArrayView<FVector> ViewLocations)
+{
+	// Player controlled characters always use the most significant tier because they are either viewed
+	// directly by their player, or simulated on the server, where any inaccuracy affects gameplay.
+
+	if (!IsValid(Settings) || !Settings->Significance.bEnableSignificance ||
+	    Settings->Significance.Tiers.IsEmpty() || IsPlayerControlled())
+	{
+		SetSignificanceTier(0);
+		return;
+	}
+
+	const auto& SignificanceSettings{Settings->Significance};
+	const auto ActorLocation{GetActorLocation()};
+
+	// Without any view locations, the distance remains infinite and the least significant tier is used.
+
+	auto ViewDistanceSquared{TNumericLimits<double>::Max()};
+
+	for (const auto& ViewLocation : ViewLocations)
+	{
+		ViewDistanceSquared = FMath::Min(ViewDistanceSquared, FVector::DistSquared(ViewLocation, ActorLocation));
+	}
+
+	const auto ViewDistance{FMath::Sqrt(ViewDistanceSquared)};
+	const auto LastTier{SignificanceSettings.Tiers.Num() - 1};
+
+	auto NewTier{0};
+
+	while (NewTier < LastTier)
+	{
+		// Moving to a more significant tier requires getting closer than the tier boundary by the hysteresis distance.
+
+		const auto MaxDistance{
+			NewTier < SignificanceTier
+				? SignificanceSettings.Tiers[NewTier].MaxDistance - SignificanceSettings.HysteresisDistance
+				: SignificanceSettings.Tiers[NewTier].MaxDistance
+		};
+
+		if (ViewDistance <= MaxDistance)
+		{
+			break;
+		}
+
+		NewTier += 1;
+	}
+
+	if (!IsNetMode(NM_DedicatedServer) && !GetMesh()->WasRecentlyRendered())
+	{
+		NewTier = FMath::Min(NewTier + SignificanceSettings.NotRenderedTierOffset, LastTier);
+	}
+
+	SetSignificanceTier(NewTier);
+}
+
+void AAlsCharacter::SetSignificanceTier(const int32 NewTier)
+{
+	if (SignificanceTier == NewTier)
+	{
+		return;
+	}
+
+	SignificanceTier = NewTier;
+
+	const auto* SignificanceTierSettings{GetSignificanceTierSettings()};
+	const auto TierTickInterval{SignificanceTierSettings != nullptr ? SignificanceTierSettings->TickInterval : 0.0f};
+
+	SetActorTickInterval(FMath::Max(ConfiguredTickInterval, TierTickInterval));
+
+	// The animation instance is updated when the mesh ticks, so the mesh follows the tier as well.
+
+	GetMesh()->SetComponentTickInterval(FMath::Max(ConfiguredMeshTickInterval, TierTickInterval));
+}
+
 void AAlsCharacter::RefreshMeshProperties() const
 {
 	const auto bStandalone{IsNetMode(NM_Standalone)};
@@ -1560,7 +1670,7 @@ void AAlsCharacter::RefreshGroundedRotation(const float DeltaTime)
 			Gait == AlsGaitTags::Sprinting
 				? LocomotionState.VelocityYawAngle
 				: UE_REAL_TO_FLOAT(ViewState.Rotation.Yaw +
-					GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawOffsetCurveName()))
+					AnimationInstance->GetCurvesSnapshot().Get(EAlsCurve::RotationYawOffset))
 		};
 
 		static constexpr auto TargetYawAngleRotationSpeed{500.0f};
@@ -1692,7 +1802,7 @@ float AAlsCharacter::CalculateGroundedMovingRotationInterpolationSpeed() const
 
 void AAlsCharacter::ApplyRotationYawSpeedAnimationCurve(const float DeltaTime)
 {
-	const auto DeltaYawAngle{GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawSpeedCurveName()) * DeltaTime};
+	const auto DeltaYawAngle{AnimationInstance->GetCurvesSnapshot().Get(EAlsCurve::RotationYawSpeed) * DeltaTime};
 	if (FMath::Abs(DeltaYawAngle) > UE_SMALL_NUMBER)
 	{
 		auto NewRotation{GetActorRotation()};
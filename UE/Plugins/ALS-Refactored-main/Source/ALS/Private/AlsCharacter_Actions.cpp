@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
+#include "AlsMantlingSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
@@ -142,8 +143,98 @@ bool AAlsCharacter::StartMantlingGrounded()
 
 bool AAlsCharacter::StartMantlingInAir()
 {
-	return LocomotionMode == AlsLocomotionModeTags::InAir && IsLocallyControlled() &&
-	       StartMantling(Settings->Mantling.InAirTrace);
+	if (LocomotionMode != AlsLocomotionModeTags::InAir || !IsLocallyControlled())
+	{
+		return false;
+	}
+
+	// Player controlled characters probe every frame and are not limited by the budget, so that mantling stays responsive.
+
+	if (IsPlayerControlled())
+	{
+		return StartMantling(Settings->Mantling.InAirTrace);
+	}
+
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+	if (WorldTime < NextMantlingInAirProbeTime)
+	{
+		return false;
+	}
+
+	NextMantlingInAirProbeTime = WorldTime + Settings->Mantling.InAirProbeInterval;
+
+	return StartMantling(Settings->Mantling.InAirTrace, true);
+}
+
+bool AAlsCharacter::TryConsumeMantlingInAirProbeQueries(const int32 NumQueries)
+{
+	auto* MantlingSubsystem{GetWorld()->GetSubsystem<UAlsMantlingSubsystem>()};
+
+	if (!IsValid(MantlingSubsystem) ||
+	    MantlingSubsystem->TryConsumeQueries(NumQueries, Settings->Mantling.MaxInAirProbeQueriesPerFrame,
+	                                         MantlingInAirProbeLastServedFrame))
+	{
+		return true;
+	}
+
+	// Retry on the next frame instead of waiting for the full probe interval. Nothing has been traced yet, so no work is lost.
+
+	NextMantlingInAirProbeTime = 0.0;
+	return false;
+}
+
+void AAlsCharacter::RefundMantlingInAirProbeQueries(const int32 NumQueries) const
+{
+	auto* MantlingSubsystem{GetWorld()->GetSubsystem<UAlsMantlingSubsystem>()};
+	if (IsValid(MantlingSubsystem))
+	{
+		MantlingSubsystem->RefundQueries(NumQueries);
+	}
+}
+
+bool AAlsCharacter::IsMantlingLedgeKnownToFail(const UPrimitiveComponent* Primitive, const FVector& ImpactPoint,
+                                               const float CapsuleScale) const
+{
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+	const auto MaxDistanceSquared{FMath::Square(Settings->Mantling.FailedLedgeCacheDistance * CapsuleScale)};
+
+	for (const auto& FailedLedge : FailedMantlingLedges)
+	{
+		if (FailedLedge.ExpirationTime > WorldTime && FailedLedge.Primitive == Primitive &&
+		    FVector::DistSquared(FailedLedge.ImpactPoint, ImpactPoint) <= MaxDistanceSquared)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void AAlsCharacter::RememberFailedMantlingLedge(const UPrimitiveComponent* Primitive, const FVector& ImpactPoint)
+{
+	if (Settings->Mantling.FailedLedgeCacheDuration <= 0.0f)
+	{
+		return;
+	}
+
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	FailedMantlingLedges.RemoveAll([WorldTime](const FAlsMantlingFailedLedge& FailedLedge)
+	{
+		return FailedLedge.ExpirationTime <= WorldTime || !FailedLedge.Primitive.IsValid();
+	});
+
+	static constexpr auto MaxFailedLedges{4};
+
+	if (FailedMantlingLedges.Num() >= MaxFailedLedges)
+	{
+		FailedMantlingLedges.RemoveAt(0, 1, false);
+	}
+
+	auto& FailedLedge{FailedMantlingLedges.Emplace_GetRef()};
+	FailedLedge.Primitive = Primitive;
+	FailedLedge.ImpactPoint = ImpactPoint;
+	FailedLedge.ExpirationTime = WorldTime + Settings->Mantling.FailedLedgeCacheDuration;
 }
 
 bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
@@ -151,7 +242,7 @@ bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
 	return !LocomotionAction.IsValid();
 }
 
-bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings)
+bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings, const bool bInAirProbe)
 {
 	if (!Settings->Mantling.bAllowMantling || GetLocalRole() <= ROLE_SimulatedProxy || !IsMantlingAllowedToStart())
 	{
@@ -206,6 +297,17 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 
 	static const FName ForwardTraceTag{FString::Printf(TEXT("%hs (Forward Trace)"), __FUNCTION__)};
 
+	// Reserve the queries of the whole probe (the forward sweep, the downward trace and two overlaps) up front, so that a
+	// saturated budget can't let the forward sweep through only to refuse the validation and repeat the sweep every frame.
+
+	static constexpr auto NumInAirProbeQueries{4};
+	static constexpr auto NumInAirProbeValidationQueries{3};
+
+	if (bInAirProbe && !TryConsumeMantlingInAirProbeQueries(NumInAirProbeQueries))
+	{
+		return false;
+	}
+
 	auto ForwardTraceStart{CapsuleBottomLocation - ForwardTraceDirection * CapsuleRadius};
 	ForwardTraceStart.Z += (TraceSettings.LedgeHeight.X + TraceSettings.LedgeHeight.Y) *
 		0.5f * CapsuleScale - UCharacterMovementComponent::MAX_FLOOR_DIST;
@@ -237,6 +339,19 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		}
 #endif
 
+		if (bInAirProbe)
+		{
+			RefundMantlingInAirProbeQueries(NumInAirProbeValidationQueries);
+		}
+
+		return false;
+	}
+
+	// Only escalate to the full ledge validation if it hasn't recently failed for the same ledge.
+
+	if (bInAirProbe && IsMantlingLedgeKnownToFail(TargetPrimitive, ForwardTraceHit.ImpactPoint, CapsuleScale))
+	{
+		RefundMantlingInAirProbeQueries(NumInAirProbeValidationQueries);
 		return false;
 	}
 
@@ -294,6 +409,11 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		}
 #endif
 
+		if (bInAirProbe)
+		{
+			RememberFailedMantlingLedge(TargetPrimitive, ForwardTraceHit.ImpactPoint);
+		}
+
 		return false;
 	}
 
@@ -329,6 +449,11 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		}
 #endif
 
+		if (bInAirProbe)
+		{
+			RememberFailedMantlingLedge(TargetPrimitive, ForwardTraceHit.ImpactPoint);
+		}
+
 		return false;
 	}
 
@@ -368,6 +493,11 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		}
 #endif
 
+		if (bInAirProbe)
+		{
+			RememberFailedMantlingLedge(TargetPrimitive, ForwardTraceHit.ImpactPoint);
+		}
+
 		return false;
 	}
 
@@ -0,0 +1,64 @@
+#include "AlsMantlingSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMantlingSubsystem)
+
+bool UAlsMantlingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAlsMantlingSubsystem::TryConsumeQueries(const int32 NumQueries, const int32 MaxQueriesPerFrame, uint64& LastServedFrame)
+{
+	// The budget is reset lazily on the first request of each frame, so the subsystem doesn't need to tick.
+
+	if (BudgetFrameCounter != GFrameCounter)
+	{
+		// Denied requesters retry during the next frame, so reserve queries for the ones that have waited the longest.
+
+		NumReservedQueries = NumOldestDeniedQueriesThisFrame;
+		PriorityServedFrame = OldestDeniedServedFrameThisFrame;
+
+		BudgetFrameCounter = GFrameCounter;
+		NumQueriesThisFrame = 0;
+		OldestDeniedServedFrameThisFrame = 0;
+		NumOldestDeniedQueriesThisFrame = 0;
+	}
+
+	if (MaxQueriesPerFrame > 0)
+	{
+		const auto bPriority{NumReservedQueries > 0 && LastServedFrame <= PriorityServedFrame};
+		const auto NumAvailableQueries{MaxQueriesPerFrame - NumQueriesThisFrame - (bPriority ? 0 : NumReservedQueries)};
+
+		if (NumQueries > NumAvailableQueries)
+		{
+			if (NumOldestDeniedQueriesThisFrame <= 0 || LastServedFrame < OldestDeniedServedFrameThisFrame)
+			{
+				OldestDeniedServedFrameThisFrame = LastServedFrame;
+				NumOldestDeniedQueriesThisFrame = NumQueries;
+			}
+			else if (LastServedFrame == OldestDeniedServedFrameThisFrame)
+			{
+				NumOldestDeniedQueriesThisFrame += NumQueries;
+			}
+
+			return false;
+		}
+
+		if (bPriority)
+		{
+			NumReservedQueries = FMath::Max(0, NumReservedQueries - NumQueries);
+		}
+	}
+
+	NumQueriesThisFrame += NumQueries;
+	LastServedFrame = GFrameCounter;
+	return true;
+}
+
+void UAlsMantlingSubsystem::RefundQueries(const int32 NumQueries)
+{
+	if (BudgetFrameCounter == GFrameCounter)
+	{
+		NumQueriesThisFrame = FMath::Max(0, NumQueriesThisFrame - NumQueries);
+	}
+}
@@ -0,0 +1,82 @@
+#include "AlsSignificanceSubsystem.h"
+
+#include "AlsCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsSignificanceSubsystem)
+
+bool UAlsSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsSignificanceSubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsSignificanceSubsystem::Tick()"), STAT_UAlsSignificanceSubsystem_Tick, STATGROUP_Als)
+
+	UpdateTimeRemaining -= DeltaTime;
+	if (UpdateTimeRemaining > 0.0f)
+	{
+		return;
+	}
+
+	UpdateTimeRemaining = UpdateInterval;
+
+	RefreshViewLocations();
+
+	for (auto i{Characters.Num() - 1}; i >= 0; i--)
+	{
+		auto* Character{Characters[i].Get()};
+		if (!IsValid(Character))
+		{
+			Characters.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		Character->RefreshSignificanceTier(ViewLocations);
+	}
+}
+
+TStatId UAlsSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsSignificanceSubsystem, STATGROUP_Als)
+}
+
+void UAlsSignificanceSubsystem::RegisterCharacter(AAlsCharacter* Character)
+{
+	if (IsValid(Character))
+	{
+		Characters.AddUnique(Character);
+
+		// Evaluate the new character on the next tick instead of waiting for the full update interval.
+
+		UpdateTimeRemaining = 0.0f;
+	}
+}
+
+void UAlsSignificanceSubsystem::UnregisterCharacter(AAlsCharacter* Character)
+{
+	Characters.RemoveSwap(Character);
+}
+
+void UAlsSignificanceSubsystem::RefreshViewLocations()
+{
+	ViewLocations.Reset();
+
+	// On the server, this also includes the view locations of remote players.
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* PlayerController{Iterator->Get()};
+		if (IsValid(PlayerController))
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
@@ -1,8 +1,10 @@
 #include "Notifies/AlsAnimNotify_FootstepEffects.h"
 
+#include "AlsAnimationInstance.h"
 #include "AlsCharacter.h"
 #include "DrawDebugHelpers.h"
 #include "NiagaraFunctionLibrary.h"
+#include "Notifies/AlsFootstepEffectsSubsystem.h"
 #include "Animation/AnimInstance.h"
 #include "Components/AudioComponent.h"
 #include "Components/DecalComponent.h"
@@ -70,40 +72,69 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 		return;
 	}
 
-#if ENABLE_DRAW_DEBUG
-	const auto bDisplayDebug{UAlsUtility::ShouldDisplayDebugForActor(Mesh->GetOwner(), UAlsConstants::TracesDebugDisplayName())};
-#endif
-
-	const auto* World{Mesh->GetWorld()};
 	const auto MeshScale{Mesh->GetComponentScale().Z};
 
 	const auto& FootBoneName{FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()};
 	const auto FootTransform{Mesh->GetSocketTransform(FootBoneName)};
 
-	const auto FootZAxis{
-		FootTransform.TransformVectorNoScale(FootBone == EAlsFootBone::Left
-			                                     ? FVector{FootstepEffectsSettings->FootLeftZAxis}
-			                                     : FVector{FootstepEffectsSettings->FootRightZAxis})
-	};
+	FAlsFootstepRequest Request;
+	Request.Notify = this;
+	Request.Mesh = Mesh;
+	Request.FootLocation = FootTransform.GetLocation();
+
+	Request.FootYAxis = FootTransform.TransformVectorNoScale(FootBone == EAlsFootBone::Left
+		                                                         ? FVector{FootstepEffectsSettings->FootLeftYAxis}
+		                                                         : FVector{FootstepEffectsSettings->FootRightYAxis});
+
+	Request.FootZAxis = FootTransform.TransformVectorNoScale(FootBone == EAlsFootBone::Left
+		                                                         ? FVector{FootstepEffectsSettings->FootLeftZAxis}
+		                                                         : FVector{FootstepEffectsSettings->FootRightZAxis});
+
+	Request.SurfaceTraceDistance = UE_REAL_TO_FLOAT(FootstepEffectsSettings->SurfaceTraceDistance * MeshScale);
+
+	auto* World{Mesh->GetWorld()};
+	auto* FootstepEffectsSubsystem{World->GetSubsystem<UAlsFootstepEffectsSubsystem>()};
+
+	if (IsValid(FootstepEffectsSubsystem))
+	{
+		FootstepEffectsSubsystem->QueueFootstep(Request);
+		return;
+	}
+
+	// Editor preview worlds and dedicated servers don't have the footstep effects subsystem, so trace synchronously instead.
 
 	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
 	QueryParameters.bReturnPhysicalMaterial = true;
 
 	FHitResult FootstepHit;
-	if (!World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-	                                     FootTransform.GetLocation() - FootZAxis *
-	                                     (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
+	if (!World->LineTraceSingleByChannel(FootstepHit, Request.FootLocation,
+	                                     Request.FootLocation - Request.FootZAxis * Request.SurfaceTraceDistance,
 	                                     FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters))
 	{
 		// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
 
-		World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-		                                FootTransform.GetLocation() - FVector{
-			                                0.0f, 0.0f, FootstepEffectsSettings->SurfaceTraceDistance * MeshScale
-		                                }, FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+		World->LineTraceSingleByChannel(FootstepHit, Request.FootLocation,
+		                                Request.FootLocation - FVector{0.0f, 0.0f, Request.SurfaceTraceDistance},
+		                                FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+	}
+
+	SpawnEffects(Request, FootstepHit, nullptr);
+}
+
+void UAlsAnimNotify_FootstepEffects::SpawnEffects(const FAlsFootstepRequest& Request, const FHitResult& FootstepHit,
+                                                  UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const
+{
+	auto* Mesh{Request.Mesh.Get()};
+
+	if (!IsValid(Mesh) || !IsValid(FootstepEffectsSettings))
+	{
+		return;
 	}
 
 #if ENABLE_DRAW_DEBUG
+	const auto bDisplayDebug{UAlsUtility::ShouldDisplayDebugForActor(Mesh->GetOwner(), UAlsConstants::TracesDebugDisplayName())};
+	const auto* World{Mesh->GetWorld()};
+
 	if (bDisplayDebug)
 	{
 		UAlsUtility::DrawDebugLineTraceSingle(World, FootstepHit.TraceStart, FootstepHit.TraceEnd, FootstepHit.bBlockingHit,
@@ -134,13 +165,7 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 	}
 
 	const auto FootstepLocation{FootstepHit.ImpactPoint};
-
-	const auto FootstepRotation{
-		FRotationMatrix::MakeFromZY(FootstepHit.ImpactNormal,
-		                            FootTransform.TransformVectorNoScale(FootBone == EAlsFootBone::Left
-			                                                                 ? FVector{FootstepEffectsSettings->FootLeftYAxis}
-			                                                                 : FVector{FootstepEffectsSettings->FootRightYAxis})).ToQuat()
-	};
+	const auto FootstepRotation{FRotationMatrix::MakeFromZY(FootstepHit.ImpactNormal, Request.FootYAxis).ToQuat()};
 
 #if ENABLE_DRAW_DEBUG
 	if (bDisplayDebug)
@@ -157,12 +182,13 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 
 	if (bSpawnDecal)
 	{
-		SpawnDecal(Mesh, *EffectSettings, FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
+		SpawnDecal(Mesh, *EffectSettings, FootstepLocation, FootstepRotation,
+		           FootstepHit, Request.FootZAxis, FootstepEffectsSubsystem);
 	}
 
 	if (bSpawnParticleSystem)
 	{
-		SpawnParticleSystem(Mesh, *EffectSettings, FootstepLocation, FootstepRotation);
+		SpawnParticleSystem(Mesh, *EffectSettings, FootstepLocation, FootstepRotation, FootstepEffectsSubsystem);
 	}
 }
 
@@ -173,7 +199,11 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 
 	if (!bIgnoreFootstepSoundBlockCurve && IsValid(Mesh->GetAnimInstance()))
 	{
-		VolumeMultiplier *= 1.0f - UAlsMath::Clamp01(Mesh->GetAnimInstance()->GetCurveValue(UAlsConstants::FootstepSoundBlockCurveName()));
+		const auto* AnimationInstance{Cast<UAlsAnimationInstance>(Mesh->GetAnimInstance())};
+
+		VolumeMultiplier *= 1.0f - (IsValid(AnimationInstance)
+			                            ? AnimationInstance->GetCurvesSnapshot().GetClamped01(EAlsCurve::FootstepSoundBlock)
+			                            : UAlsMath::Clamp01(Mesh->GetAnimInstance()->GetCurveValue(UAlsConstants::FootstepSoundBlockCurveName())));
 	}
 
 	if (!FAnimWeight::IsRelevant(VolumeMultiplier) || !IsValid(EffectSettings.Sound.LoadSynchronous()))
@@ -218,7 +248,8 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 
 void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepEffectSettings& EffectSettings,
                                                 const FVector& FootstepLocation, const FQuat& FootstepRotation,
-                                                const FHitResult& FootstepHit, const FVector& FootZAxis) const
+                                                const FHitResult& FootstepHit, const FVector& FootZAxis,
+                                                UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const
 {
 	if ((FootstepHit.ImpactNormal | FootZAxis) < FootstepEffectsSettings->DecalSpawnAngleThresholdCos)
 	{
@@ -244,6 +275,25 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 		FootstepLocation + DecalRotation.RotateVector(FVector{EffectSettings.DecalLocationOffset} * MeshScale)
 	};
 
+	const auto bAttachToHitComponent{
+		EffectSettings.DecalSpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent && FootstepHit.Component.IsValid()
+	};
+
+	if (IsValid(FootstepEffectsSubsystem))
+	{
+		if (!FootstepEffectsSubsystem->TryConsumeDecalBudget())
+		{
+			return;
+		}
+
+		if (FootstepEffectsSubsystem->SpawnPooledDecal(EffectSettings, FVector{EffectSettings.DecalSize} * MeshScale,
+		                                               DecalLocation, DecalRotation,
+		                                               bAttachToHitComponent ? FootstepHit.Component.Get() : nullptr))
+		{
+			return;
+		}
+	}
+
 	UDecalComponent* Decal{nullptr};
 
 	if (EffectSettings.DecalSpawnMode == EAlsFootstepDecalSpawnMode::SpawnAtTraceHitLocation || !FootstepHit.Component.IsValid())
@@ -267,9 +317,11 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 }
 
 void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent* Mesh, const FAlsFootstepEffectSettings& EffectSettings,
-                                                         const FVector& FootstepLocation, const FQuat& FootstepRotation) const
+                                                         const FVector& FootstepLocation, const FQuat& FootstepRotation,
+                                                         UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const
 {
-	if (!IsValid(EffectSettings.ParticleSystem.LoadSynchronous()))
+	if (!IsValid(EffectSettings.ParticleSystem.LoadSynchronous()) ||
+	    (IsValid(FootstepEffectsSubsystem) && !FootstepEffectsSubsystem->TryConsumeParticleSystemBudget()))
 	{
 		return;
 	}
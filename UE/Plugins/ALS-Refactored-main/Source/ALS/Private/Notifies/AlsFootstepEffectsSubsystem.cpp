@@ -0,0 +1,438 @@
+#include "Notifies/AlsFootstepEffectsSubsystem.h"
+
+#include "NiagaraComponentPool.h"
+#include "NiagaraSystem.h"
+#include "NiagaraWorldManager.h"
+#include "Components/DecalComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/WorldSettings.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootstepEffectsSubsystem)
+
+namespace AlsFootstepEffectsSubsystem
+{
+	constexpr auto SurfaceCachesPruneInterval{1.0f};
+
+	// Async traces complete during the next frame, so a request still pending after this many frames is considered lost.
+	constexpr auto PendingRequestMaxFrames{8};
+
+	UDecalComponent* CreatePooledDecal(UWorld* World)
+	{
+		// Same as UGameplayStatics::SpawnDecalAtLocation(), pooled decals are owned by the world settings actor.
+
+		auto* Decal{NewObject<UDecalComponent>(World->GetWorldSettings())};
+		Decal->bAllowAnyoneToDestroyMe = true;
+		Decal->SetVisibility(false);
+		Decal->RegisterComponentWithWorld(World);
+
+		return Decal;
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SurfaceTraceDelegate.BindUObject(this, &ThisClass::OnSurfaceTraceCompleted);
+}
+
+bool UAlsFootstepEffectsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer) || IsRunningDedicatedServer())
+	{
+		return false;
+	}
+
+	// Without the subsystem, footsteps fall back to the synchronous path, where decals and particle
+	// systems are not spawned on dedicated servers, so there is no need to pre-create decals there.
+
+	const auto* World{Cast<UWorld>(Outer)};
+	return !IsValid(World) || !World->IsNetMode(NM_DedicatedServer);
+}
+
+bool UAlsFootstepEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsFootstepEffectsSubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsFootstepEffectsSubsystem::Tick()"), STAT_UAlsFootstepEffectsSubsystem_Tick, STATGROUP_Als)
+
+	NumDecalsSpawnedThisFrame = 0;
+	NumParticleSystemsSpawnedThisFrame = 0;
+
+	RefreshDecalPool();
+	PruneSurfaceCaches(DeltaTime);
+	PrunePendingRequests();
+
+	for (const auto& Request : QueuedRequests)
+	{
+		if (!TryResolveFootstepFromSurfaceCache(Request))
+		{
+			SubmitSurfaceTrace(NextRequestId++, Request, false);
+		}
+	}
+
+	QueuedRequests.Reset();
+}
+
+TStatId UAlsFootstepEffectsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsFootstepEffectsSubsystem, STATGROUP_Als)
+}
+
+void UAlsFootstepEffectsSubsystem::QueueFootstep(const FAlsFootstepRequest& Request)
+{
+	const auto* Notify{Request.Notify.Get()};
+	if (!IsValid(Notify) || !IsValid(Notify->GetFootstepEffectsSettings()))
+	{
+		return;
+	}
+
+	PrewarmSettings(*Notify->GetFootstepEffectsSettings());
+
+	QueuedRequests.Add(Request);
+}
+
+bool UAlsFootstepEffectsSubsystem::TryConsumeDecalBudget()
+{
+	if (NumDecalsSpawnedThisFrame >= MaxDecalsPerFrame)
+	{
+		return false;
+	}
+
+	NumDecalsSpawnedThisFrame += 1;
+	return true;
+}
+
+bool UAlsFootstepEffectsSubsystem::TryConsumeParticleSystemBudget()
+{
+	if (NumParticleSystemsSpawnedThisFrame >= MaxParticleSystemsPerFrame)
+	{
+		return false;
+	}
+
+	NumParticleSystemsSpawnedThisFrame += 1;
+	return true;
+}
+
+bool UAlsFootstepEffectsSubsystem::SpawnPooledDecal(const FAlsFootstepEffectSettings& EffectSettings, const FVector& Size,
+                                                    const FVector& Location, const FQuat& Rotation, UPrimitiveComponent* AttachParent)
+{
+	if (DecalPool.IsEmpty())
+	{
+		return false;
+	}
+
+	// When all decals are in use, the oldest one is reused.
+
+	const auto DecalIndex{NextDecalIndex};
+	NextDecalIndex = (NextDecalIndex + 1) % DecalPool.Num();
+
+	auto& Decal{DecalPool[DecalIndex]};
+	if (!IsValid(Decal))
+	{
+		Decal = AlsFootstepEffectsSubsystem::CreatePooledDecal(GetWorld());
+	}
+
+	Decal->SetDecalMaterial(EffectSettings.DecalMaterial.Get());
+	Decal->DecalSize = Size;
+
+	// UDecalComponent::SetFadeOut() destroys the decal once it has faded out, so the fade parameters are set directly
+	// instead. The fade out restarts when the render state is recreated, and the decal is hidden once it expires.
+
+	Decal->FadeStartDelay = EffectSettings.DecalDuration;
+	Decal->FadeDuration = EffectSettings.DecalFadeOutDuration;
+
+	if (IsValid(AttachParent))
+	{
+		Decal->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepWorldTransform);
+	}
+	else if (IsValid(Decal->GetAttachParent()))
+	{
+		Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Decal->SetWorldLocationAndRotation(Location, Rotation);
+	Decal->SetVisibility(true);
+	Decal->MarkRenderStateDirty();
+
+	const auto LifeSpan{EffectSettings.DecalDuration + EffectSettings.DecalFadeOutDuration};
+
+	DecalExpirationTimes[DecalIndex] = LifeSpan > 0.0f ? GetWorld()->GetTimeSeconds() + LifeSpan : 0.0;
+	return true;
+}
+
+void UAlsFootstepEffectsSubsystem::PrewarmSettings(const UAlsFootstepEffectsSettings& Settings)
+{
+	auto bAlreadyPrewarmed{false};
+	PrewarmedSettings.Add(&Settings, &bAlreadyPrewarmed);
+
+	if (bAlreadyPrewarmed)
+	{
+		return;
+	}
+
+	auto* World{GetWorld()};
+
+	if (IsValid(World->GetWorldSettings()))
+	{
+		DecalPool.Reserve(Settings.DecalPoolSize);
+		DecalExpirationTimes.Reserve(Settings.DecalPoolSize);
+
+		while (DecalPool.Num() < Settings.DecalPoolSize)
+		{
+			DecalPool.Add(AlsFootstepEffectsSubsystem::CreatePooledDecal(World));
+			DecalExpirationTimes.Add(0.0);
+		}
+	}
+
+	// Prime the Niagara component pool, so that the first footsteps don't have to create new components. The number
+	// of primed components is controlled by the pool prime size of each particle system, and is zero by default.
+
+	auto* NiagaraWorldManager{FNiagaraWorldManager::Get(World)};
+	if (NiagaraWorldManager == nullptr)
+	{
+		return;
+	}
+
+	for (const auto& Tuple : Settings.Effects)
+	{
+		auto* ParticleSystem{Tuple.Value.ParticleSystem.LoadSynchronous()};
+		if (IsValid(ParticleSystem))
+		{
+			NiagaraWorldManager->GetComponentPool()->PrimePool(ParticleSystem, World);
+		}
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::RefreshDecalPool()
+{
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	for (auto i{0}; i < DecalPool.Num(); i++)
+	{
+		if (DecalExpirationTimes[i] > 0.0 && WorldTime >= DecalExpirationTimes[i])
+		{
+			DecalExpirationTimes[i] = 0.0;
+
+			if (IsValid(DecalPool[i]))
+			{
+				DecalPool[i]->SetVisibility(false);
+			}
+		}
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::PruneSurfaceCaches(const float DeltaTime)
+{
+	SurfaceCachesPruneTimeRemaining -= DeltaTime;
+	if (SurfaceCachesPruneTimeRemaining > 0.0f)
+	{
+		return;
+	}
+
+	SurfaceCachesPruneTimeRemaining = AlsFootstepEffectsSubsystem::SurfaceCachesPruneInterval;
+
+	for (auto Iterator{SurfaceCaches.CreateIterator()}; Iterator; ++Iterator)
+	{
+		if (Iterator->Key.ResolveObjectPtr() == nullptr || !Iterator->Value.Component.IsValid() || Iterator->Value.RemainingSteps <= 0)
+		{
+			Iterator.RemoveCurrent();
+		}
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::PrunePendingRequests()
+{
+	for (auto Iterator{PendingRequests.CreateIterator()}; Iterator; ++Iterator)
+	{
+		if (GFrameCounter - Iterator->Value.SubmitFrame > AlsFootstepEffectsSubsystem::PendingRequestMaxFrames)
+		{
+			Iterator.RemoveCurrent();
+		}
+	}
+}
+
+bool UAlsFootstepEffectsSubsystem::TryResolveFootstepFromSurfaceCache(const FAlsFootstepRequest& Request)
+{
+	const auto* Notify{Request.Notify.Get()};
+	auto* Mesh{Request.Mesh.Get()};
+
+	if (!IsValid(Notify) || !IsValid(Mesh) || !IsValid(Notify->GetFootstepEffectsSettings()))
+	{
+		// Nothing to resolve.
+
+		return true;
+	}
+
+	auto* SurfaceCache{SurfaceCaches.Find(Mesh)};
+	if (SurfaceCache == nullptr || SurfaceCache->RemainingSteps <= 0)
+	{
+		return false;
+	}
+
+	// The cached surface is used only while the character keeps standing on the same component.
+
+	const auto* Character{Cast<ACharacter>(Mesh->GetOwner())};
+	auto* Component{SurfaceCache->Component.Get()};
+
+	if (!IsValid(Character) || !IsValid(Component) || Character->GetMovementBase() != Component)
+	{
+		SurfaceCaches.Remove(Mesh);
+		return false;
+	}
+
+	const auto& ComponentTransform{Component->GetComponentTransform()};
+	const auto ImpactPoint{ComponentTransform.TransformPosition(SurfaceCache->LocalImpactPoint)};
+	const auto ImpactNormal{ComponentTransform.TransformVectorNoScale(SurfaceCache->LocalImpactNormal)};
+
+	// Intersect the foot trace with the plane of the cached surface.
+
+	const auto TraceStart{Request.FootLocation};
+	const auto TraceVector{-Request.FootZAxis * Request.SurfaceTraceDistance};
+
+	const auto TraceVectorDotNormal{TraceVector | ImpactNormal};
+	if (FMath::IsNearlyZero(TraceVectorDotNormal))
+	{
+		return false;
+	}
+
+	const auto Time{((ImpactPoint - TraceStart) | ImpactNormal) / TraceVectorDotNormal};
+	if (Time < 0.0f || Time > 1.0f)
+	{
+		return false;
+	}
+
+	// The surface is assumed to be flat only near the cached impact point.
+
+	const auto MaxDistance{Notify->GetFootstepEffectsSettings()->SurfaceCacheMaxDistance * Mesh->GetComponentScale().Z};
+
+	if (FVector::DistSquared(TraceStart + TraceVector * Time, ImpactPoint) > FMath::Square(MaxDistance))
+	{
+		return false;
+	}
+
+	SurfaceCache->RemainingSteps -= 1;
+
+	FHitResult FootstepHit{TraceStart, TraceStart + TraceVector};
+	FootstepHit.bBlockingHit = true;
+	FootstepHit.Time = UE_REAL_TO_FLOAT(Time);
+	FootstepHit.Distance = UE_REAL_TO_FLOAT(TraceVector.Size() * Time);
+	FootstepHit.Location = TraceStart + TraceVector * Time;
+	FootstepHit.ImpactPoint = FootstepHit.Location;
+	FootstepHit.Normal = ImpactNormal;
+	FootstepHit.ImpactNormal = ImpactNormal;
+	FootstepHit.Component = Component;
+	FootstepHit.HitObjectHandle = FActorInstanceHandle{Component->GetOwner()};
+	FootstepHit.PhysMaterial = SurfaceCache->PhysicalMaterial;
+
+	Notify->SpawnEffects(Request, FootstepHit, this);
+	return true;
+}
+
+void UAlsFootstepEffectsSubsystem::SubmitSurfaceTrace(const uint32 RequestId, const FAlsFootstepRequest& Request, const bool bFallback)
+{
+	const auto* Notify{Request.Notify.Get()};
+	const auto* Mesh{Request.Mesh.Get()};
+
+	if (!IsValid(Notify) || !IsValid(Mesh) || !IsValid(Notify->GetFootstepEffectsSettings()))
+	{
+		return;
+	}
+
+	auto& PendingRequest{PendingRequests.Add(RequestId)};
+	PendingRequest.Request = Request;
+	PendingRequest.SubmitFrame = GFrameCounter;
+	PendingRequest.bFallback = bFallback;
+
+	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
+	QueryParameters.bReturnPhysicalMaterial = true;
+
+	// The fallback trace goes down the world Z axis.
+
+	const auto TraceEnd{
+		bFallback
+			? Request.FootLocation - FVector{0.0f, 0.0f, Request.SurfaceTraceDistance}
+			: Request.FootLocation - Request.FootZAxis * Request.SurfaceTraceDistance
+	};
+
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.FootLocation, TraceEnd,
+	                                    Notify->GetFootstepEffectsSettings()->SurfaceTraceChannel, QueryParameters,
+	                                    FCollisionResponseParams::DefaultResponseParam, &SurfaceTraceDelegate, RequestId);
+}
+
+void UAlsFootstepEffectsSubsystem::OnSurfaceTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	const auto RequestId{TraceData.UserData};
+
+	FAlsPendingFootstepRequest PendingRequest;
+	if (!PendingRequests.RemoveAndCopyValue(RequestId, PendingRequest))
+	{
+		return;
+	}
+
+	const auto& Request{PendingRequest.Request};
+
+	const auto* Notify{Request.Notify.Get()};
+	if (!IsValid(Notify) || !Request.Mesh.IsValid())
+	{
+		return;
+	}
+
+	const auto* Hit{TraceData.OutHits.FindByPredicate([](const FHitResult& OutHit) { return OutHit.bBlockingHit; })};
+
+	if (Hit == nullptr && !PendingRequest.bFallback)
+	{
+		// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
+
+		SubmitSurfaceTrace(RequestId, Request, true);
+		return;
+	}
+
+	const auto FootstepHit{Hit != nullptr ? *Hit : FHitResult{TraceData.Start, TraceData.End}};
+
+	RefreshSurfaceCache(Request, FootstepHit);
+
+	Notify->SpawnEffects(Request, FootstepHit, this);
+}
+
+void UAlsFootstepEffectsSubsystem::RefreshSurfaceCache(const FAlsFootstepRequest& Request, const FHitResult& FootstepHit)
+{
+	auto* Mesh{Request.Mesh.Get()};
+	const auto* Character{Cast<ACharacter>(Mesh->GetOwner())};
+	const auto* Settings{Request.Notify->GetFootstepEffectsSettings()};
+	auto* Component{FootstepHit.GetComponent()};
+
+	if (!FootstepHit.bBlockingHit || !IsValid(Character) || !IsValid(Component) || !IsValid(Settings) ||
+	    Character->GetMovementBase() != Component || Settings->SurfaceCacheMaxSteps <= 0)
+	{
+		SurfaceCaches.Remove(Mesh);
+		return;
+	}
+
+	// Excluded surfaces, such as terrain, are not flat and components with multiple materials may
+	// have a different physical material under each foot, so footsteps on them are always traced.
+
+	if (Settings->SurfaceCacheExcludedSurfaces.Contains(UPhysicalMaterial::DetermineSurfaceType(FootstepHit.PhysMaterial.Get())) ||
+	    Component->GetNumMaterials() > 1)
+	{
+		SurfaceCaches.Remove(Mesh);
+		return;
+	}
+
+	auto& SurfaceCache{SurfaceCaches.FindOrAdd(Mesh)};
+
+	const auto& ComponentTransform{Component->GetComponentTransform()};
+
+	SurfaceCache.Component = Component;
+	SurfaceCache.PhysicalMaterial = FootstepHit.PhysMaterial;
+	SurfaceCache.LocalImpactPoint = ComponentTransform.InverseTransformPosition(FootstepHit.ImpactPoint);
+	SurfaceCache.LocalImpactNormal = ComponentTransform.InverseTransformVectorNoScale(FootstepHit.ImpactNormal);
+	SurfaceCache.RemainingSteps = Settings->SurfaceCacheMaxSteps;
+}
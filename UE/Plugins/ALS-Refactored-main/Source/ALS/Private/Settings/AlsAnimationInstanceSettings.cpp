@@ -14,6 +14,18 @@ UAlsAnimationInstanceSettings::UAlsAnimationInstanceSettings()
 	InAir.GroundPredictionSweepResponses.WorldStatic = ECR_Block;
 	InAir.GroundPredictionSweepResponses.WorldDynamic = ECR_Block;
 	InAir.GroundPredictionSweepResponses.Destructible = ECR_Block;
+
+	Significance.Tiers.AddDefaulted();
+
+	auto& MiddleTier{Significance.Tiers.AddDefaulted_GetRef()};
+	MiddleTier.bEnableGroundPrediction = false;
+
+	auto& FarTier{Significance.Tiers.AddDefaulted_GetRef()};
+	FarTier.bEnableFeetIk = false;
+	FarTier.bEnableGroundPrediction = false;
+	FarTier.bEnableTransitions = false;
+	FarTier.bEnableRotateInPlace = false;
+	FarTier.bEnableTurnInPlace = false;
 }
 
 #if WITH_EDITOR
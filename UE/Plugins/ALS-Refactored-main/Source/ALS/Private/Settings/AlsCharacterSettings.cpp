@@ -25,6 +25,17 @@ UAlsCharacterSettings::UAlsCharacterSettings()
 	Mantling.MantlingTraceResponses.WorldStatic = ECR_Block;
 	Mantling.MantlingTraceResponses.WorldDynamic = ECR_Block;
 	Mantling.MantlingTraceResponses.Destructible = ECR_Block;
+
+	auto& NearTier{Significance.Tiers.AddDefaulted_GetRef()};
+	NearTier.MaxDistance = 1500.0f;
+
+	auto& MiddleTier{Significance.Tiers.AddDefaulted_GetRef()};
+	MiddleTier.MaxDistance = 4000.0f;
+	MiddleTier.TickInterval = 1.0f / 30.0f;
+
+	auto& FarTier{Significance.Tiers.AddDefaulted_GetRef()};
+	FarTier.TickInterval = 0.1f;
+	FarTier.bAllowMantlingInAir = false;
 }
 
 #if WITH_EDITOR
@@ -0,0 +1,54 @@
+#include "Utility/AlsCurvesSnapshot.h"
+
+#include "Utility/AlsConstants.h"
+
+TConstArrayView<FName> AlsCurvesSnapshot::GetCurveNames()
+{
+	static const FName CurveNames[]{
+		UAlsConstants::LayerHeadCurveName(),
+		UAlsConstants::LayerHeadAdditiveCurveName(),
+		UAlsConstants::LayerHeadSlotCurveName(),
+		UAlsConstants::LayerArmLeftCurveName(),
+		UAlsConstants::LayerArmLeftAdditiveCurveName(),
+		UAlsConstants::LayerArmLeftLocalSpaceCurveName(),
+		UAlsConstants::LayerArmLeftSlotCurveName(),
+		UAlsConstants::LayerArmRightCurveName(),
+		UAlsConstants::LayerArmRightAdditiveCurveName(),
+		UAlsConstants::LayerArmRightLocalSpaceCurveName(),
+		UAlsConstants::LayerArmRightSlotCurveName(),
+		UAlsConstants::LayerHandLeftCurveName(),
+		UAlsConstants::LayerHandRightCurveName(),
+		UAlsConstants::LayerSpineCurveName(),
+		UAlsConstants::LayerSpineAdditiveCurveName(),
+		UAlsConstants::LayerSpineSlotCurveName(),
+		UAlsConstants::LayerPelvisCurveName(),
+		UAlsConstants::LayerPelvisSlotCurveName(),
+		UAlsConstants::LayerLegsCurveName(),
+		UAlsConstants::LayerLegsSlotCurveName(),
+		UAlsConstants::ViewBlockCurveName(),
+		UAlsConstants::AllowAimingCurveName(),
+		UAlsConstants::HipsDirectionLockCurveName(),
+		UAlsConstants::PoseGaitCurveName(),
+		UAlsConstants::PoseMovingCurveName(),
+		UAlsConstants::PoseStandingCurveName(),
+		UAlsConstants::PoseCrouchingCurveName(),
+		UAlsConstants::PoseGroundedCurveName(),
+		UAlsConstants::PoseInAirCurveName(),
+		UAlsConstants::FootLeftIkCurveName(),
+		UAlsConstants::FootLeftLockCurveName(),
+		UAlsConstants::FootRightIkCurveName(),
+		UAlsConstants::FootRightLockCurveName(),
+		UAlsConstants::FootPlantedCurveName(),
+		UAlsConstants::FeetCrossingCurveName(),
+		UAlsConstants::RotationYawSpeedCurveName(),
+		UAlsConstants::RotationYawOffsetCurveName(),
+		UAlsConstants::AllowTransitionsCurveName(),
+		UAlsConstants::SprintBlockCurveName(),
+		UAlsConstants::GroundPredictionBlockCurveName(),
+		UAlsConstants::FootstepSoundBlockCurveName()
+	};
+
+	static_assert(UE_ARRAY_COUNT(CurveNames) == FAlsCurvesSnapshot::NumCurves);
+
+	return CurveNames;
+}
@@ -13,13 +13,16 @@
 #include "State/AlsPoseState.h"
 #include "State/AlsRagdollingAnimationState.h"
 #include "State/AlsRotateInPlaceState.h"
+#include "State/AlsSignificanceAnimationState.h"
 #include "State/AlsTransitionsState.h"
 #include "State/AlsTurnInPlaceState.h"
 #include "State/AlsViewAnimationState.h"
+#include "Utility/AlsCurvesSnapshot.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsAnimationInstance.generated.h"
 
 struct FAlsFootLimitsSettings;
+struct FAlsAnimationSignificanceTierSettings;
 class UAlsLinkedAnimationInstance;
 class AAlsCharacter;
 
@@ -53,6 +56,20 @@ protected:
 	mutable TArray<TFunction<void()>> DisplayDebugTracesQueue;
 #endif
 
+	// Copy of the animation curves from the last evaluation. Refreshed on the game thread only, so
+	// it can be read from the game thread and the worker threads without any synchronization.
+	FAlsCurvesSnapshot CurvesSnapshot;
+
+	// Asynchronous ground prediction sweep submitted on the game thread. Its result is consumed on the game thread
+	// during the next update, after the world has completed the batch of asynchronous traces of the previous frame.
+	FTraceHandle GroundPredictionSweepHandle;
+
+	// Time of impact of the last completed ground prediction sweep, or a negative value if no walkable ground was found.
+	float GroundPredictionHitTime{-1.0f};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FAlsSignificanceAnimationState SignificanceState;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FGameplayTag ViewMode{AlsViewModeTags::ThirdPerson};
 
@@ -127,6 +144,8 @@ public:
 
 	virtual void NativePostUpdateAnimation();
 
+	virtual void NativePostEvaluateAnimation() override;
+
 protected:
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
@@ -142,17 +161,30 @@ protected:
 	FAlsControlRigInput GetControlRigInput() const;
 
 public:
+	const FAlsCurvesSnapshot& GetCurvesSnapshot() const;
+
 	void MarkPendingUpdate();
 
 	void MarkTeleported();
 
 private:
+	void RefreshCurvesOnGameThread();
+
 	void RefreshMovementBaseOnGameThread();
 
 	void RefreshLayering();
 
 	void RefreshPose();
 
+	// Significance
+
+private:
+	const FAlsAnimationSignificanceTierSettings& GetSignificanceTierSettings() const;
+
+	void RefreshSignificanceOnGameThread();
+
+	void RefreshSignificance(float DeltaTime);
+
 	// View
 
 public:
@@ -229,6 +261,8 @@ protected:
 private:
 	void RefreshInAirOnGameThread();
 
+	void RefreshGroundPredictionOnGameThread();
+
 	void RefreshInAir(float DeltaTime);
 
 	void RefreshGroundPredictionAmount();
@@ -247,14 +281,14 @@ private:
 
 	void RefreshFeet(float DeltaTime);
 
-	void RefreshFoot(FAlsFootState& FootState, const FName& FootIkCurveName, const FName& FootLockCurveName,
+	void RefreshFoot(FAlsFootState& FootState, EAlsCurve FootIkCurve, EAlsCurve FootLockCurve,
 	                 const FAlsFootLimitsSettings& LimitsSettings, const FTransform& ComponentTransformInverse, float DeltaTime) const;
 
 	void ProcessFootLockTeleport(FAlsFootState& FootState) const;
 
 	void ProcessFootLockBaseChange(FAlsFootState& FootState, const FTransform& ComponentTransformInverse) const;
 
-	void RefreshFootLock(FAlsFootState& FootState, const FName& FootLockCurveName, const FTransform& ComponentTransformInverse,
+	void RefreshFootLock(FAlsFootState& FootState, EAlsCurve FootLockCurve, const FTransform& ComponentTransformInverse,
 	                     float DeltaTime, FVector& FinalLocation, FQuat& FinalRotation) const;
 
 	void RefreshFootOffset(FAlsFootState& FootState, float DeltaTime, FVector& FinalLocation, FQuat& FinalRotation) const;
@@ -328,6 +362,11 @@ inline UAlsAnimationInstanceSettings* UAlsAnimationInstance::GetSettingsUnsafe()
 	return Settings;
 }
 
+inline const FAlsCurvesSnapshot& UAlsAnimationInstance::GetCurvesSnapshot() const
+{
+	return CurvesSnapshot;
+}
+
 inline void UAlsAnimationInstance::MarkPendingUpdate()
 {
 	bPendingUpdate |= true;
@@ -12,6 +12,7 @@
 
 struct FAlsMantlingParameters;
 struct FAlsMantlingTraceSettings;
+struct FAlsCharacterSignificanceTierSettings;
 class UAlsCharacterMovementComponent;
 class UAlsCharacterSettings;
 class UAlsMovementSettings;
@@ -105,8 +106,25 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State|Als Character", Transient)
 	FAlsRollingState RollingState;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State|Als Character", Transient, Meta = (ClampMin = 0))
+	int32 SignificanceTier{0};
+
+	// Tick intervals of the character and its mesh configured before any significance tier was applied.
+	// The tick interval of a significance tier never makes them tick more often than configured.
+	float ConfiguredTickInterval{0.0f};
+
+	float ConfiguredMeshTickInterval{0.0f};
+
 	FTimerHandle BrakingFrictionFactorResetTimer;
 
+	// World time of the next in-air mantling probe, see AAlsCharacter::StartMantlingInAir().
+	double NextMantlingInAirProbeTime{0.0};
+
+	// Frame in which the in-air mantling probe was last granted queries by UAlsMantlingSubsystem.
+	uint64 MantlingInAirProbeLastServedFrame{0};
+
+	TArray<FAlsMantlingFailedLedge, TInlineAllocator<4>> FailedMantlingLedges;
+
 public:
 	explicit AAlsCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
@@ -125,6 +143,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 public:
 	virtual void PostNetReceiveLocationAndRotation() override;
 
@@ -141,6 +161,19 @@ private:
 
 	void RefreshMovementBase();
 
+	// Significance
+
+public:
+	int32 GetSignificanceTier() const;
+
+	// Called periodically by UAlsSignificanceSubsystem.
+	void RefreshSignificanceTier(TConstArrayView<FVector> ViewLocations);
+
+	const FAlsCharacterSignificanceTierSettings* GetSignificanceTierSettings() const;
+
+private:
+	void SetSignificanceTier(int32 NewTier);
+
 	// View Mode
 
 public:
@@ -486,7 +519,16 @@ public:
 private:
 	bool StartMantlingInAir();
 
-	bool StartMantling(const FAlsMantlingTraceSettings& TraceSettings);
+	// In-air probes are subject to the per-frame budget of UAlsMantlingSubsystem and to the failed ledge cache.
+	bool StartMantling(const FAlsMantlingTraceSettings& TraceSettings, bool bInAirProbe = false);
+
+	bool TryConsumeMantlingInAirProbeQueries(int32 NumQueries);
+
+	void RefundMantlingInAirProbeQueries(int32 NumQueries) const;
+
+	bool IsMantlingLedgeKnownToFail(const UPrimitiveComponent* Primitive, const FVector& ImpactPoint, float CapsuleScale) const;
+
+	void RememberFailedMantlingLedge(const UPrimitiveComponent* Primitive, const FVector& ImpactPoint);
 
 	UFUNCTION(Server, Reliable)
 	void ServerStartMantling(const FAlsMantlingParameters& Parameters);
@@ -591,6 +633,11 @@ private:
 	void DisplayDebugMantling(const UCanvas* Canvas, float Scale, float HorizontalLocation, float& VerticalLocation) const;
 };
 
+inline int32 AAlsCharacter::GetSignificanceTier() const
+{
+	return SignificanceTier;
+}
+
 inline const FGameplayTag& AAlsCharacter::GetViewMode() const
 {
 	return ViewMode;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsMantlingSubsystem.generated.h"
+
+// Shares the per-frame scene query budget of in-air mantling probes between all characters in the world. When the budget
+// runs out, the next frame reserves queries for the denied characters that have waited the longest since they were last
+// served, so that characters early in the tick order can't keep starving the ones that tick after them.
+UCLASS()
+class ALS_API UAlsMantlingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	uint64 BudgetFrameCounter{0};
+
+	int32 NumQueriesThisFrame{0};
+
+	// Queries that can only be consumed by requesters that were last served no later than the priority served frame.
+	int32 NumReservedQueries{0};
+
+	uint64 PriorityServedFrame{0};
+
+	// The oldest last served frame among the requesters that were denied during the current frame.
+	uint64 OldestDeniedServedFrameThisFrame{0};
+
+	// Queries denied during the current frame to requesters that were last served in the oldest denied served frame.
+	int32 NumOldestDeniedQueriesThisFrame{0};
+
+public:
+	// Zero max queries per frame means no limit. The last served frame is tracked by the requester
+	// and is updated when the queries are granted, it should be zero for requesters never served before.
+	bool TryConsumeQueries(int32 NumQueries, int32 MaxQueriesPerFrame, uint64& LastServedFrame);
+
+	// Returns queries that were consumed during the current frame but ended up not being used.
+	void RefundQueries(int32 NumQueries);
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsSignificanceSubsystem.generated.h"
+
+class AAlsCharacter;
+
+// Periodically assigns significance tiers to all registered characters based on
+// their distance to the nearest player view location. See FAlsSignificanceSettings.
+UCLASS()
+class ALS_API UAlsSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Significance changes slowly, so there is no need to re-evaluate it every frame.
+	static constexpr auto UpdateInterval{0.25f};
+
+protected:
+	TArray<TWeakObjectPtr<AAlsCharacter>> Characters;
+
+	TArray<FVector> ViewLocations;
+
+	float UpdateTimeRemaining{0.0f};
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AAlsCharacter* Character);
+
+	void UnregisterCharacter(AAlsCharacter* Character);
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+private:
+	void RefreshViewLocations();
+};
@@ -10,6 +10,8 @@ struct FHitResult;
 class USoundBase;
 class UMaterialInterface;
 class UNiagaraSystem;
+class UAlsAnimNotify_FootstepEffects;
+class UAlsFootstepEffectsSubsystem;
 
 UENUM(BlueprintType)
 enum class EAlsFootBone : uint8
@@ -150,12 +152,47 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ForceInlineRow))
 	TMap<TEnumAsByte<EPhysicalSurface>, FAlsFootstepEffectSettings> Effects;
 
+	// Number of consecutive footsteps for which the surface found by the last trace is reused instead of tracing
+	// again, as long as the character keeps standing on the same component. Zero disables the surface cache.
+	// Components with more than one material are always traced.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Performance", Meta = (ClampMin = 0))
+	int32 SurfaceCacheMaxSteps{4};
+
+	// Surface types that are not flat, such as terrain, so footsteps on them are always traced.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Performance")
+	TArray<TEnumAsByte<EPhysicalSurface>> SurfaceCacheExcludedSurfaces;
+
+	// The surface found by the last trace is reused only for footsteps within this distance of its impact point.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Performance", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float SurfaceCacheMaxDistance{100.0f};
+
+	// Number of decal components created in advance and reused by all footsteps. When all decals are in
+	// use, the oldest one is reused. Zero disables pooling, so decals are spawned and destroyed individually.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Performance", Meta = (ClampMin = 0))
+	int32 DecalPoolSize{64};
+
 public:
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 };
 
+// Foot plant captured by the animation notify, which is resolved into footstep effects once its surface trace is complete.
+struct ALS_API FAlsFootstepRequest
+{
+	TWeakObjectPtr<const UAlsAnimNotify_FootstepEffects> Notify;
+
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	FVector FootLocation{ForceInit};
+
+	FVector FootYAxis{ForceInit};
+
+	FVector FootZAxis{ForceInit};
+
+	float SurfaceTraceDistance{0.0f};
+};
+
 UCLASS(DisplayName = "Als Footstep Effects Animation Notify",
 	AutoExpandCategories = ("Settings|Sound", "Settings|Decal", "Settings|Particle System"))
 class ALS_API UAlsAnimNotify_FootstepEffects : public UAnimNotify
@@ -194,19 +231,34 @@ protected:
 	uint8 bSpawnParticleSystem : 1 {true};
 
 public:
+	const UAlsFootstepEffectsSettings* GetFootstepEffectsSettings() const;
+
 	virtual FString GetNotifyName_Implementation() const override;
 
 	virtual void Notify(USkeletalMeshComponent* Mesh, UAnimSequenceBase* Animation,
 	                    const FAnimNotifyEventReference& EventReference) override;
 
+	// Spawns the effects of a footstep once its surface is known. The subsystem is optional, without it, effects are
+	// spawned without pooling and budgets. This is the case in editor preview worlds and on dedicated servers,
+	// where the subsystem does not exist.
+	void SpawnEffects(const FAlsFootstepRequest& Request, const FHitResult& FootstepHit,
+	                  UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const;
+
 private:
 	void SpawnSound(USkeletalMeshComponent* Mesh, const FAlsFootstepEffectSettings& EffectSettings,
 	                const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
 
 	void SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepEffectSettings& EffectSettings,
 	                const FVector& FootstepLocation, const FQuat& FootstepRotation,
-	                const FHitResult& FootstepHit, const FVector& FootZAxis) const;
+	                const FHitResult& FootstepHit, const FVector& FootZAxis,
+	                UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const;
 
 	void SpawnParticleSystem(USkeletalMeshComponent* Mesh, const FAlsFootstepEffectSettings& EffectSettings,
-	                         const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
+	                         const FVector& FootstepLocation, const FQuat& FootstepRotation,
+	                         UAlsFootstepEffectsSubsystem* FootstepEffectsSubsystem) const;
 };
+
+inline const UAlsFootstepEffectsSettings* UAlsAnimNotify_FootstepEffects::GetFootstepEffectsSettings() const
+{
+	return FootstepEffectsSettings;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "AlsAnimNotify_FootstepEffects.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "AlsFootstepEffectsSubsystem.generated.h"
+
+class UDecalComponent;
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+
+// Surface found by the last footstep trace of a character, in the space of the component that was hit.
+struct FAlsFootstepSurfaceCache
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	TWeakObjectPtr<UPhysicalMaterial> PhysicalMaterial;
+
+	FVector LocalImpactPoint{ForceInit};
+
+	FVector LocalImpactNormal{ForceInit};
+
+	int32 RemainingSteps{0};
+};
+
+// Footstep whose surface trace is in flight.
+struct FAlsPendingFootstepRequest
+{
+	FAlsFootstepRequest Request;
+
+	// Frame in which the trace was submitted. Requests whose trace never completes are discarded after a few frames.
+	uint64 SubmitFrame{0};
+
+	// Whether the first trace didn't hit anything and the footstep is traced again down the world Z axis.
+	bool bFallback{false};
+};
+
+// Resolves footsteps queued by UAlsAnimNotify_FootstepEffects. The surface traces of all footsteps queued during a frame
+// are submitted together as asynchronous traces and resolved during the next frame. Decals are drawn from a pool
+// of pre-created components, particle systems from the primed Niagara component pool, both with per-frame budgets.
+// Not created on dedicated servers, which don't render footstep effects anyway. The budgets are shared by the whole
+// project and can be changed in the [/Script/ALS.AlsFootstepEffectsSubsystem] section of DefaultGame.ini.
+UCLASS(Config = Game)
+class ALS_API UAlsFootstepEffectsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	// Max number of footstep decals that can be spawned per frame by all characters, regardless of their settings.
+	UPROPERTY(Config)
+	int32 MaxDecalsPerFrame{8};
+
+	// Max number of footstep particle systems that can be spawned per frame by all characters, regardless of their settings.
+	UPROPERTY(Config)
+	int32 MaxParticleSystemsPerFrame{8};
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDecalComponent>> DecalPool;
+
+	// World time at which each pooled decal finishes fading out, or zero if the decal is not in use.
+	TArray<double> DecalExpirationTimes;
+
+	int32 NextDecalIndex{0};
+
+	TSet<TWeakObjectPtr<const UAlsFootstepEffectsSettings>> PrewarmedSettings;
+
+	TArray<FAlsFootstepRequest> QueuedRequests;
+
+	// Footsteps whose surface trace is in flight, by the user data of the trace.
+	TMap<uint32, FAlsPendingFootstepRequest> PendingRequests;
+
+	uint32 NextRequestId{0};
+
+	FTraceDelegate SurfaceTraceDelegate;
+
+	TMap<TObjectKey<USkeletalMeshComponent>, FAlsFootstepSurfaceCache> SurfaceCaches;
+
+	float SurfaceCachesPruneTimeRemaining{0.0f};
+
+	int32 NumDecalsSpawnedThisFrame{0};
+
+	int32 NumParticleSystemsSpawnedThisFrame{0};
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void QueueFootstep(const FAlsFootstepRequest& Request);
+
+	// Should be called right before the decal is actually spawned.
+	bool TryConsumeDecalBudget();
+
+	// Should be called right before the particle system is actually spawned.
+	bool TryConsumeParticleSystemBudget();
+
+	// Returns false if pooling is disabled, in which case the decal should be spawned as usual.
+	bool SpawnPooledDecal(const FAlsFootstepEffectSettings& EffectSettings, const FVector& Size, const FVector& Location,
+	                      const FQuat& Rotation, UPrimitiveComponent* AttachParent);
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+private:
+	void PrewarmSettings(const UAlsFootstepEffectsSettings& Settings);
+
+	void RefreshDecalPool();
+
+	void PruneSurfaceCaches(float DeltaTime);
+
+	void PrunePendingRequests();
+
+	bool TryResolveFootstepFromSurfaceCache(const FAlsFootstepRequest& Request);
+
+	void SubmitSurfaceTrace(uint32 RequestId, const FAlsFootstepRequest& Request, bool bFallback);
+
+	void OnSurfaceTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	void RefreshSurfaceCache(const FAlsFootstepRequest& Request, const FHitResult& FootstepHit);
+};
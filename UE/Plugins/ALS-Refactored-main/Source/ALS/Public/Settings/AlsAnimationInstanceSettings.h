@@ -5,6 +5,7 @@
 #include "AlsGroundedSettings.h"
 #include "AlsInAirSettings.h"
 #include "AlsRotateInPlaceSettings.h"
+#include "AlsSignificanceSettings.h"
 #include "AlsTransitionsSettings.h"
 #include "AlsTurnInPlaceSettings.h"
 #include "AlsViewAnimationSettings.h"
@@ -41,6 +42,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsGeneralTurnInPlaceSettings TurnInPlace;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsAnimationSignificanceSettings Significance;
+
 public:
 	UAlsAnimationInstanceSettings();
 
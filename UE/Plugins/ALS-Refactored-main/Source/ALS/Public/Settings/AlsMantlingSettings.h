@@ -122,6 +122,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FAlsMantlingTraceSettings InAirTrace{{50.0f, 150.0f}, 70.0f};
 
+	// Interval between in-air mantling probes of characters that are not controlled by players. Zero means every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float InAirProbeInterval{0.05f};
+
+	// Max number of scene queries per frame that can be performed by in-air mantling probes of all characters
+	// in the world that are not controlled by players. Probes over the budget are retried on the next frame.
+	// Zero means no limit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
+	int32 MaxInAirProbeQueriesPerFrame{64};
+
+	// How long a failed in-air ledge validation is remembered. While it is remembered, the ledge validation is
+	// skipped if the forward trace hits the same primitive near the same location.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float FailedLedgeCacheDuration{0.25f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float FailedLedgeCacheDistance{25.0f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	TEnumAsByte<ECollisionChannel> MantlingTraceChannel{ECC_Visibility};
 
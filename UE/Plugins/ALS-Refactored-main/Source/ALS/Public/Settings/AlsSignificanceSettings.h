@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "AlsSignificanceSettings.generated.h"
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsCharacterSignificanceTierSettings
+{
+	GENERATED_BODY()
+
+	// The character uses this tier while it is closer than this distance to the nearest player view location.
+	// Ignored for the last tier, which is used for all characters that are farther away than the previous tiers.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxDistance{1500.0f};
+
+	// Tick interval of the character and of its mesh, which updates the animation instance. Zero means that they
+	// tick every frame. Never makes them tick more often than their own configured tick interval.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float TickInterval{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bAllowMantlingInAir : 1 {true};
+};
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsSignificanceSettings
+{
+	GENERATED_BODY()
+
+	// If checked, characters that are not controlled by players are assigned a significance
+	// tier based on their distance to the nearest player, otherwise they always use the first tier.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableSignificance : 1;
+
+	// A character moves to a more significant tier only when it gets closer than the tier's max
+	// distance by this amount. Prevents characters from flickering between tiers near the boundary.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float HysteresisDistance{100.0f};
+
+	// Number of tiers by which characters that have not been rendered recently are moved down. Not used on dedicated servers.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
+	int32 NotRenderedTierOffset{1};
+
+	// Tiers ordered from the most significant to the least significant.
+	// The tier index is also used to select the tier in UAlsAnimationInstanceSettings.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TArray<FAlsCharacterSignificanceTierSettings> Tiers;
+};
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsAnimationSignificanceTierSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableFeetIk : 1 {true};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableGroundPrediction : 1 {true};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableTransitions : 1 {true};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableRotateInPlace : 1 {true};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnableTurnInPlace : 1 {true};
+};
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsAnimationSignificanceSettings
+{
+	GENERATED_BODY()
+
+	// Tiers indexed by the significance tier of the character. Characters with a tier
+	// beyond the end of the array use the last tier. If empty, everything is enabled.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TArray<FAlsAnimationSignificanceTierSettings> Tiers;
+
+	// Time it takes to blend foot IK and ground prediction in or out when they are toggled by a tier change.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float HandOffDuration{0.3f};
+};
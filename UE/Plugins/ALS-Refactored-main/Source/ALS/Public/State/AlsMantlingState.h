@@ -2,6 +2,8 @@
 
 #include "AlsMantlingState.generated.h"
 
+class UPrimitiveComponent;
+
 USTRUCT(BlueprintType)
 struct ALS_API FAlsMantlingState
 {
@@ -10,3 +12,13 @@ struct ALS_API FAlsMantlingState
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	int32 RootMotionSourceId = 0;
 };
+
+// Ledge for which an in-air mantling validation has recently failed.
+struct ALS_API FAlsMantlingFailedLedge
+{
+	TWeakObjectPtr<const UPrimitiveComponent> Primitive;
+
+	FVector ImpactPoint{ForceInit};
+
+	double ExpirationTime{0.0};
+};
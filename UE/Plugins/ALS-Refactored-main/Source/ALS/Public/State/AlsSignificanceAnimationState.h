@@ -0,0 +1,20 @@
+﻿#pragma once
+
+#include "AlsSignificanceAnimationState.generated.h"
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsSignificanceAnimationState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
+	int32 Tier{0};
+
+	// Blends toward 0 or 1 when foot IK is disabled or enabled by the current tier.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1))
+	float FeetIkAmount{1.0f};
+
+	// Blends toward 0 or 1 when ground prediction is disabled or enabled by the current tier.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1))
+	float GroundPredictionAmount{1.0f};
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Utility/AlsMath.h"
+
+// Flat copy of a fixed set of animation curves, addressed by an enum instead of by name.
+// Curve names are resolved to indices only when the layout of the animation curve map changes (for
+// example, when the skeleton or the set of animated curves changes). Otherwise, the refresh walks the curve
+// map once and only compares the names against the previous layout, without hashing any of them.
+
+template <typename CurveType>
+class TAlsCurvesSnapshot
+{
+public:
+	static constexpr auto NumCurves{static_cast<int32>(CurveType::Count)};
+
+private:
+	float Values[NumCurves]{};
+
+	// Names of the curve map elements in iteration order, as of the last time the layout was resolved.
+	TArray<FName> LayoutNames;
+
+	// Index into the values of each curve in the layout, or INDEX_NONE if the curve is not part of the snapshot.
+	TArray<int32> LayoutIndices;
+
+public:
+	// The curve names must be listed in the same order as the curve enum.
+	void Refresh(const TMap<FName, float>& Curves, TConstArrayView<FName> CurveNames);
+
+	float Get(CurveType Curve) const;
+
+	float GetClamped01(CurveType Curve) const;
+};
+
+template <typename CurveType>
+void TAlsCurvesSnapshot<CurveType>::Refresh(const TMap<FName, float>& Curves, const TConstArrayView<FName> CurveNames)
+{
+	check(CurveNames.Num() == NumCurves)
+
+	FMemory::Memzero(Values);
+
+	if (LayoutNames.Num() == Curves.Num())
+	{
+		auto ElementIndex{0};
+		auto bLayoutChanged{false};
+
+		for (const auto& Curve : Curves)
+		{
+			if (LayoutNames[ElementIndex] != Curve.Key)
+			{
+				bLayoutChanged = true;
+				break;
+			}
+
+			if (LayoutIndices[ElementIndex] != INDEX_NONE)
+			{
+				Values[LayoutIndices[ElementIndex]] = Curve.Value;
+			}
+
+			ElementIndex += 1;
+		}
+
+		if (!bLayoutChanged)
+		{
+			return;
+		}
+
+		FMemory::Memzero(Values);
+	}
+
+	LayoutNames.Reset(Curves.Num());
+	LayoutIndices.Reset(Curves.Num());
+
+	for (const auto& Curve : Curves)
+	{
+		const auto CurveIndex{CurveNames.Find(Curve.Key)};
+
+		LayoutNames.Add(Curve.Key);
+		LayoutIndices.Add(CurveIndex);
+
+		if (CurveIndex != INDEX_NONE)
+		{
+			Values[CurveIndex] = Curve.Value;
+		}
+	}
+}
+
+template <typename CurveType>
+float TAlsCurvesSnapshot<CurveType>::Get(const CurveType Curve) const
+{
+	return Values[static_cast<int32>(Curve)];
+}
+
+template <typename CurveType>
+float TAlsCurvesSnapshot<CurveType>::GetClamped01(const CurveType Curve) const
+{
+	return UAlsMath::Clamp01(Get(Curve));
+}
+
+// Animation curves read by the ALS code every frame.
+
+enum class EAlsCurve : uint8
+{
+	LayerHead,
+	LayerHeadAdditive,
+	LayerHeadSlot,
+	LayerArmLeft,
+	LayerArmLeftAdditive,
+	LayerArmLeftLocalSpace,
+	LayerArmLeftSlot,
+	LayerArmRight,
+	LayerArmRightAdditive,
+	LayerArmRightLocalSpace,
+	LayerArmRightSlot,
+	LayerHandLeft,
+	LayerHandRight,
+	LayerSpine,
+	LayerSpineAdditive,
+	LayerSpineSlot,
+	LayerPelvis,
+	LayerPelvisSlot,
+	LayerLegs,
+	LayerLegsSlot,
+	ViewBlock,
+	AllowAiming,
+	HipsDirectionLock,
+	PoseGait,
+	PoseMoving,
+	PoseStanding,
+	PoseCrouching,
+	PoseGrounded,
+	PoseInAir,
+	FootLeftIk,
+	FootLeftLock,
+	FootRightIk,
+	FootRightLock,
+	FootPlanted,
+	FeetCrossing,
+	RotationYawSpeed,
+	RotationYawOffset,
+	AllowTransitions,
+	SprintBlock,
+	GroundPredictionBlock,
+	FootstepSoundBlock,
+	Count
+};
+
+using FAlsCurvesSnapshot = TAlsCurvesSnapshot<EAlsCurve>;
+
+namespace AlsCurvesSnapshot
+{
+	// Names of the curves in the order of EAlsCurve.
+	ALS_API TConstArrayView<FName> GetCurveNames();
+}
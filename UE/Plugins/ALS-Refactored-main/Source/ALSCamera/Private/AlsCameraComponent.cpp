@@ -11,6 +11,32 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraComponent)
 
+namespace AlsCameraComponent
+{
+	// Names of the curves in the order of EAlsCameraCurve.
+	static TConstArrayView<FName> GetCurveNames()
+	{
+		static const FName CurveNames[]{
+			UAlsCameraConstants::CameraOffsetXCurveName(),
+			UAlsCameraConstants::CameraOffsetYCurveName(),
+			UAlsCameraConstants::CameraOffsetZCurveName(),
+			UAlsCameraConstants::PivotOffsetXCurveName(),
+			UAlsCameraConstants::PivotOffsetYCurveName(),
+			UAlsCameraConstants::PivotOffsetZCurveName(),
+			UAlsCameraConstants::LocationLagXCurveName(),
+			UAlsCameraConstants::LocationLagYCurveName(),
+			UAlsCameraConstants::LocationLagZCurveName(),
+			UAlsCameraConstants::RotationLagCurveName(),
+			UAlsCameraConstants::FirstPersonOverrideCurveName(),
+			UAlsCameraConstants::TraceOverrideCurveName()
+		};
+
+		static_assert(UE_ARRAY_COUNT(CurveNames) == TAlsCurvesSnapshot<EAlsCameraCurve>::NumCurves);
+
+		return CurveNames;
+	}
+}
+
 UAlsCameraComponent::UAlsCameraComponent()
 {
 	PrimaryComponentTick.bStartWithTickEnabled = false;
@@ -157,6 +183,9 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	                   TEXT(" causes the game thread to wait for the parallel task to complete, resulting in performance degradation."),
 	                   __FUNCTION__);
 
+	CurvesSnapshot.Refresh(GetAnimInstance()->GetAnimationCurveList(EAnimCurveType::AttributeCurve),
+	                       AlsCameraComponent::GetCurveNames());
+
 #if ENABLE_DRAW_DEBUG
 	const auto bDisplayDebugCameraShapes{
 		UAlsUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsCameraConstants::CameraShapesDebugDisplayName())
@@ -205,7 +234,7 @@ void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 	PivotTargetLocation = GetThirdPersonPivotLocation();
 
 	const auto FirstPersonOverride{
-		UAlsMath::Clamp01(GetAnimInstance()->GetCurveValue(UAlsCameraConstants::FirstPersonOverrideCurveName()))
+		CurvesSnapshot.GetClamped01(EAlsCameraCurve::FirstPersonOverride)
 	};
 
 	if (FAnimWeight::IsFullWeight(FirstPersonOverride))
@@ -321,7 +350,7 @@ FRotator UAlsCameraComponent::CalculateCameraRotation(const FRotator& CameraTarg
 		return CameraTargetRotation;
 	}
 
-	const auto RotationLag{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::RotationLagCurveName())};
+	const auto RotationLag{CurvesSnapshot.Get(EAlsCameraCurve::RotationLag)};
 
 	if (!Settings->bEnableCameraLagSubstepping ||
 	    DeltaTime <= Settings->CameraLagSubstepping.LagSubstepDeltaTime ||
@@ -363,9 +392,9 @@ FVector UAlsCameraComponent::CalculatePivotLagLocation(const FQuat& CameraYawRot
 	const auto RelativePivotInitialLagLocation{CameraYawRotation.UnrotateVector(PivotLagLocation)};
 	const auto RelativePivotTargetLocation{CameraYawRotation.UnrotateVector(PivotTargetLocation)};
 
-	const auto LocationLagX{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagXCurveName())};
-	const auto LocationLagY{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagYCurveName())};
-	const auto LocationLagZ{GetAnimInstance()->GetCurveValue(UAlsCameraConstants::LocationLagZCurveName())};
+	const auto LocationLagX{CurvesSnapshot.Get(EAlsCameraCurve::LocationLagX)};
+	const auto LocationLagY{CurvesSnapshot.Get(EAlsCameraCurve::LocationLagY)};
+	const auto LocationLagZ{CurvesSnapshot.Get(EAlsCameraCurve::LocationLagZ)};
 
 	if (!Settings->bEnableCameraLagSubstepping ||
 	    DeltaTime <= Settings->CameraLagSubstepping.LagSubstepDeltaTime ||
@@ -420,9 +449,9 @@ FVector UAlsCameraComponent::CalculatePivotOffset() const
 {
 	return Character->GetMesh()->GetComponentQuat().RotateVector(
 		FVector{
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetXCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetYCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::PivotOffsetZCurveName())
+			CurvesSnapshot.Get(EAlsCameraCurve::PivotOffsetX),
+			CurvesSnapshot.Get(EAlsCameraCurve::PivotOffsetY),
+			CurvesSnapshot.Get(EAlsCameraCurve::PivotOffsetZ)
 		} * Character->GetMesh()->GetComponentScale().Z);
 }
 
@@ -430,9 +459,9 @@ FVector UAlsCameraComponent::CalculateCameraOffset() const
 {
 	return CameraRotation.RotateVector(
 		FVector{
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetXCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetYCurveName()),
-			GetAnimInstance()->GetCurveValue(UAlsCameraConstants::CameraOffsetZCurveName())
+			CurvesSnapshot.Get(EAlsCameraCurve::CameraOffsetX),
+			CurvesSnapshot.Get(EAlsCameraCurve::CameraOffsetY),
+			CurvesSnapshot.Get(EAlsCameraCurve::CameraOffsetZ)
 		} * Character->GetMesh()->GetComponentScale().Z);
 }
 
@@ -455,7 +484,7 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 		FMath::Lerp(
 			GetThirdPersonTraceStartLocation(),
 			PivotTargetLocation + PivotOffset + FVector{Settings->ThirdPerson.TraceOverrideOffset},
-			UAlsMath::Clamp01(GetAnimInstance()->GetCurveValue(UAlsCameraConstants::TraceOverrideCurveName())))
+			CurvesSnapshot.GetClamped01(EAlsCameraCurve::TraceOverride))
 	};
 
 	const auto TraceEnd{CameraTargetLocation};
@@ -1,12 +1,32 @@
 #pragma once
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Utility/AlsCurvesSnapshot.h"
 #include "Utility/AlsMath.h"
 #include "AlsCameraComponent.generated.h"
 
 class UAlsCameraSettings;
 class ACharacter;
 
+// Animation curves read by the camera every tick.
+
+enum class EAlsCameraCurve : uint8
+{
+	CameraOffsetX,
+	CameraOffsetY,
+	CameraOffsetZ,
+	PivotOffsetX,
+	PivotOffsetY,
+	PivotOffsetZ,
+	LocationLagX,
+	LocationLagY,
+	LocationLagZ,
+	RotationLag,
+	FirstPersonOverride,
+	TraceOverride,
+	Count
+};
+
 UCLASS(HideCategories = ("ComponentTick", "Clothing", "Physics", "MasterPoseComponent", "Collision", "AnimationRig",
 	"Lighting", "Deformer", "Rendering", "PathTracing", "HLOD", "Navigation", "VirtualTexture", "SkeletalMesh",
 	"LeaderPoseComponent", "Optimization", "LOD", "MaterialParameters", "TextureStreaming", "Mobile", "RayTracing"))
@@ -66,6 +86,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	uint8 bRightShoulder : 1 {true};
 
+	// Copy of the animation curves, refreshed once at the beginning of each camera tick.
+	TAlsCurvesSnapshot<EAlsCameraCurve> CurvesSnapshot;
+
 public:
 	UAlsCameraComponent();
 
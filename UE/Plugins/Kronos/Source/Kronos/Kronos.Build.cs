@@ -8,7 +8,9 @@ public class Kronos : ModuleRules
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "CoreOnline", "Engine", "EngineSettings", "OnlineSubsystem", "OnlineSubsystemUtils", "Lobby", "UMG" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "CoreOnline", "Engine", "NetCore", "EngineSettings", "OnlineSubsystem", "OnlineSubsystemUtils", "Lobby", "UMG" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Sockets", "TraceLog" });
 
         if (Target.bBuildDeveloperTools || (Target.Configuration != UnrealTargetConfiguration.Shipping && Target.Configuration != UnrealTargetConfiguration.Test))
         {
@@ -67,7 +67,12 @@ void AKronosPartyClient::SetPlayerData(const TArray<int32>& NewPlayerData)
 		{
 			PartyPlayerState->ClientSetPlayerData(NewPlayerData);
 
-			ServerSetPlayerData(NewPlayerData);
+			// Changes made during the same frame are sent together.
+			if (!GetWorld()->GetTimerManager().TimerExists(TimerHandle_SendPlayerDataChanges))
+			{
+				TimerHandle_SendPlayerDataChanges = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::SendPlayerDataChanges);
+			}
+
 			return;
 		}
 	}
@@ -75,13 +80,71 @@ void AKronosPartyClient::SetPlayerData(const TArray<int32>& NewPlayerData)
 	PartyHost->ProcessPlayerDataChange(this, NewPlayerData);
 }
 
-void AKronosPartyClient::ServerSetPlayerData_Implementation(const TArray<int32>& NewPlayerData)
+void AKronosPartyClient::SendPlayerDataChanges()
 {
-	SetPlayerData(NewPlayerData);
+	AKronosPartyPlayerState* PartyPlayerState = Cast<AKronosPartyPlayerState>(PlayerState);
+	if (!PartyPlayerState)
+	{
+		return;
+	}
+
+	PartyPlayerState->bHasUnsentPlayerDataChanges = false;
+
+	// Diff against the player data we sent last, since that is what the server will have once our requests are applied.
+	// The replicated player data may still be behind, and diffing against it would drop a change that is reverted before the server answers.
+	const TArray<int32>& LastSentPlayerData = PartyPlayerState->LastSentPlayerData;
+	const TArray<int32>& LocalPlayerData = PartyPlayerState->PlayerData;
+
+	TArray<FKronosPlayerDataChange> Changes;
+	for (int32 SlotIdx = 0; SlotIdx < LocalPlayerData.Num(); SlotIdx++)
+	{
+		// New slots start at zero on the server.
+		const int32 SentValue = LastSentPlayerData.IsValidIndex(SlotIdx) ? LastSentPlayerData[SlotIdx] : 0;
+		if (LocalPlayerData[SlotIdx] != SentValue)
+		{
+			Changes.Emplace(SlotIdx, LocalPlayerData[SlotIdx]);
+		}
+	}
+
+	if (Changes.Num() > 0 || LocalPlayerData.Num() != LastSentPlayerData.Num())
+	{
+		PartyPlayerState->LastSentPlayerData = LocalPlayerData;
+		PartyPlayerState->LastSentPlayerDataSequence++;
+
+		ServerUpdatePlayerData(Changes, LocalPlayerData.Num(), PartyPlayerState->LastSentPlayerDataSequence);
+	}
+
+	// Nothing was sent if the changes were reverted, so replicated values that came in meanwhile may have to be applied now.
+	else
+	{
+		PartyPlayerState->OnRep_PlayerData();
+	}
 }
 
-bool AKronosPartyClient::ServerSetPlayerData_Validate(const TArray<int32>& NewPlayerData)
+void AKronosPartyClient::ServerUpdatePlayerData_Implementation(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence)
 {
+	AKronosPartyHost* PartyHost = Cast<AKronosPartyHost>(GetBeaconOwner());
+	if (PartyHost)
+	{
+		PartyHost->ProcessPlayerDataChanges(this, Changes, NewNum, Sequence);
+	}
+}
+
+bool AKronosPartyClient::ServerUpdatePlayerData_Validate(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence)
+{
+	if (NewNum < 0 || NewNum > MAX_PLAYER_DATA_SLOTS)
+	{
+		return false;
+	}
+
+	for (const FKronosPlayerDataChange& Change : Changes)
+	{
+		if (Change.SlotIdx < 0 || Change.SlotIdx >= NewNum)
+		{
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -114,10 +177,22 @@ void AKronosPartyClient::ServerSendChatMessage_Implementation(const FString& Msg
 	SendChatMessage(Msg);
 }
 
-void AKronosPartyClient::ClientReceiveChatMessage_Implementation(const FUniqueNetIdRepl& SenderId, const FString& Msg)
+void AKronosPartyClient::ClientRejectPlayerDataUpdate_Implementation(const TArray<int32>& AuthoritativePlayerData, const uint32 Sequence)
+{
+	AKronosPartyPlayerState* PartyPlayerState = Cast<AKronosPartyPlayerState>(PlayerState);
+	if (PartyPlayerState)
+	{
+		PartyPlayerState->ClientRejectPlayerDataChanges(AuthoritativePlayerData, Sequence);
+	}
+}
+
+void AKronosPartyClient::ClientReceiveChatMessages_Implementation(const TArray<FKronosChatMessage>& ChatMessages)
 {
 	UKronosPartyManager* PartyManager = UKronosPartyManager::Get(this);
-	PartyManager->OnChatMessageReceived().Broadcast(SenderId, Msg);
+	for (const FKronosChatMessage& ChatMessage : ChatMessages)
+	{
+		PartyManager->OnChatMessageReceived().Broadcast(ChatMessage.SenderId, ChatMessage.Msg);
+	}
 }
 
 void AKronosPartyClient::ClientFollowPartyToGameSession_Implementation(const FKronosFollowPartyParams& FollowParams)
@@ -338,6 +413,8 @@ void AKronosPartyClient::DestroyBeacon()
 		K2_OnConnectionFailure();
 	}
 
+	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SendPlayerDataChanges);
+
 	Super::DestroyBeacon();
 }
 
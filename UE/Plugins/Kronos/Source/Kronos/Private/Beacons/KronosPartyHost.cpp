@@ -24,6 +24,10 @@ AKronosPartyHost::AKronosPartyHost(const FObjectInitializer& ObjectInitializer)
 {
 	ClientBeaconActorClass = GetDefault<UKronosConfig>()->PartyClientClass;
 	LobbyStateClass = GetDefault<UKronosConfig>()->PartyStateClass;
+
+	ChatHistoryHead = 0;
+	bConnectingPartyToGameSession = false;
+	NumPlayersPendingGameSession = 0;
 }
 
 void AKronosPartyHost::OnInitialized()
@@ -67,25 +71,165 @@ void AKronosPartyHost::ProcessPlayerDataChange(AKronosPartyClient* ClientActor,
 	}
 }
 
+void AKronosPartyHost::ProcessPlayerDataChanges(AKronosPartyClient* ClientActor, const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence)
+{
+	UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: ProcessPlayerDataChanges"));
+
+	if (!ClientActor)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosPartyHost: ProcessPlayerDataChanges - Client actor is null."));
+		return;
+	}
+
+	AKronosPartyPlayerState* PartyPlayerState = Cast<AKronosPartyPlayerState>(ClientActor->PlayerState);
+
+	if (!ClientActor->IsLoggedIn() || !PartyPlayerState)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosPartyHost: ProcessPlayerDataChanges - Client is not logged in or has no player state. Rejecting request %u."), Sequence);
+
+		// The client waits for its request to be acknowledged, so answer with the authoritative player data to let it resync.
+		TArray<int32> AuthoritativePlayerData;
+		if (PartyPlayerState)
+		{
+			PartyPlayerState->ServerPlayerData.GetValues(AuthoritativePlayerData);
+		}
+
+		ClientActor->ClientRejectPlayerDataUpdate(AuthoritativePlayerData, Sequence);
+		return;
+	}
+
+	// (Not an RPC!) Changes server side player data that will replicate down to clients.
+	PartyPlayerState->ServerApplyPlayerDataChanges(Changes, NewNum, Sequence);
+}
+
 void AKronosPartyHost::ProcessChatMessage(const FUniqueNetIdRepl& SenderId, const FString& Msg)
 {
 	UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: ProcessChatMessage"));
 
 	if (SenderId.IsValid() && !Msg.IsEmpty())
 	{
-		for (AOnlineBeaconClient* BeaconClient : ClientActors)
+		if (!ConsumeChatToken(SenderId))
 		{
-			AKronosPartyClient* PartyClient = Cast<AKronosPartyClient>(BeaconClient);
-			if (PartyClient && PartyClient->IsLoggedIn())
-			{
-				PartyClient->ClientReceiveChatMessage(SenderId, Msg);
-			}
+			UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: ProcessChatMessage - Message of %s dropped. Sender is over the rate limit."), *SenderId.ToString());
+			return;
+		}
+
+		const FKronosChatMessage& ChatMessage = PendingChatMessages.Emplace_GetRef(SenderId, Msg.Left(GetDefault<UKronosConfig>()->PartyChatMaxMessageLength));
+		AddToChatHistory(ChatMessage);
+
+		// Messages of the same frame are sent together.
+		if (!GetWorldTimerManager().TimerExists(TimerHandle_SendChatMessages))
+		{
+			TimerHandle_SendChatMessages = GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::SendChatMessages);
 		}
 	}
 
 	else UE_LOG(LogKronos, Error, TEXT("KronosPartyHost: ProcessChatMessage - SenderId is invalid or message is empty."));
 }
 
+bool AKronosPartyHost::ConsumeChatToken(const FUniqueNetIdRepl& SenderId)
+{
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+	const float BurstSize = static_cast<float>(KronosConfig->PartyChatBurstSize);
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// Good time to forget the buckets of earlier senders that are full again.
+	if (!ChatRateLimits.Contains(SenderId))
+	{
+		PruneChatRateLimits();
+	}
+
+	// New senders start with a full bucket.
+	FKronosChatRateLimit& RateLimit = ChatRateLimits.FindOrAdd(SenderId, FKronosChatRateLimit(BurstSize, CurrentTime));
+
+	const double ElapsedTime = CurrentTime - RateLimit.LastRefillTime;
+	RateLimit.Tokens = FMath::Min(BurstSize, RateLimit.Tokens + static_cast<float>(ElapsedTime) * KronosConfig->PartyChatMessagesPerSecond);
+	RateLimit.LastRefillTime = CurrentTime;
+
+	if (RateLimit.Tokens < 1.0f)
+	{
+		if (!RateLimit.bIsThrottled)
+		{
+			UE_LOG(LogKronos, Warning, TEXT("KronosPartyHost: %s is over the chat rate limit. Dropping messages until the limit refills."), *SenderId.ToString());
+			RateLimit.bIsThrottled = true;
+		}
+
+		return false;
+	}
+
+	RateLimit.Tokens -= 1.0f;
+	RateLimit.bIsThrottled = false;
+	return true;
+}
+
+void AKronosPartyHost::PruneChatRateLimits()
+{
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+	const float BurstSize = static_cast<float>(KronosConfig->PartyChatBurstSize);
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (auto It = ChatRateLimits.CreateIterator(); It; ++It)
+	{
+		const FKronosChatRateLimit& RateLimit = It.Value();
+		const double ElapsedTime = CurrentTime - RateLimit.LastRefillTime;
+		if (RateLimit.Tokens + static_cast<float>(ElapsedTime) * KronosConfig->PartyChatMessagesPerSecond >= BurstSize)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void AKronosPartyHost::AddToChatHistory(const FKronosChatMessage& ChatMessage)
+{
+	const int32 HistorySize = GetDefault<UKronosConfig>()->PartyChatHistorySize;
+	if (HistorySize <= 0)
+	{
+		return;
+	}
+
+	if (ChatHistory.Num() < HistorySize)
+	{
+		ChatHistory.Add(ChatMessage);
+		return;
+	}
+
+	// Overwrite the oldest message.
+	ChatHistory[ChatHistoryHead] = ChatMessage;
+	ChatHistoryHead = (ChatHistoryHead + 1) % ChatHistory.Num();
+}
+
+TArray<FKronosChatMessage> AKronosPartyHost::GetChatHistory() const
+{
+	TArray<FKronosChatMessage> OutChatHistory;
+	OutChatHistory.Reserve(ChatHistory.Num());
+
+	for (int32 Idx = 0; Idx < ChatHistory.Num(); Idx++)
+	{
+		OutChatHistory.Add(ChatHistory[(ChatHistoryHead + Idx) % ChatHistory.Num()]);
+	}
+
+	return OutChatHistory;
+}
+
+void AKronosPartyHost::SendChatMessages()
+{
+	if (PendingChatMessages.Num() == 0)
+	{
+		return;
+	}
+
+	for (AOnlineBeaconClient* BeaconClient : ClientActors)
+	{
+		AKronosPartyClient* PartyClient = Cast<AKronosPartyClient>(BeaconClient);
+		if (PartyClient && PartyClient->IsLoggedIn())
+		{
+			PartyClient->ClientReceiveChatMessages(PendingChatMessages);
+		}
+	}
+
+	PendingChatMessages.Reset();
+}
+
 void AKronosPartyHost::ProcessPartyLeaderMatchmaking(bool bMatchmaking)
 {
 	UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: ProcessPartyLeaderMatchmaking"));
@@ -130,8 +274,13 @@ bool AKronosPartyHost::ProcessConnectPartyToGameSession()
 				ReservationManager->SetHostReservation(HostReservation);
 			}
 
+			// Every party member is in the party at this point. Each of them is counted off when they start following the party.
+			const TArray<AKronosPartyPlayerState*> PartyPlayers = PartyManager->GetPartyPlayerStates();
+			bConnectingPartyToGameSession = true;
+			NumPlayersPendingGameSession = PartyPlayers.Num();
+
 			// Tell clients to start following the host to the game session.
-			for (AKronosPartyPlayerState* PartyPlayer : PartyManager->GetPartyPlayerStates())
+			for (AKronosPartyPlayerState* PartyPlayer : PartyPlayers)
 			{
 				if (PartyPlayer->ClientActor)
 				{
@@ -145,7 +294,6 @@ bool AKronosPartyHost::ProcessConnectPartyToGameSession()
 				}
 			}
 
-			GetWorldTimerManager().SetTimer(TimerHandle_ConnectingPartyToGameSession, this, &ThisClass::TickConnectingPartyToGameSession, CONNECT_PARTY_TO_GAMESESSION_TICKRATE, true);
 			GetWorldTimerManager().SetTimer(TimerHandle_TimeoutConnectingPartyToGameSession, this, &ThisClass::OnConnectPartyToGameSessionTimeout, CONNECT_PARTY_TO_GAMESESSION_TIMEOUT, false);
 			return true;
 		}
@@ -241,35 +389,53 @@ AKronosPartyState* AKronosPartyHost::GetPartyState() const
 	return Cast<AKronosPartyState>(LobbyState);
 }
 
-void AKronosPartyHost::TickConnectingPartyToGameSession()
+void AKronosPartyHost::NotifyPlayerLeftLobby(ALobbyBeaconPlayerState* Player)
 {
-	UKronosPartyManager* PartyManager = UKronosPartyManager::Get(this);
-	for (AKronosPartyPlayerState* PartyPlayer : PartyManager->GetPartyPlayerStates())
+	if (!bConnectingPartyToGameSession)
 	{
-		if (PartyPlayer->bInLobby)
-		{
-			UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: TickConnectingPartyToGameSession() - Not all clients confirmed yet. Waiting..."));
-			return;
-		}
+		return;
 	}
 
-	OnConnectPartyToGameSessionComplete();
+	NumPlayersPendingGameSession--;
+	if (NumPlayersPendingGameSession > 0)
+	{
+		UE_LOG(LogKronos, Verbose, TEXT("KronosPartyHost: %s stopped waiting in the party. Waiting for %d more player(s)..."), Player ? *Player->DisplayName.ToString() : TEXT("Unknown player"), NumPlayersPendingGameSession);
+		return;
+	}
+
+	// Traveling destroys the party beacons, so let the current RPC or disconnect finish first.
+	GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::OnConnectPartyToGameSessionComplete);
 }
 
 void AKronosPartyHost::OnConnectPartyToGameSessionComplete()
 {
+	if (!bConnectingPartyToGameSession)
+	{
+		return;
+	}
+
 	UE_LOG(LogKronos, Log, TEXT("KronosPartyHost: Connecting party to game session complete."));
 
-	GetWorldTimerManager().ClearTimer(TimerHandle_ConnectingPartyToGameSession);
+	bConnectingPartyToGameSession = false;
+	GetWorldTimerManager().ClearTimer(TimerHandle_TimeoutConnectingPartyToGameSession);
+
+	OnPartyConnectedToGameSession().Broadcast();
 
 	TravelToGameSession();
 }
 
 void AKronosPartyHost::OnConnectPartyToGameSessionTimeout()
 {
+	if (!bConnectingPartyToGameSession)
+	{
+		return;
+	}
+
 	UE_LOG(LogKronos, Warning, TEXT("KronosPartyHost: Connecting party to game session timed out."));
 
-	GetWorldTimerManager().ClearTimer(TimerHandle_ConnectingPartyToGameSession);
+	bConnectingPartyToGameSession = false;
+
+	OnPartyConnectedToGameSession().Broadcast();
 
 	TravelToGameSession();
 }
@@ -334,6 +500,10 @@ bool AKronosPartyHost::PreLogin(const FUniqueNetIdRepl& InUniqueId, const FStrin
 
 ALobbyBeaconPlayerState* AKronosPartyHost::HandlePlayerLogin(ALobbyBeaconClient* ClientActor, const FUniqueNetIdRepl& InUniqueId, const FString& Options)
 {
+	// Send pending chat messages before the player is logged in.
+	// The player receives them with the chat history instead, so they are not received twice.
+	SendChatMessages();
+
 	ALobbyBeaconPlayerState* ClientPlayerState = Super::HandlePlayerLogin(ClientActor, InUniqueId, Options);
 	if (ClientPlayerState)
 	{
@@ -374,11 +544,31 @@ void AKronosPartyHost::PostLogin(ALobbyBeaconClient* ClientActor)
 		// Give us a chance to initialize the player on server side.
 		PartyClientActor->ServerInitPlayer();
 
+		// Catch the player up with the recent chat messages.
+		if (ChatHistory.Num() > 0)
+		{
+			PartyClientActor->ClientReceiveChatMessages(GetChatHistory());
+		}
+
 		// Give blueprints a chance to implement custom logic.
 		K2_OnClientJoinedParty(PartyClientActor);
 	}
 }
 
+void AKronosPartyHost::ProcessJoinServer(ALobbyBeaconClient* ClientActor)
+{
+	ALobbyBeaconPlayerState* Player = LobbyState ? LobbyState->GetPlayer(ClientActor) : nullptr;
+	const bool bWasInLobby = Player && Player->bInLobby;
+
+	Super::ProcessJoinServer(ClientActor);
+
+	// Count the player off as soon as the follow party request is acknowledged.
+	if (bWasInLobby && !Player->bInLobby)
+	{
+		NotifyPlayerLeftLobby(Player);
+	}
+}
+
 void AKronosPartyHost::NotifyClientDisconnected(AOnlineBeaconClient* LeavingClientActor)
 {
 	AKronosPartyClient* PartyClientActor = CastChecked<AKronosPartyClient>(LeavingClientActor);
@@ -386,6 +576,9 @@ void AKronosPartyHost::NotifyClientDisconnected(AOnlineBeaconClient* LeavingClie
 	{
 		// Give blueprints a chance to implement custom logic.
 		K2_OnClientLeavingParty(PartyClientActor);
+
+		// The bucket of the leaving player is kept until it refills, so that rejoining can't be used to skip the rate limit.
+		PruneChatRateLimits();
 	}
 
 	//~ Begin Super::NotifyClientDisconnected Implementation
@@ -405,6 +598,9 @@ void AKronosPartyHost::NotifyClientDisconnected(AOnlineBeaconClient* LeavingClie
 			// By default the lobby beacon would attempt to unregister the player from NAME_GameSession.
 			GameMode->GameSession->NotifyLogout(NAME_PartySession, Player->UniqueId);
 			HandlePlayerLogout(Player->UniqueId);
+
+			// Don't wait for players who left the party while it was being connected to the session.
+			NotifyPlayerLeftLobby(Player);
 		}
 	}
 	else
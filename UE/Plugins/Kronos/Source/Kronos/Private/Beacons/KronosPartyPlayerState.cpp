@@ -6,6 +6,90 @@
 #include "Kronos.h"
 #include "Net/UnrealNetwork.h"
 
+void FKronosPlayerDataArray::SetValues(const TArray<int32>& NewValues)
+{
+	const int32 NumCommonSlots = FMath::Min(Items.Num(), NewValues.Num());
+	for (int32 SlotIdx = 0; SlotIdx < NumCommonSlots; SlotIdx++)
+	{
+		if (Items[SlotIdx].Value != NewValues[SlotIdx])
+		{
+			Items[SlotIdx].Value = NewValues[SlotIdx];
+			MarkItemDirty(Items[SlotIdx]);
+		}
+	}
+
+	for (int32 SlotIdx = Items.Num(); SlotIdx < NewValues.Num(); SlotIdx++)
+	{
+		MarkItemDirty(Items.Emplace_GetRef(SlotIdx, NewValues[SlotIdx]));
+	}
+
+	if (Items.Num() > NewValues.Num())
+	{
+		Items.SetNum(NewValues.Num());
+		MarkArrayDirty();
+	}
+}
+
+void FKronosPlayerDataArray::ApplyChanges(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum)
+{
+	for (int32 SlotIdx = Items.Num(); SlotIdx < NewNum; SlotIdx++)
+	{
+		MarkItemDirty(Items.Emplace_GetRef(SlotIdx, 0));
+	}
+
+	if (Items.Num() > NewNum)
+	{
+		Items.SetNum(FMath::Max(NewNum, 0));
+		MarkArrayDirty();
+	}
+
+	for (const FKronosPlayerDataChange& Change : Changes)
+	{
+		if (Items.IsValidIndex(Change.SlotIdx) && Items[Change.SlotIdx].Value != Change.Value)
+		{
+			Items[Change.SlotIdx].Value = Change.Value;
+			MarkItemDirty(Items[Change.SlotIdx]);
+		}
+	}
+}
+
+void FKronosPlayerDataArray::GetValues(TArray<int32>& OutValues) const
+{
+	int32 NumSlots = 0;
+	for (const FKronosPlayerDataSlot& Item : Items)
+	{
+		NumSlots = FMath::Max(NumSlots, Item.SlotIdx + 1);
+	}
+
+	OutValues.Reset(NumSlots);
+	OutValues.SetNumZeroed(NumSlots);
+
+	for (const FKronosPlayerDataSlot& Item : Items)
+	{
+		if (Item.SlotIdx >= 0)
+		{
+			OutValues[Item.SlotIdx] = Item.Value;
+		}
+	}
+}
+
+void FKronosPlayerDataArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwnerPlayerState)
+	{
+		OwnerPlayerState->OnRep_PlayerData();
+	}
+}
+
+AKronosPartyPlayerState::AKronosPartyPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	ServerPlayerData.OwnerPlayerState = this;
+	ServerPlayerDataSequence = 0;
+	LastSentPlayerDataSequence = 0;
+	RejectedPlayerDataSequence = 0;
+	bHasUnsentPlayerDataChanges = false;
+}
+
 void AKronosPartyPlayerState::ServerSetPlayerElo(int32 NewPlayerElo)
 {
 	PlayerElo = NewPlayerElo;
@@ -14,18 +98,50 @@ void AKronosPartyPlayerState::ServerSetPlayerElo(int32 NewPlayerElo)
 
 void AKronosPartyPlayerState::ServerSetPlayerData(const TArray<int32>& NewPlayerData)
 {
-	ServerPlayerData = NewPlayerData;
+	ServerPlayerData.SetValues(NewPlayerData);
+	OnRep_PlayerData();
+}
+
+void AKronosPartyPlayerState::ServerApplyPlayerDataChanges(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence)
+{
+	ServerPlayerData.ApplyChanges(Changes, NewNum);
+	ServerPlayerDataSequence = Sequence;
 	OnRep_PlayerData();
 }
 
 void AKronosPartyPlayerState::ClientSetPlayerData(const TArray<int32>& NewPlayerData)
 {
 	PlayerData = NewPlayerData;
+	bHasUnsentPlayerDataChanges = true;
 
 	K2_OnPlayerDataChanged(NewPlayerData);
 	OnKronosPartyPlayerDataChanged().Broadcast(PlayerData);
 }
 
+void AKronosPartyPlayerState::ClientRejectPlayerDataChanges(const TArray<int32>& AuthoritativePlayerData, const uint32 Sequence)
+{
+	UE_LOG(LogKronos, Warning, TEXT("KronosPartyPlayerState (%s): Player data change request %u was rejected by the server."), *DisplayName.ToString(), Sequence);
+
+	RejectedPlayerDataSequence = FMath::Max(RejectedPlayerDataSequence, Sequence);
+
+	// Requests sent after the rejected one will bring the authoritative player data with them.
+	if (HasPendingPlayerDataChanges())
+	{
+		return;
+	}
+
+	// The server is in sync with us, so further changes can be diffed against its values.
+	LastSentPlayerData = AuthoritativePlayerData;
+
+	if (PlayerData != AuthoritativePlayerData)
+	{
+		PlayerData = AuthoritativePlayerData;
+
+		K2_OnPlayerDataChanged(PlayerData);
+		OnKronosPartyPlayerDataChanged().Broadcast(PlayerData);
+	}
+}
+
 void AKronosPartyPlayerState::SetPlayerActor(AKronosPartyPlayerActor* NewPlayerActor)
 {
 	PlayerActor = NewPlayerActor;
@@ -78,19 +194,44 @@ void AKronosPartyPlayerState::OnRep_PlayerElo()
 
 void AKronosPartyPlayerState::OnRep_PlayerData()
 {
-	if (PlayerData != ServerPlayerData)
+	// The local values are newer than the replicated ones. Wait for the server to catch up.
+	if (HasPendingPlayerDataChanges())
 	{
-		PlayerData = ServerPlayerData;
+		return;
+	}
+
+	TArray<int32> NewPlayerData;
+	ServerPlayerData.GetValues(NewPlayerData);
+
+	// The server is in sync with us, so further changes can be diffed against its values.
+	LastSentPlayerData = NewPlayerData;
+
+	if (PlayerData != NewPlayerData)
+	{
+		PlayerData = MoveTemp(NewPlayerData);
 
 		K2_OnPlayerDataChanged(PlayerData);
 		OnKronosPartyPlayerDataChanged().Broadcast(PlayerData);
 	}
 }
 
+void AKronosPartyPlayerState::OnRep_PlayerDataSequence()
+{
+	// The slots may have replicated before the sequence number, in which case they were ignored.
+	OnRep_PlayerData();
+}
+
+bool AKronosPartyPlayerState::HasPendingPlayerDataChanges() const
+{
+	// Only the owning client sends change requests, so this is always false for everyone else.
+	return bHasUnsentPlayerDataChanges || LastSentPlayerDataSequence > FMath::Max(ServerPlayerDataSequence, RejectedPlayerDataSequence);
+}
+
 void AKronosPartyPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(AKronosPartyPlayerState, PlayerElo);
 	DOREPLIFETIME(AKronosPartyPlayerState, ServerPlayerData);
+	DOREPLIFETIME(AKronosPartyPlayerState, ServerPlayerDataSequence);
 }
@@ -37,6 +37,7 @@ bool AKronosReservationClient::RequestReservation(const FKronosSearchResult& InS
 
 						bReservationRequestPending = true;
 						ReservationRequestCompleteDelegate = CompletionDelegate;
+						ReservationQueuePosition = 0;
 
 						return true;
 					}
@@ -117,10 +118,23 @@ void AKronosReservationClient::ClientReceiveReservationResponse_Implementation(E
 	if (bReservationRequestPending)
 	{
 		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_TimeoutReservationRequest);
+		ReservationQueuePosition = 0;
 		SignalReservationRequestComplete(DestSession, Result);
 	}
 }
 
+void AKronosReservationClient::ClientReceiveReservationQueuePosition_Implementation(int32 QueuePosition)
+{
+	if (bReservationRequestPending)
+	{
+		UE_LOG(LogKronos, Log, TEXT("KronosReservationClient: Reservation request queued by the host. Position: %d"), QueuePosition);
+
+		// The host is still working on the request, so give it more time to respond.
+		ReservationQueuePosition = QueuePosition;
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_TimeoutReservationRequest, this, &ThisClass::OnRequestReservationTimeout, REQUEST_TIMEOUT, false);
+	}
+}
+
 void AKronosReservationClient::ServerCancelReservation_Implementation(const FKronosReservation& Reservation)
 {
 	AKronosReservationHost* BeaconHost = Cast<AKronosReservationHost>(GetBeaconOwner());
@@ -3,6 +3,7 @@
 #include "Beacons/KronosReservationHost.h"
 #include "Beacons/KronosReservationClient.h"
 #include "KronosOnlineSession.h"
+#include "KronosMatchmakingRules.h"
 #include "KronosConfig.h"
 #include "Kronos.h"
 #include "GameFramework/GameStateBase.h"
@@ -15,6 +16,9 @@ AKronosReservationHost::AKronosReservationHost(const FObjectInitializer& ObjectI
 {
 	ClientBeaconActorClass = GetDefault<UKronosConfig>()->ReservationClientClass;
 	BeaconTypeName = ClientBeaconActorClass->GetName();
+
+	NumConsumedReservations = 0;
+	LastReservationTimeoutGeneration = 0;
 }
 
 bool AKronosReservationHost::InitHostBeacon(const int32 InMaxReservations)
@@ -47,11 +51,121 @@ void AKronosReservationHost::ProcessReservationRequest(AKronosReservationClient*
 
 	if (Client)
 	{
-		EKronosReservationCompleteResult Result = EKronosReservationCompleteResult::UnknownError;
-		Result = RegisterReservation(InReservation);
+		// Answer right away if requests shouldn't be collected, or if the request couldn't be registered anyway.
+		const float AdmissionWindow = GetDefault<UKronosConfig>()->ReservationAdmissionWindow;
+		if (AdmissionWindow <= 0.0f || !InReservation.IsValid(false))
+		{
+			SendReservationResponse(Client, RegisterReservation(InReservation));
+			return;
+		}
+
+		ReservationQueue.Emplace(Client, InReservation, GetWorld()->GetTimeSeconds());
+
+		if (!GetWorld()->GetTimerManager().IsTimerActive(TimerHandle_ReservationQueue))
+		{
+			GetWorld()->GetTimerManager().SetTimer(TimerHandle_ReservationQueue, this, &ThisClass::ProcessReservationQueue, AdmissionWindow, false);
+		}
+	}
+}
+
+void AKronosReservationHost::ProcessReservationQueue()
+{
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+	// Forget the requests of clients that are gone.
+	ReservationQueue.RemoveAll([](const FKronosQueuedReservationRequest& Request)
+	{
+		return !Request.Client.IsValid();
+	});
+
+	// Take the requests out of the queue before answering them, because registering reservations triggers events.
+	TArray<FKronosQueuedReservationRequest> Requests = MoveTemp(ReservationQueue);
+	ReservationQueue.Reset();
+
+	TArray<int32> RequestSizes;
+	RequestSizes.Reserve(Requests.Num());
+
+	for (const FKronosQueuedReservationRequest& Request : Requests)
+	{
+		RequestSizes.Add(Request.Reservation.ReservationMembers.Num());
+	}
+
+	TArray<int32> AdmittedIndices;
+	PackReservationRequests(RequestSizes, FMath::Max(MaxNumReservations - GetNumConsumedReservations(), 0), AdmittedIndices);
+
+	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Processing %d queued reservation request(s). Admitting %d."), Requests.Num(), AdmittedIndices.Num());
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	TArray<FKronosQueuedReservationRequest> WaitingRequests;
+	int32 AdmittedIdx = 0;
+
+	for (int32 RequestIdx = 0; RequestIdx < Requests.Num(); RequestIdx++)
+	{
+		FKronosQueuedReservationRequest& Request = Requests[RequestIdx];
 
-		KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation processed. Result: %s"), LexToString(Result));
+		if (AdmittedIndices.IsValidIndex(AdmittedIdx) && AdmittedIndices[AdmittedIdx] == RequestIdx)
+		{
+			AdmittedIdx++;
+			SendReservationResponse(Request.Client.Get(), RegisterReservation(Request.Reservation));
+			continue;
+		}
 
+		// Reject requests that would never fit, or that have waited long enough for slots to free up.
+		if (RequestSizes[RequestIdx] > MaxNumReservations || CurrentTime - Request.QueueTime >= KronosConfig->ReservationQueueTimeout)
+		{
+			SendReservationResponse(Request.Client.Get(), EKronosReservationCompleteResult::ReservationLimitReached);
+			continue;
+		}
+
+		WaitingRequests.Add(MoveTemp(Request));
+	}
+
+	if (WaitingRequests.Num() > 0)
+	{
+		// Requests that were received while answering are queued behind the waiting ones.
+		ReservationQueue.Insert(MoveTemp(WaitingRequests), 0);
+	}
+
+	// Tell the waiting clients where they are in the queue. The queue position is also what keeps the request of the client from timing out,
+	// so an unchanged position is still resent before half of the request timeout has passed.
+	const double KeepAliveInterval = REQUEST_TIMEOUT * 0.5f;
+
+	for (int32 QueueIdx = 0; QueueIdx < ReservationQueue.Num(); QueueIdx++)
+	{
+		FKronosQueuedReservationRequest& Request = ReservationQueue[QueueIdx];
+		if (Request.LastSentQueuePosition == QueueIdx + 1 && CurrentTime - Request.LastSentQueuePositionTime < KeepAliveInterval)
+		{
+			continue;
+		}
+
+		if (AKronosReservationClient* Client = Request.Client.Get())
+		{
+			Client->ClientReceiveReservationQueuePosition(QueueIdx + 1);
+			Request.LastSentQueuePosition = QueueIdx + 1;
+			Request.LastSentQueuePositionTime = CurrentTime;
+		}
+	}
+
+	if (ReservationQueue.Num() > 0)
+	{
+		// Process the queue often enough for the keep-alive to reach the clients in time.
+		const float ProcessInterval = FMath::Min(FMath::Max(KronosConfig->ReservationAdmissionWindow, KINDA_SMALL_NUMBER), static_cast<float>(KeepAliveInterval));
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle_ReservationQueue, this, &ThisClass::ProcessReservationQueue, ProcessInterval, false);
+	}
+}
+
+void AKronosReservationHost::PackReservationRequests(const TArray<int32>& RequestSizes, const int32 NumFreeSlots, TArray<int32>& OutAdmittedIndices) const
+{
+	KronosMatchmakingRules::PackReservationRequests(RequestSizes, NumFreeSlots, OutAdmittedIndices);
+}
+
+void AKronosReservationHost::SendReservationResponse(AKronosReservationClient* Client, const EKronosReservationCompleteResult Result)
+{
+	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation processed. Result: %s"), LexToString(Result));
+
+	if (Client)
+	{
 		Client->ClientReceiveReservationResponse(Result);
 	}
 }
@@ -89,8 +203,19 @@ EKronosReservationCompleteResult AKronosReservationHost::RegisterReservation(con
 	}
 
 	UKronosOnlineSession* KronosOnlineSession = UKronosOnlineSession::Get(this);
-	for (const FKronosReservationMember& ResMember : InReservation.ReservationMembers)
+	for (int32 PlayerIdx = 0; PlayerIdx < InReservation.ReservationMembers.Num(); PlayerIdx++)
 	{
+		const FKronosReservationMember& ResMember = InReservation.ReservationMembers[PlayerIdx];
+
+		// Each player may only be in the reservation once.
+		for (int32 OtherPlayerIdx = 0; OtherPlayerIdx < PlayerIdx; OtherPlayerIdx++)
+		{
+			if (InReservation.ReservationMembers[OtherPlayerIdx].PlayerId == ResMember.PlayerId)
+			{
+				return EKronosReservationCompleteResult::ReservationInvalid;
+			}
+		}
+
 		// Check if player is banned from the session.
 		if (KronosOnlineSession && KronosOnlineSession->IsPlayerBannedFromSession(NAME_GameSession, *ResMember.PlayerId.GetUniqueNetId()))
 		{
@@ -99,13 +224,11 @@ EKronosReservationCompleteResult AKronosReservationHost::RegisterReservation(con
 
 		// Check for duplicate reservations.
 		{
-			FKronosReservationMember PlayerReservation;
-			FKronosReservation OwningReservation;
-
-			if (FindReservation(ResMember.PlayerId, PlayerReservation, OwningReservation))
+			const FKronosReservationMember* PlayerReservation = FindReservationMember(ResMember.PlayerId);
+			if (PlayerReservation)
 			{
 				// The player already has a reservation, and according to the reservation the player is already in the game.
-				if (PlayerReservation.bIsCompleted)
+				if (PlayerReservation->bIsCompleted)
 				{
 					return EKronosReservationCompleteResult::ReservationDuplicate;
 				}
@@ -124,20 +247,48 @@ EKronosReservationCompleteResult AKronosReservationHost::RegisterReservation(con
 
 	// Register the reservation.
 	int32 ReservationIdx = Reservations.Add(InReservation);
+	NumConsumedReservations += InReservation.ReservationMembers.Num();
 
-	// Set reservation timeouts.
-	for (FKronosReservationMember& ResMember : Reservations[ReservationIdx].ReservationMembers)
+	// Index the reservation members, and set reservation timeouts.
+	const float ReservationTimeout = GetDefault<UKronosConfig>()->ReservationTimeout;
+	const double TimeoutTime = ReservationTimeout > 0.0f ? GetWorld()->GetTimeSeconds() + ReservationTimeout : 0.0;
+
+	TArray<FKronosReservationMember>& ReservationMembers = Reservations[ReservationIdx].ReservationMembers;
+	for (int32 PlayerIdx = 0; PlayerIdx < ReservationMembers.Num(); PlayerIdx++)
 	{
-		FTimerDelegate TimeoutDelegate = FTimerDelegate::CreateUFunction(this, TEXT("TimeoutReservation"), ResMember.PlayerId);
-		GetWorld()->GetTimerManager().SetTimer(ResMember.TimerHandle_ReservationTimeout, TimeoutDelegate, GetDefault<UKronosConfig>()->ReservationTimeout, false);
+		FKronosReservationMember& ResMember = ReservationMembers[PlayerIdx];
+		ReservationMemberHandles.Add(ResMember.PlayerId, FKronosReservationMemberHandle(ReservationIdx, PlayerIdx));
+
+		ResMember.TimeoutTime = TimeoutTime;
+		if (TimeoutTime > 0.0)
+		{
+			// Skip zero on wrap around, it means that the member has no timeout.
+			LastReservationTimeoutGeneration = LastReservationTimeoutGeneration == MAX_uint32 ? 1 : LastReservationTimeoutGeneration + 1;
+
+			ResMember.TimeoutGeneration = LastReservationTimeoutGeneration;
+			ReservationTimeouts.HeapPush(FKronosReservationTimeout(TimeoutTime, ResMember.PlayerId, ResMember.TimeoutGeneration));
+		}
 	}
 
+	ScheduleReservationTimeouts();
+
 	// Notification that a new reservation has been registered.
 	OnReservationRegistered(Reservations[ReservationIdx]);
 
 	return EKronosReservationCompleteResult::ReservationAccepted;
 }
 
+void AKronosReservationHost::RegisterReservations(const TArray<FKronosReservation>& InReservations, TArray<EKronosReservationCompleteResult>& OutResults)
+{
+	OutResults.Reset(InReservations.Num());
+	ReservationMemberHandles.Reserve(ReservationMemberHandles.Num() + InReservations.Num());
+
+	for (const FKronosReservation& Reservation : InReservations)
+	{
+		OutResults.Add(RegisterReservation(Reservation));
+	}
+}
+
 void AKronosReservationHost::OnReservationRegistered(const FKronosReservation& NewReservation)
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation registered for %d player(s)."), NewReservation.ReservationMembers.Num());
@@ -156,59 +307,91 @@ void AKronosReservationHost::ProcessCancelReservation(AKronosReservationClient*
 
 	if (Client)
 	{
+		// The request may not have been answered yet.
+		ReservationQueue.RemoveAll([Client](const FKronosQueuedReservationRequest& Request)
+		{
+			return Request.Client.Get() == Client;
+		});
+
+		TArray<FUniqueNetIdRepl> PlayerIds;
+		PlayerIds.Reserve(InReservation.ReservationMembers.Num());
+
 		for (const FKronosReservationMember& ReservationMember : InReservation.ReservationMembers)
 		{
-			RemoveReservation(ReservationMember.PlayerId);
+			PlayerIds.Add(ReservationMember.PlayerId);
 		}
 
+		RemoveReservations(PlayerIds);
+
 		Client->ClientCancelReservationComplete();
 	}
 }
 
 bool AKronosReservationHost::RemoveReservation(const FUniqueNetIdRepl& PlayerId)
 {
-	if (PlayerId.IsValid())
+	FKronosReservation* ReservationEntry = nullptr;
+	FKronosReservationMember* ReservationMember = FindReservationMember(PlayerId, &ReservationEntry);
+	if (ReservationMember)
 	{
-		for (int32 ResIdx = 0; ResIdx < Reservations.Num(); ResIdx++)
+		if (ReservationEntry->ReservationOwner == PlayerId)
 		{
-			FKronosReservation& ReservationEntry = Reservations[ResIdx];
-			for (int32 PlayerIdx = 0; PlayerIdx < ReservationEntry.ReservationMembers.Num(); PlayerIdx++)
+			// Notification that the reservation's owner is getting removed.
+			PreReservationOwnerRemoved(PlayerId, *ReservationEntry);
+
+			// The notification may have changed the reservations, so find the player again.
+			ReservationMember = FindReservationMember(PlayerId, &ReservationEntry);
+			if (!ReservationMember)
 			{
-				if (*ReservationEntry.ReservationMembers[PlayerIdx].PlayerId == PlayerId)
-				{
-					// Clear reservation timeout for the player since there is no point in waiting for him.
-					FTimerHandle& TimeoutHandle = ReservationEntry.ReservationMembers[PlayerIdx].TimerHandle_ReservationTimeout;
-					GetWorld()->GetTimerManager().ClearTimer(TimeoutHandle);
-
-					if (ReservationEntry.ReservationOwner == PlayerId)
-					{
-						// Notification that the reservation's owner is getting removed.
-						PreReservationOwnerRemoved(PlayerId, ReservationEntry);
-
-						static FUniqueNetIdRepl EmptyId = FUniqueNetIdRepl();
-						ReservationEntry.ReservationOwner = EmptyId;
-					}
-
-					// Remove the reservation.
-					Reservations[ResIdx].ReservationMembers.RemoveAt(PlayerIdx);
-					if (ReservationEntry.ReservationMembers.Num() == 0)
-					{
-						Reservations.RemoveAt(ResIdx);
-					}
-
-					// Notification that the reservation was removed.
-					OnReservationRemoved(PlayerId);
-
-					return true;
-				}
+				return true;
 			}
+
+			static FUniqueNetIdRepl EmptyId = FUniqueNetIdRepl();
+			ReservationEntry->ReservationOwner = EmptyId;
 		}
+
+		// Remove the reservation.
+		const FKronosReservationMemberHandle MemberHandle = ReservationMemberHandles.FindAndRemoveChecked(PlayerId);
+		ReservationEntry->ReservationMembers.RemoveAt(MemberHandle.MemberIdx);
+		NumConsumedReservations--;
+
+		if (ReservationEntry->ReservationMembers.Num() == 0)
+		{
+			Reservations.RemoveAt(MemberHandle.ReservationIdx);
+		}
+
+		else
+		{
+			// Only the members after the removed one have moved. There are only a few members in a reservation.
+			for (int32 PlayerIdx = MemberHandle.MemberIdx; PlayerIdx < ReservationEntry->ReservationMembers.Num(); PlayerIdx++)
+			{
+				ReservationMemberHandles.FindChecked(ReservationEntry->ReservationMembers[PlayerIdx].PlayerId).MemberIdx = PlayerIdx;
+			}
+		}
+
+		// Notification that the reservation was removed.
+		OnReservationRemoved(PlayerId);
+
+		return true;
 	}
 
 	UE_LOG(LogKronos, Error, TEXT("KronosReservationHost: Failed to remove reservation for %s."), *PlayerId.ToDebugString());
 	return false;
 }
 
+int32 AKronosReservationHost::RemoveReservations(const TArray<FUniqueNetIdRepl>& PlayerIds)
+{
+	int32 NumRemoved = 0;
+	for (const FUniqueNetIdRepl& PlayerId : PlayerIds)
+	{
+		if (RemoveReservation(PlayerId))
+		{
+			NumRemoved++;
+		}
+	}
+
+	return NumRemoved;
+}
+
 void AKronosReservationHost::OnReservationRemoved(const FUniqueNetIdRepl& PlayerId)
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation removed for %s."), *PlayerId.ToDebugString());
@@ -227,113 +410,153 @@ void AKronosReservationHost::PreReservationOwnerRemoved(const FUniqueNetIdRepl&
 
 bool AKronosReservationHost::CompleteReservation(const FUniqueNetIdRepl& PlayerId)
 {
-	if (PlayerId.IsValid())
+	FKronosReservationMember* ReservationMember = FindReservationMember(PlayerId);
+	if (ReservationMember)
 	{
-		for (FKronosReservation& ReservationEntry : Reservations)
-		{
-			for (FKronosReservationMember& ReservationMember : ReservationEntry.ReservationMembers)
-			{
-				if (ReservationMember.PlayerId == PlayerId)
-				{
-					ReservationMember.bIsCompleted = true;
-					GetWorld()->GetTimerManager().ClearTimer(ReservationMember.TimerHandle_ReservationTimeout);
-
-					KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation completed for %s."), *PlayerId.ToDebugString());
-					if (UE_LOG_ACTIVE(LogKronos, Verbose))
-					{
-						DumpReservations();
-					}
+		ReservationMember->bIsCompleted = true;
 
-					return true;
-				}
-			}
+		KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationHost: Reservation completed for %s."), *PlayerId.ToDebugString());
+		if (UE_LOG_ACTIVE(LogKronos, Verbose))
+		{
+			DumpReservations();
 		}
+
+		return true;
 	}
 
 	UE_LOG(LogKronos, Error, TEXT("KronosReservationHost: Failed to complete reservation for %s."), *PlayerId.ToDebugString());
 	return false;
 }
 
-void AKronosReservationHost::TimeoutReservation(const FUniqueNetIdRepl& PlayerId)
+void AKronosReservationHost::ScheduleReservationTimeouts()
 {
-	if (PlayerId.IsValid())
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (ReservationTimeouts.Num() == 0)
 	{
-		FKronosReservationMember PlayerReservation;
-		FKronosReservation OwningReservation;
+		TimerManager.ClearTimer(TimerHandle_ReservationTimeouts);
+		return;
+	}
 
-		if (FindReservation(PlayerId, PlayerReservation, OwningReservation))
-		{
-			// Make sure that the player hasn't joined yet.
-			for (APlayerState* PlayerState : GetWorld()->GetGameState()->PlayerArray)
-			{
-				if (PlayerState->GetUniqueId() == PlayerId)
-				{
-					// Player is logged in. No need to remove reservation. We'll also fix the reservation state.
-					PlayerReservation.bIsCompleted = true;
-					return;
-				}
-			}
+	const double TimeUntilTimeout = ReservationTimeouts.HeapTop().TimeoutTime - GetWorld()->GetTimeSeconds();
+	TimerManager.SetTimer(TimerHandle_ReservationTimeouts, this, &ThisClass::ProcessReservationTimeouts, FMath::Max(static_cast<float>(TimeUntilTimeout), KINDA_SMALL_NUMBER), false);
+}
+
+void AKronosReservationHost::ProcessReservationTimeouts()
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
 
-			// Player hasn't joined yet. Revoke his reservation.
-			UE_LOG(LogKronos, Log, TEXT("KronosReservationHost: Reservation timed out for %s"), *PlayerId.ToDebugString());
-			RemoveReservation(PlayerId);
+	TArray<FUniqueNetIdRepl> ExpiredPlayerIds;
+	while (ReservationTimeouts.Num() > 0 && ReservationTimeouts.HeapTop().TimeoutTime <= CurrentTime)
+	{
+		FKronosReservationTimeout Timeout = FKronosReservationTimeout(0.0, FUniqueNetIdRepl(), 0);
+		ReservationTimeouts.HeapPop(Timeout, false);
+
+		// Skip timeouts of reservations that have been completed or removed since. If the player registered
+		// a new reservation in the meantime, the generation won't match and the newer timeout will handle it.
+		// Matching the timeout time instead isn't enough, a new reservation may be registered with the same time.
+		const FKronosReservationMember* ReservationMember = FindReservationMember(Timeout.PlayerId);
+		if (ReservationMember && !ReservationMember->bIsCompleted && ReservationMember->TimeoutGeneration == Timeout.Generation)
+		{
+			ExpiredPlayerIds.Add(Timeout.PlayerId);
 		}
+	}
 
-		else UE_LOG(LogKronos, Warning, TEXT("KronosReservationHost: TimeoutReservation failed - could not find reservation for player: %s"), *PlayerId.ToDebugString());
+	if (ExpiredPlayerIds.Num() > 0)
+	{
+		TimeoutReservations(ExpiredPlayerIds);
 	}
 
-	else UE_LOG(LogKronos, Error, TEXT("KronosReservationHost: TimeoutReservation failed - invalid player id."));
+	ScheduleReservationTimeouts();
 }
 
-bool AKronosReservationHost::PlayerHasReservation(const FUniqueNetIdRepl& PlayerId) const
+void AKronosReservationHost::TimeoutReservations(const TArray<FUniqueNetIdRepl>& PlayerIds)
 {
-	if (PlayerId.IsValid())
+	// Index the players that are logged in, so that each expired reservation can be checked in constant time.
+	TSet<FUniqueNetIdRepl> LoggedInPlayerIds;
+	if (AGameStateBase* GameState = GetWorld()->GetGameState())
 	{
-		for (const FKronosReservation& ReservationEntry : Reservations)
+		LoggedInPlayerIds.Reserve(GameState->PlayerArray.Num());
+		for (APlayerState* PlayerState : GameState->PlayerArray)
 		{
-			for (const FKronosReservationMember& ReservationMember : ReservationEntry.ReservationMembers)
+			if (PlayerState && PlayerState->GetUniqueId().IsValid())
 			{
-				if (ReservationMember.PlayerId == PlayerId)
-				{
-					return true;
-				}
+				LoggedInPlayerIds.Add(PlayerState->GetUniqueId());
 			}
 		}
 	}
 
-	return false;
+	TArray<FUniqueNetIdRepl> PlayerIdsToRemove;
+	PlayerIdsToRemove.Reserve(PlayerIds.Num());
+
+	for (const FUniqueNetIdRepl& PlayerId : PlayerIds)
+	{
+		if (LoggedInPlayerIds.Contains(PlayerId))
+		{
+			// Player is logged in. No need to remove reservation. We'll also fix the reservation state.
+			if (FKronosReservationMember* ReservationMember = FindReservationMember(PlayerId))
+			{
+				ReservationMember->bIsCompleted = true;
+			}
+
+			continue;
+		}
+
+		// Player hasn't joined yet. Revoke his reservation.
+		UE_LOG(LogKronos, Log, TEXT("KronosReservationHost: Reservation timed out for %s"), *PlayerId.ToDebugString());
+		PlayerIdsToRemove.Add(PlayerId);
+	}
+
+	RemoveReservations(PlayerIdsToRemove);
+}
+
+bool AKronosReservationHost::PlayerHasReservation(const FUniqueNetIdRepl& PlayerId) const
+{
+	return PlayerId.IsValid() && ReservationMemberHandles.Contains(PlayerId);
 }
 
 bool AKronosReservationHost::FindReservation(const FUniqueNetIdRepl& PlayerId, FKronosReservationMember& OutPlayerReservation, FKronosReservation& OutOwningReservation)
+{
+	FKronosReservation* OwningReservation = nullptr;
+	FKronosReservationMember* PlayerReservation = FindReservationMember(PlayerId, &OwningReservation);
+	if (PlayerReservation)
+	{
+		OutPlayerReservation = *PlayerReservation;
+		OutOwningReservation = *OwningReservation;
+
+		return true;
+	}
+
+	return false;
+}
+
+FKronosReservationMember* AKronosReservationHost::FindReservationMember(const FUniqueNetIdRepl& PlayerId, FKronosReservation** OutOwningReservation)
 {
 	if (PlayerId.IsValid())
 	{
-		for (const FKronosReservation& ReservationEntry : Reservations)
+		const FKronosReservationMemberHandle* MemberHandle = ReservationMemberHandles.Find(PlayerId);
+		if (MemberHandle)
 		{
-			for (const FKronosReservationMember& ReservationMember : ReservationEntry.ReservationMembers)
+			FKronosReservation& ReservationEntry = Reservations[MemberHandle->ReservationIdx];
+			if (OutOwningReservation)
 			{
-				if (ReservationMember.PlayerId == PlayerId)
-				{
-					OutPlayerReservation = ReservationMember;
-					OutOwningReservation = ReservationEntry;
-
-					return true;
-				}
+				*OutOwningReservation = &ReservationEntry;
 			}
+
+			return &ReservationEntry.ReservationMembers[MemberHandle->MemberIdx];
 		}
 	}
 
-	return false;
+	return nullptr;
 }
 
 void AKronosReservationHost::DumpReservations() const
 {
 	UE_LOG(LogKronos, Log, TEXT("KronosReservationHost: Dumping reservations..."));
 
-	for (int32 ResIdx = 0; ResIdx < Reservations.Num(); ResIdx++)
+	int32 ResIdx = 0;
+	for (const FKronosReservation& ReservationEntry : Reservations)
 	{
-		const FKronosReservation& ReservationEntry = Reservations[ResIdx];
-		UE_LOG(LogKronos, Log, TEXT("[%d] Owner: %s with %d members"), 1 + ResIdx, *ReservationEntry.ReservationOwner.ToDebugString(), ReservationEntry.ReservationMembers.Num());
+		UE_LOG(LogKronos, Log, TEXT("[%d] Owner: %s with %d members"), ++ResIdx, *ReservationEntry.ReservationOwner.ToDebugString(), ReservationEntry.ReservationMembers.Num());
 
 		for (int32 PlayerIdx = 0; PlayerIdx < ReservationEntry.ReservationMembers.Num(); PlayerIdx++)
 		{
@@ -355,27 +578,30 @@ int32 AKronosReservationHost::GetNumReservations() const
 
 int32 AKronosReservationHost::GetNumConsumedReservations() const
 {
-	int32 OutNumConsumedReservations = 0;
-	for (int32 ResIdx = 0; ResIdx < Reservations.Num(); ResIdx++)
+	return NumConsumedReservations;
+}
+
+TArray<FKronosReservation> AKronosReservationHost::GetReservations() const
+{
+	TArray<FKronosReservation> OutReservations;
+	OutReservations.Reserve(Reservations.Num());
+
+	for (const FKronosReservation& ReservationEntry : Reservations)
 	{
-		const FKronosReservation& ReservationEntry = Reservations[ResIdx];
-		OutNumConsumedReservations += ReservationEntry.ReservationMembers.Num();
+		OutReservations.Add(ReservationEntry);
 	}
 
-	return OutNumConsumedReservations;
+	return OutReservations;
 }
 
 void AKronosReservationHost::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Make sure that all reservation timeouts have been cleared before the reservation host is destroyed.
-	for (FKronosReservation& ReservationEntry : Reservations)
-	{
-		for (FKronosReservationMember& ReservationMember : ReservationEntry.ReservationMembers)
-		{
-			FTimerHandle& TimeoutHandle = ReservationMember.TimerHandle_ReservationTimeout;
-			GetWorld()->GetTimerManager().ClearTimer(TimeoutHandle);
-		}
-	}
+	// Make sure that the reservation timeouts have been cleared before the reservation host is destroyed.
+	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ReservationTimeouts);
+	ReservationTimeouts.Empty();
+
+	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_ReservationQueue);
+	ReservationQueue.Empty();
 
 	Super::EndPlay(EndPlayReason);
 }
@@ -6,6 +6,10 @@
 #include "KronosMatchmakingManager.h"
 #include "KronosPartyManager.h"
 #include "KronosReservationManager.h"
+#include "KronosSearchFilter.h"
+#include "KronosPing.h"
+#include "KronosMatchmakingTrace.h"
+#include "KronosMatchmakingSimulator.h"
 #include "Lobby/KronosLobbyGameMode.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
@@ -48,6 +52,13 @@ void FKronosModule::StartupModule()
 		ECVF_Default
 	));
 
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("kronos.DumpMatchmakingLatency"),
+		TEXT("Dump the p50/p95/p99 latency of each matchmaking stage to the console. Pass 'reset' to clear the recorded latencies afterwards."),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FKronosModule::DumpMatchmakingLatency),
+		ECVF_Default
+	));
+
 	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
 		TEXT("kronos.DumpPartyState"),
 		TEXT("Dump party state to the console."),
@@ -75,6 +86,27 @@ void FKronosModule::StartupModule()
 		FConsoleCommandWithWorldDelegate::CreateRaw(this, &FKronosModule::LobbyStartMatch),
 		ECVF_Cheat
 	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("kronos.BenchmarkSearchFilter"),
+		TEXT("Benchmark the search result filter with synthetic search results. <NumResults: int32 = 10000>"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FKronosModule::BenchmarkSearchFilter),
+		ECVF_Cheat
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("kronos.PingLoopback"),
+		TEXT("Ping a loopback ping responder and log the measured round trip times. <NumTargets: int32 = 8> <NumProbesPerTarget: int32 = 3>"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FKronosModule::PingLoopback),
+		ECVF_Cheat
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("kronos.SimulateMatchmaking"),
+		TEXT("Simulate matchmaking clients against an in-memory session population and log time-to-match and reservation stats. <NumClients: int32 = 1000> <MaxParallelReservationRequests: int32 = config> <EloRangeBeforeHosting: int32 = 300>"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FKronosModule::SimulateMatchmaking),
+		ECVF_Cheat
+	));
 }
 
 void FKronosModule::ShutdownModule()
@@ -144,6 +176,17 @@ void FKronosModule::DumpMatchmakingState(UWorld* World) const
 	}
 }
 
+void FKronosModule::DumpMatchmakingLatency(const TArray<FString>& Args) const
+{
+	KronosMatchmakingTrace::DumpLatencyStats();
+
+	if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+	{
+		KronosMatchmakingTrace::ResetLatencyStats();
+		UE_LOG(LogKronos, Log, TEXT("Matchmaking latency reset."));
+	}
+}
+
 void FKronosModule::DumpPartyState(UWorld* World) const
 {
 	if (World)
@@ -208,6 +251,67 @@ void FKronosModule::LobbyStartMatch(UWorld* World) const
 	}
 }
 
+void FKronosModule::BenchmarkSearchFilter(const TArray<FString>& Args) const
+{
+#if !UE_BUILD_SHIPPING
+	int32 NumResults = 10000;
+	if (Args.Num() != 0)
+	{
+		NumResults = FMath::Max(FCString::Atoi(*Args[0]), 1);
+	}
+
+	FKronosSearchFilter::RunBenchmark(NumResults);
+#else
+	UE_LOG(LogKronos, Warning, TEXT("Search filter benchmark is not available in shipping builds."));
+#endif
+}
+
+void FKronosModule::PingLoopback(const TArray<FString>& Args) const
+{
+#if !UE_BUILD_SHIPPING
+	int32 NumTargets = 8;
+	if (Args.Num() > 0)
+	{
+		NumTargets = FMath::Max(FCString::Atoi(*Args[0]), 1);
+	}
+
+	int32 NumProbesPerTarget = 3;
+	if (Args.Num() > 1)
+	{
+		NumProbesPerTarget = FMath::Max(FCString::Atoi(*Args[1]), 1);
+	}
+
+	KronosPing::RunLoopbackTest(NumTargets, NumProbesPerTarget);
+#else
+	UE_LOG(LogKronos, Warning, TEXT("Ping loopback test is not available in shipping builds."));
+#endif
+}
+
+void FKronosModule::SimulateMatchmaking(const TArray<FString>& Args) const
+{
+#if !UE_BUILD_SHIPPING
+	FKronosMatchmakingSimulationParams Params = FKronosMatchmakingSimulationParams();
+	if (Args.Num() > 0)
+	{
+		Params.NumClients = FMath::Max(FCString::Atoi(*Args[0]), 1);
+	}
+
+	if (Args.Num() > 1)
+	{
+		Params.MaxParallelReservationRequests = FMath::Max(FCString::Atoi(*Args[1]), 1);
+	}
+
+	if (Args.Num() > 2)
+	{
+		Params.EloRangeBeforeHosting = FMath::Max(FCString::Atoi(*Args[2]), 0);
+	}
+
+	KronosMatchmakingSimulator::RunAndLog(Params);
+#else
+	UE_LOG(LogKronos, Warning, TEXT("Matchmaking simulation is not available in shipping builds."));
+#endif
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FKronosModule, Kronos)
\ No newline at end of file
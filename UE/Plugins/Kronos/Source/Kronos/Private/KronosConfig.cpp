@@ -39,22 +39,47 @@ UKronosConfig::UKronosConfig(const FObjectInitializer& ObjectInitializer) : Supe
 	MinTimePerAuthTask = 0.33f;
 	EnterGameDelayAfterAuth = 0.0f;
 	GameDefaultMapOverride = FSoftObjectPath();
+	bSaveFriendsListSnapshot = false;
 
 	bFindFriendSessionSupported = true;
 	bFindSessionByIdSupported = false;
 	RestartMatchmakingPassDelay = 2.0f;
 	RestartSearchPassDelay = 1.0f;
 	SearchTimeout = 20.0f;
+	SearchResultCacheLifetime = 15.0f;
+	SearchResultCacheMaxResultsScale = 4.0f;
+	bPingSearchResults = true;
+	PingTimeBudget = 1.0f;
+	PingProbesPerSession = 3;
+	MaxSessionsToPing = 32;
+	PingPortOffset = 1;
+	SessionScoreEloWeight = 1.0f;
+	SessionScoreOpenSlotsWeight = 0.5f;
+	SessionScorePingWeight = 1.0f;
+	SessionScoreFillRateWeight = 0.5f;
+	SessionScoreMaxPing = 250.0f;
+	MaxParallelReservationRequests = 3;
+	bAdaptiveEloWidening = false;
+	AdaptiveEloTargetSessions = 8;
+	AdaptiveEloMinStepScale = 0.5f;
+	AdaptiveEloMaxStepScale = 4.0f;
+	AdaptiveHostingWaitThreshold = 0.0f;
 
 	ClientFollowPartyToSessionDelay = 4.0f;
 	ClientFollowPartyAttempts = 5;
 	ClientReconnectPartyDelay = 1.0f;
 	ClientReconnectPartyAttempts = 5;
+	PartyChatMessagesPerSecond = 1.0f;
+	PartyChatBurstSize = 5;
+	PartyChatMaxMessageLength = 256;
+	PartyChatHistorySize = 32;
 
 	ServerTravelToSessionDelay = 1.0f;
 	ClientTravelToSessionDelay = 1.0f;
 
 	ReservationTimeout = 60.0f;
+	ReservationAdmissionWindow = 0.1f;
+	ReservationQueueTimeout = 3.0f;
 }
 
 const UKronosConfig* UKronosConfig::Get()
@@ -2,6 +2,7 @@
 
 #include "KronosMatchmakingPolicy.h"
 #include "KronosMatchmakingSearchPass.h"
+#include "KronosMatchmakingRules.h"
 #include "KronosOnlineSession.h"
 #include "KronosPartyManager.h"
 #include "KronosStatics.h"
@@ -87,9 +88,16 @@ void UKronosMatchmakingPolicy::StartMatchmaking(const FName InSessionName, const
 	bWasStarted = true;
 	bMatchmakingInProgress = true;
 
+	Timeline.BeginStage(EKronosMatchmakingStage::Matchmaking);
+
 	MatchmakingTime = 0;
 	CurrentMatchmakingPassIdx = 1;
 
+	EloRangeSchedule.Reset();
+	EstimatedSessionDensity = 0.0f;
+	AverageMatchmakingPassDuration = 0.0f;
+	CurrentPassRestartDelay = 0.0f;
+
 	FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this]()
 	{
 		MatchmakingTime++;
@@ -167,6 +175,18 @@ void UKronosMatchmakingPolicy::CancelMatchmaking()
 		CleanupExistingReservations();
 	}
 
+	if (NumPendingParallelReservations > 0)
+	{
+		// Parallel reservation requests are canceled in the background. The responses are no longer relevant to the matchmaking flow.
+		for (AKronosReservationClient* ReservationClient : TArray<AKronosReservationClient*>(ParallelReservationClients))
+		{
+			ReleaseParallelReservationClient(ReservationClient, true);
+		}
+
+		NumPendingParallelReservations = 0;
+		MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+	}
+
 	SignalCancelMatchmakingCompleteChecked();
 }
 
@@ -184,6 +204,19 @@ void UKronosMatchmakingPolicy::Invalidate()
 		ReservationBeaconClient = nullptr;
 	}
 
+	for (AKronosReservationClient* ReservationClient : ParallelReservationClients)
+	{
+		if (ReservationClient)
+		{
+			ReservationClient->DestroyBeacon();
+		}
+	}
+
+	ParallelReservationClients.Empty();
+	NumPendingParallelReservations = 0;
+
+	Timeline.Reset();
+
 	OnKronosMatchmakingComplete().Clear();
 	OnCancelKronosMatchmakingComplete().Clear();
 	OnKronosMatchmakingStateChanged().Clear();
@@ -263,18 +296,50 @@ void UKronosMatchmakingPolicy::HandleStartingJoinOnlyMatchmaking()
 }
 
 void UKronosMatchmakingPolicy::StartSearchPass()
+{
+	MatchmakingPassStartTime = FPlatformTime::Seconds();
+
+	FKronosSearchParams SearchParams = GetSearchParamsFor(CurrentMatchmakingPassIdx);
+	SearchPass->StartSearch(SessionName, SearchParams, GetQueryEloRangeFor(CurrentMatchmakingPassIdx));
+}
+
+FKronosSearchParams UKronosMatchmakingPolicy::GetSearchParamsFor(int32 MatchmakingPassIdx)
 {
 	FKronosSearchParams SearchParams = FKronosSearchParams(MatchmakingParams, MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::SkipEloChecks));
-	SearchParams.EloRange = GetEloSearchRangeFor(CurrentMatchmakingPassIdx);
+	SearchParams.EloRange = GetEloSearchRangeFor(MatchmakingPassIdx);
 
-	SearchPass->StartSearch(SessionName, SearchParams);
+	return SearchParams;
+}
+
+int32 UKronosMatchmakingPolicy::GetQueryEloRangeFor(int32 MatchmakingPassIdx)
+{
+	int32 QueryEloRange = GetEloSearchRangeFor(MatchmakingPassIdx);
+
+	// Only full matchmaking has further passes that could reuse the search results.
+	if (MatchmakingMode != EKronosMatchmakingMode::Default || GetDefault<UKronosConfig>()->SearchResultCacheLifetime <= 0.0f)
+	{
+		return QueryEloRange;
+	}
+
+	const bool bCanHost = !(MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::NoHost));
+	return KronosMatchmakingRules::GetCachedQueryEloRange(MatchmakingParams, MatchmakingPassIdx, QueryEloRange, GetEloSearchRangeFor(MatchmakingParams.MaxSearchAttempts), bCanHost);
 }
 
 int32 UKronosMatchmakingPolicy::GetEloSearchRangeFor(int32 MatchmakingPassIdx)
 {
-	// Take the base EloRange and add EloSearchStep amount to it for each new matchmaking pass.
-	// We only want to increase the base EloRange if we are not in the first pass (MatchmakingPassIdx - 1).
-	return MatchmakingParams.EloRange + MatchmakingParams.EloSearchStep * (MatchmakingPassIdx - 1);
+	return KronosMatchmakingRules::GetEloSearchRangeFor(MatchmakingParams, EloRangeSchedule, MatchmakingPassIdx);
+}
+
+void UKronosMatchmakingPolicy::UpdateEloRangeSchedule(const int32 NumSessionsFound)
+{
+	const int32 NextEloRange = KronosMatchmakingRules::UpdateEloRangeSchedule(MatchmakingParams, EloRangeSchedule, EstimatedSessionDensity, CurrentMatchmakingPassIdx, NumSessionsFound);
+
+	UE_LOG(LogKronos, Verbose, TEXT("Adaptive elo widening: %d sessions found in range %d. Next range: %d"), NumSessionsFound, EloRangeSchedule[CurrentMatchmakingPassIdx - 1], NextEloRange);
+}
+
+float UKronosMatchmakingPolicy::GetEstimatedWaitTime()
+{
+	return KronosMatchmakingRules::GetEstimatedWaitTime(MatchmakingParams, EstimatedSessionDensity, AverageMatchmakingPassDuration, GetEloSearchRangeFor(CurrentMatchmakingPassIdx + 1));
 }
 
 void UKronosMatchmakingPolicy::OnSearchPassComplete(const FName InSessionName, const EKronosSearchPassCompleteResult Result)
@@ -288,6 +353,13 @@ void UKronosMatchmakingPolicy::OnSearchPassComplete(const FName InSessionName, c
 		return;
 	}
 
+	// Let the number of sessions found decide how much the elo range should be widened for the next pass.
+	if (MatchmakingMode == EKronosMatchmakingMode::Default && GetDefault<UKronosConfig>()->bAdaptiveEloWidening)
+	{
+		const int32 NumSessionsFound = Result == EKronosSearchPassCompleteResult::Success ? SearchPass->GetSearchResults().Num() : 0;
+		UpdateEloRangeSchedule(NumSessionsFound);
+	}
+
 	// Search only matchmaking.
 	if (MatchmakingMode == EKronosMatchmakingMode::SearchOnly)
 	{
@@ -340,18 +412,44 @@ void UKronosMatchmakingPolicy::ContinueTestingSearchResults()
 
 	CurrentSessionIdx++;
 
-	FKronosSearchResult SearchResult = FKronosSearchResult();
-	if (SearchPass && SearchPass->GetSearchResult(CurrentSessionIdx, SearchResult))
+	auto SessionRequiresReservation = [this](const FKronosSearchResult& InSession) -> bool
 	{
 		int32 bSessionRequiresReservation = 0;
-		SearchResult.GetSessionSetting(SETTING_USERESERVATIONS, bSessionRequiresReservation);
+		InSession.GetSessionSetting(SETTING_USERESERVATIONS, bSessionRequiresReservation);
 
-		if (bSessionRequiresReservation == 0 || MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::SkipReservation))
+		return bSessionRequiresReservation != 0 && !(MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::SkipReservation));
+	};
+
+	FKronosSearchResult SearchResult = FKronosSearchResult();
+	if (SearchPass && SearchPass->GetSearchResult(CurrentSessionIdx, SearchResult))
+	{
+		if (!SessionRequiresReservation(SearchResult))
 		{
 			JoinOnlineSession(SearchResult);
 			return;
 		}
 
+		// Gather the following search results that also require a reservation, so that they can be requested at the same time.
+		const int32 MaxParallelReservationRequests = GetDefault<UKronosConfig>()->MaxParallelReservationRequests;
+		if (MaxParallelReservationRequests > 1)
+		{
+			TArray<FKronosSearchResult> SessionsToReserve;
+			SessionsToReserve.Add(SearchResult);
+
+			FKronosSearchResult NextSearchResult = FKronosSearchResult();
+			while (SessionsToReserve.Num() < MaxParallelReservationRequests && SearchPass->GetSearchResult(CurrentSessionIdx + 1, NextSearchResult) && SessionRequiresReservation(NextSearchResult))
+			{
+				SessionsToReserve.Add(NextSearchResult);
+				CurrentSessionIdx++;
+			}
+
+			if (SessionsToReserve.Num() > 1)
+			{
+				RequestParallelReservations(SessionsToReserve);
+				return;
+			}
+		}
+
 		RequestReservation(SearchResult);
 		return;
 	}
@@ -373,54 +471,69 @@ void UKronosMatchmakingPolicy::RestartMatchmaking()
 
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("Matchmaking pass exhausted all options. Restarting..."));
 
-	// Check if we have search attempts left.
-	if (CurrentMatchmakingPassIdx < MatchmakingParams.MaxSearchAttempts)
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+	// Keep track of how long a matchmaking pass takes, so that we can estimate the wait time.
+	const float MatchmakingPassDuration = static_cast<float>(FPlatformTime::Seconds() - MatchmakingPassStartTime) + CurrentPassRestartDelay;
+	AverageMatchmakingPassDuration = KronosMatchmakingRules::UpdateAverageMatchmakingPassDuration(AverageMatchmakingPassDuration, MatchmakingPassDuration);
+
+	const bool bCanHost = !(MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::NoHost));
+	const int32 NextEloRange = GetEloSearchRangeFor(CurrentMatchmakingPassIdx + 1);
+	const float EstimatedWaitTime = GetEstimatedWaitTime();
+
+	switch (KronosMatchmakingRules::GetRestartDecision(MatchmakingParams, CurrentMatchmakingPassIdx, NextEloRange, EstimatedWaitTime, bCanHost))
 	{
-		// Switch over to hosting role if needed.
-		if (!(MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::NoHost)))
-		{
-			int32 NextEloRange = GetEloSearchRangeFor(CurrentMatchmakingPassIdx + 1);
-			if (NextEloRange >= MatchmakingParams.EloRangeBeforeHosting)
-			{
-				UE_LOG(LogKronos, Log, TEXT("Elo range limit reached. Switching over to hosting role..."));
+	case EKronosMatchmakingRestartDecision::HostEloRangeLimitReached:
+		UE_LOG(LogKronos, Log, TEXT("Elo range limit reached. Switching over to hosting role..."));
 
-				CurrentMatchmakingPassIdx++;
+		CurrentMatchmakingPassIdx++;
 
-				CreateOnlineSession();
-				return;
-			}
-		}
+		CreateOnlineSession();
+		return;
+	case EKronosMatchmakingRestartDecision::HostWaitTimeTooLong:
+		UE_LOG(LogKronos, Log, TEXT("Estimated wait time of %.1f seconds is too long. Switching over to hosting role..."), EstimatedWaitTime);
 
-		UE_LOG(LogKronos, Log, TEXT("Widening Elo range and preparing another search..."));
-		UE_LOG(LogKronos, Log, TEXT("Matchmaking attempt: %d/%d"), CurrentMatchmakingPassIdx + 1, MatchmakingParams.MaxSearchAttempts);
+		CurrentMatchmakingPassIdx++;
 
-		SetMatchmakingState(EKronosMatchmakingState::Searching);
+		CreateOnlineSession();
+		return;
+	case EKronosMatchmakingRestartDecision::HostSearchAttemptLimitReached:
+		UE_LOG(LogKronos, Log, TEXT("Search attempt limit reached."));
 
-		FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this]()
-		{
-			CurrentMatchmakingPassIdx++;
-			StartSearchPass();
-		});
+		CreateOnlineSession();
+		return;
+	case EKronosMatchmakingRestartDecision::NoResults:
+		UE_LOG(LogKronos, Log, TEXT("Search attempt limit reached."));
 
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_MatchmakingDelay, TimerDelegate, GetDefault<UKronosConfig>()->RestartMatchmakingPassDelay, false);
+		SignalMatchmakingComplete(EKronosMatchmakingState::Complete, EKronosMatchmakingCompleteResult::NoResults);
 		return;
+	case EKronosMatchmakingRestartDecision::NextPass:
+		break;
 	}
 
-	// Search attempt limit reached.
-	else
+	UE_LOG(LogKronos, Log, TEXT("Widening Elo range and preparing another search..."));
+	UE_LOG(LogKronos, Log, TEXT("Matchmaking attempt: %d/%d"), CurrentMatchmakingPassIdx + 1, MatchmakingParams.MaxSearchAttempts);
+
+	SetMatchmakingState(EKronosMatchmakingState::Searching);
+
+	FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this]()
 	{
-		UE_LOG(LogKronos, Log, TEXT("Search attempt limit reached."));
+		CurrentMatchmakingPassIdx++;
+		StartSearchPass();
+	});
 
-		// Switch over to hosting role if possible.
-		if (!(MatchmakingFlags & static_cast<uint8>(EKronosMatchmakingFlags::NoHost)))
-		{
-			CreateOnlineSession();
-			return;
-		}
+	// The delay is there to avoid flooding the online subsystem with queries. Not needed if the next pass can be answered from the cache.
+	if (SearchPass && SearchPass->HasCachedSearchResultsFor(GetSearchParamsFor(CurrentMatchmakingPassIdx + 1)))
+	{
+		UE_LOG(LogKronos, Log, TEXT("Next matchmaking pass can reuse cached search results. Skipping restart delay."));
 
-		SignalMatchmakingComplete(EKronosMatchmakingState::Complete, EKronosMatchmakingCompleteResult::NoResults);
+		CurrentPassRestartDelay = 0.0f;
+		TimerHandle_MatchmakingDelay = GetWorld()->GetTimerManager().SetTimerForNextTick(TimerDelegate);
 		return;
 	}
+
+	CurrentPassRestartDelay = KronosConfig->RestartMatchmakingPassDelay;
+	GetWorld()->GetTimerManager().SetTimer(TimerHandle_MatchmakingDelay, TimerDelegate, KronosConfig->RestartMatchmakingPassDelay, false);
 }
 
 void UKronosMatchmakingPolicy::SetMatchmakingState(const EKronosMatchmakingState InState)
@@ -456,6 +569,10 @@ void UKronosMatchmakingPolicy::SignalMatchmakingComplete(const EKronosMatchmakin
 
 	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_MatchmakingTimer);
 
+	const bool bMatchFound = Result == EKronosMatchmakingCompleteResult::SessionJoined || Result == EKronosMatchmakingCompleteResult::SessionCreated;
+	Timeline.EndStage(EKronosMatchmakingStage::Matchmaking, bMatchFound);
+	Timeline.Reset();
+
 	MatchmakingResult = Result;
 	if (Result == EKronosMatchmakingCompleteResult::Failure)
 	{
@@ -477,6 +594,9 @@ void UKronosMatchmakingPolicy::SignalCancelMatchmakingComplete()
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("Matchmaking canceled."));
 	bMatchmakingInProgress = false;
 
+	// Canceled stages would only skew the latency stats.
+	Timeline.Reset();
+
 	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_MatchmakingTimer);
 
 	SetMatchmakingState(EKronosMatchmakingState::Canceled);
@@ -538,6 +658,7 @@ bool UKronosMatchmakingPolicy::CreateOnlineSession()
 			UE_CLOG(MatchmakingParams.HostParams.HasSessionSettingsOverride(), LogKronos, Log, TEXT("Override session settings detected. Session will be created using custom settings."));
 
 			MatchmakingAsyncStateFlags |= static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::CreatingSession);
+			Timeline.BeginStage(EKronosMatchmakingStage::CreateSession);
 
 			FOnlineSessionSettings SessionSettings = InitOnlineSessionSettings();
 
@@ -724,6 +845,7 @@ void UKronosMatchmakingPolicy::OnCreateSessionComplete(FName InSessionName, bool
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("OnCreateSessionComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
 	MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::CreatingSession);
+	Timeline.EndStage(EKronosMatchmakingStage::CreateSession, bWasSuccessful);
 
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
@@ -777,6 +899,7 @@ bool UKronosMatchmakingPolicy::RequestReservation(const FKronosSearchResult& InS
 	if (ReservationBeaconClient)
 	{
 		MatchmakingAsyncStateFlags |= static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+		Timeline.BeginStage(EKronosMatchmakingStage::Reservation);
 
 		FKronosReservation PartyReservation = UKronosStatics::MakeReservationForParty(this);
 		FOnKronosReservationRequestComplete CompletionDelegate = FOnKronosReservationRequestComplete::CreateUObject(this, &ThisClass::OnRequestReservationComplete);
@@ -793,6 +916,7 @@ void UKronosMatchmakingPolicy::OnRequestReservationComplete(const FKronosSearchR
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("OnRequestReservationComplete with result: %s"), LexToString(Result));
 
 	MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+	Timeline.EndStage(EKronosMatchmakingStage::Reservation, Result == EKronosReservationCompleteResult::ReservationAccepted);
 
 	if (Result == EKronosReservationCompleteResult::ReservationAccepted)
 	{
@@ -810,6 +934,137 @@ void UKronosMatchmakingPolicy::OnRequestReservationComplete(const FKronosSearchR
 	}
 }
 
+bool UKronosMatchmakingPolicy::RequestParallelReservations(const TArray<FKronosSearchResult>& InSessions)
+{
+	SetMatchmakingState(EKronosMatchmakingState::RequestingReservation);
+
+	// Make sure that we don't have an existing reservation.
+	if (ReservationBeaconClient)
+	{
+		FOnCleanupKronosMatchmakingComplete CompletionDelegate = FOnCleanupKronosMatchmakingComplete::CreateLambda([this, InSessions](bool bWasSuccessful)
+		{
+			RequestParallelReservations(InSessions);
+		});
+
+		CleanupExistingReservations(CompletionDelegate);
+		return true;
+	}
+
+	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("Requesting reservation with %d sessions..."), InSessions.Num());
+
+	// Spawn every client before sending the requests. A request may fail immediately, and we must not continue testing until all of them have responded.
+	TArray<AKronosReservationClient*> ReservationClients;
+	for (int32 Idx = 0; Idx < InSessions.Num(); Idx++)
+	{
+		AKronosReservationClient* ReservationClient = GetWorld()->SpawnActor<AKronosReservationClient>(GetReservationClientClass());
+		if (ReservationClient)
+		{
+			ParallelReservationClients.Add(ReservationClient);
+		}
+
+		ReservationClients.Add(ReservationClient);
+	}
+
+	NumPendingParallelReservations = InSessions.Num();
+	MatchmakingAsyncStateFlags |= static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+	Timeline.BeginStage(EKronosMatchmakingStage::Reservation);
+
+	FKronosReservation PartyReservation = UKronosStatics::MakeReservationForParty(this);
+
+	for (int32 Idx = 0; Idx < InSessions.Num(); Idx++)
+	{
+		if (ReservationClients[Idx])
+		{
+			FOnKronosReservationRequestComplete CompletionDelegate = FOnKronosReservationRequestComplete::CreateUObject(this, &ThisClass::OnParallelReservationComplete, ReservationClients[Idx]);
+			ReservationClients[Idx]->RequestReservation(InSessions[Idx], PartyReservation, CompletionDelegate);
+		}
+
+		else
+		{
+			OnParallelReservationComplete(InSessions[Idx], EKronosReservationCompleteResult::ConnectionError, nullptr);
+		}
+	}
+
+	return true;
+}
+
+void UKronosMatchmakingPolicy::OnParallelReservationComplete(const FKronosSearchResult& SearchResult, const EKronosReservationCompleteResult Result, AKronosReservationClient* ReservationClient)
+{
+	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("OnParallelReservationComplete with result: %s"), LexToString(Result));
+
+	if (NumPendingParallelReservations <= 0)
+	{
+		// Another session already accepted our reservation, or the matchmaking was canceled.
+		return;
+	}
+
+	if (Result == EKronosReservationCompleteResult::ReservationAccepted && SearchResult.IsValid())
+	{
+		NumPendingParallelReservations = 0;
+		MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+		Timeline.EndStage(EKronosMatchmakingStage::Reservation, true);
+
+		// The accepting client becomes our regular reservation client, so the rest of the matchmaking flow can clean it up as usual.
+		ParallelReservationClients.Remove(ReservationClient);
+		ReservationBeaconClient = ReservationClient;
+
+		// Cancel the reservation requests with the other sessions.
+		for (AKronosReservationClient* OtherReservationClient : TArray<AKronosReservationClient*>(ParallelReservationClients))
+		{
+			ReleaseParallelReservationClient(OtherReservationClient, true);
+		}
+
+		JoinOnlineSession(SearchResult);
+		return;
+	}
+
+	if (ReservationClient)
+	{
+		ReleaseParallelReservationClient(ReservationClient, false);
+	}
+
+	NumPendingParallelReservations--;
+	if (NumPendingParallelReservations == 0)
+	{
+		MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::RequestingReservation);
+		Timeline.EndStage(EKronosMatchmakingStage::Reservation, false);
+
+		ContinueTestingSearchResults();
+	}
+}
+
+void UKronosMatchmakingPolicy::ReleaseParallelReservationClient(AKronosReservationClient* ReservationClient, const bool bCancelReservation)
+{
+	TWeakObjectPtr<AKronosReservationClient> WeakReservationClient = ReservationClient;
+
+	// The delegate that will trigger after the one-frame delay. At this point, it will be safe to destroy the beacon.
+	FTimerDelegate DestroyTimerDelegate = FTimerDelegate::CreateLambda([this, WeakReservationClient]()
+	{
+		if (WeakReservationClient.IsValid())
+		{
+			ParallelReservationClients.Remove(WeakReservationClient.Get());
+			WeakReservationClient->DestroyBeacon();
+		}
+	});
+
+	if (bCancelReservation)
+	{
+		// Delegate that will trigger once the reservation has been canceled. Destroying the beacon any sooner could drop the cancel request.
+		FOnCancelKronosReservationComplete CancelReservationCompletionDelegate = FOnCancelKronosReservationComplete::CreateLambda([this, DestroyTimerDelegate](bool bWasSuccessful)
+		{
+			GetWorld()->GetTimerManager().SetTimerForNextTick(DestroyTimerDelegate);
+		});
+
+		if (ReservationClient->CancelReservation(CancelReservationCompletionDelegate))
+		{
+			return;
+		}
+	}
+
+	// Additional one-frame delay, because we can't destroy the beacon while it is executing its delegate.
+	GetWorld()->GetTimerManager().SetTimerForNextTick(DestroyTimerDelegate);
+}
+
 bool UKronosMatchmakingPolicy::JoinOnlineSession(const FKronosSearchResult& InSession)
 {
 	SetMatchmakingState(EKronosMatchmakingState::JoiningSession);
@@ -858,6 +1113,7 @@ bool UKronosMatchmakingPolicy::JoinOnlineSession(const FKronosSearchResult& InSe
 			}
 
 			MatchmakingAsyncStateFlags |= static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::JoiningSession);
+			Timeline.BeginStage(EKronosMatchmakingStage::Join);
 
 			SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(OnJoinSessionCompleteDelegateHandle);
 			OnJoinSessionCompleteDelegateHandle = SessionInterface->AddOnJoinSessionCompleteDelegate_Handle(OnJoinSessionCompleteDelegate);
@@ -875,6 +1131,7 @@ void UKronosMatchmakingPolicy::OnJoinSessionComplete(FName InSessionName, EOnJoi
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("OnJoinSessionComplete with result: %s"), LexToString(Result));
 
 	MatchmakingAsyncStateFlags &= ~static_cast<uint8>(EKronosMatchmakingAsyncStateFlags::JoiningSession);
+	Timeline.EndStage(EKronosMatchmakingStage::Join, Result == EOnJoinSessionCompleteResult::Success);
 
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
@@ -1121,6 +1378,9 @@ void UKronosMatchmakingPolicy::DumpMatchmakingState() const
 	UE_LOG(LogKronos, Log, TEXT("  MatchmakingState: %s"), LexToString(MatchmakingState));
 	UE_LOG(LogKronos, Log, TEXT("  MatchmakingTime: %d"), MatchmakingTime);
 	UE_LOG(LogKronos, Log, TEXT("  CurrentMatchmakingPassIdx: %d"), CurrentMatchmakingPassIdx);
+	UE_LOG(LogKronos, Log, TEXT("  NumPendingParallelReservations: %d"), NumPendingParallelReservations);
+	UE_LOG(LogKronos, Log, TEXT("  EstimatedSessionDensity: %f"), EstimatedSessionDensity);
+	UE_LOG(LogKronos, Log, TEXT("  AverageMatchmakingPassDuration: %.2f"), AverageMatchmakingPassDuration);
 	UE_LOG(LogKronos, Log, TEXT("  MatchmakingAsyncStateFlags: %s"), *ActiveFlags);
 }
 
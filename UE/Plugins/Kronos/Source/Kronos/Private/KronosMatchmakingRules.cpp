@@ -0,0 +1,239 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#include "KronosMatchmakingRules.h"
+#include "KronosConfig.h"
+
+namespace KronosMatchmakingRules
+{
+	int32 GetEloSearchRangeFor(const FKronosMatchmakingParams& Params, const TArray<int32>& EloRangeSchedule, const int32 MatchmakingPassIdx)
+	{
+		// Use the range decided by the adaptive widening if there is one.
+		// Passes that haven't been decided yet widen linearly from the last decided range.
+		if (EloRangeSchedule.Num() > 0)
+		{
+			const int32 ScheduleIdx = MatchmakingPassIdx - 1;
+			if (EloRangeSchedule.IsValidIndex(ScheduleIdx))
+			{
+				return EloRangeSchedule[ScheduleIdx];
+			}
+
+			if (ScheduleIdx >= EloRangeSchedule.Num())
+			{
+				return EloRangeSchedule.Last() + Params.EloSearchStep * (ScheduleIdx - (EloRangeSchedule.Num() - 1));
+			}
+		}
+
+		// Take the base EloRange and add EloSearchStep amount to it for each new matchmaking pass.
+		// We only want to increase the base EloRange if we are not in the first pass (MatchmakingPassIdx - 1).
+		return Params.EloRange + Params.EloSearchStep * (MatchmakingPassIdx - 1);
+	}
+
+	int32 GetCachedQueryEloRange(const FKronosMatchmakingParams& Params, const int32 MatchmakingPassIdx, const int32 EloRange, const int32 LastPassEloRange, const bool bCanHost)
+	{
+		const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+		// Query the widest elo range that any remaining pass will search with.
+		int32 WidestEloRange = LastPassEloRange;
+
+		// With adaptive widening the ranges of the remaining passes aren't decided yet. Each of them may widen by up to the max step scale.
+		if (KronosConfig->bAdaptiveEloWidening)
+		{
+			const int32 NumRemainingPasses = FMath::Max(Params.MaxSearchAttempts - MatchmakingPassIdx, 0);
+			const float MaxEloStep = Params.EloSearchStep * KronosConfig->AdaptiveEloMaxStepScale;
+			WidestEloRange = EloRange + FMath::RoundToInt(MaxEloStep * NumRemainingPasses);
+		}
+
+		if (bCanHost)
+		{
+			// Passes that would reach this range switch over to hosting instead.
+			WidestEloRange = FMath::Min(WidestEloRange, Params.EloRangeBeforeHosting - 1);
+		}
+
+		return FMath::Max(EloRange, WidestEloRange);
+	}
+
+	int32 GetQueryMaxSearchResults(const int32 MaxSearchResults, const int32 EloRange, const int32 QueryEloRange, const bool bSkipEloChecks)
+	{
+		if (QueryEloRange <= EloRange || bSkipEloChecks)
+		{
+			return MaxSearchResults;
+		}
+
+		// A wider query spreads the same number of results over a wider elo range, so scale the limit with it.
+		// Otherwise the sessions within the range of the current pass could be cut off by the ones only later passes are interested in.
+		const float MaxResultsScale = FMath::Max(GetDefault<UKronosConfig>()->SearchResultCacheMaxResultsScale, 1.0f);
+		const float ResultsScale = FMath::Min(static_cast<float>(QueryEloRange) / FMath::Max(EloRange, 1), MaxResultsScale);
+
+		return FMath::CeilToInt(MaxSearchResults * ResultsScale);
+	}
+
+	int32 UpdateEloRangeSchedule(const FKronosMatchmakingParams& Params, TArray<int32>& EloRangeSchedule, float& EstimatedSessionDensity, const int32 CurrentMatchmakingPassIdx, const int32 NumSessionsFound)
+	{
+		const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+		// Make sure that the ranges of the passes so far are recorded before deciding the next one.
+		while (EloRangeSchedule.Num() < CurrentMatchmakingPassIdx)
+		{
+			EloRangeSchedule.Add(GetEloSearchRangeFor(Params, EloRangeSchedule, EloRangeSchedule.Num() + 1));
+		}
+
+		// Forget ranges that were extrapolated beyond the current pass.
+		EloRangeSchedule.SetNum(CurrentMatchmakingPassIdx);
+
+		// Estimate how many sessions there are per elo point around our elo.
+		// A pass without any sessions is counted as half a session, so that the estimate stays positive and keeps dropping.
+		const int32 CurrentEloRange = FMath::Max(EloRangeSchedule.Last(), 1);
+		const float PassDensity = FMath::Max(static_cast<float>(NumSessionsFound), 0.5f) / (2.0f * CurrentEloRange);
+		EstimatedSessionDensity = EstimatedSessionDensity > 0.0f ? FMath::Lerp(EstimatedSessionDensity, PassDensity, 0.5f) : PassDensity;
+
+		// Widen towards the range that is expected to yield the target number of sessions, within the step scale limits.
+		const float DesiredEloRange = KronosConfig->AdaptiveEloTargetSessions / (2.0f * EstimatedSessionDensity);
+		const float StepScale = FMath::Clamp((DesiredEloRange - CurrentEloRange) / FMath::Max(Params.EloSearchStep, 1), KronosConfig->AdaptiveEloMinStepScale, KronosConfig->AdaptiveEloMaxStepScale);
+		const int32 NextEloRange = EloRangeSchedule.Last() + FMath::RoundToInt(Params.EloSearchStep * StepScale);
+
+		EloRangeSchedule.Add(NextEloRange);
+		return NextEloRange;
+	}
+
+	float GetEstimatedWaitTime(const FKronosMatchmakingParams& Params, const float EstimatedSessionDensity, const float AverageMatchmakingPassDuration, const int32 NextEloRange)
+	{
+		if (EstimatedSessionDensity <= 0.0f || AverageMatchmakingPassDuration <= 0.0f || Params.EloSearchStep <= 0)
+		{
+			return 0.0f;
+		}
+
+		const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+		const float DesiredEloRange = KronosConfig->AdaptiveEloTargetSessions / (2.0f * EstimatedSessionDensity);
+		if (DesiredEloRange <= NextEloRange)
+		{
+			return 0.0f;
+		}
+
+		// Even when widening at the fastest rate, this many more passes are needed to reach the desired range.
+		const float MaxEloStep = Params.EloSearchStep * KronosConfig->AdaptiveEloMaxStepScale;
+		const int32 NumPassesNeeded = FMath::CeilToInt((DesiredEloRange - NextEloRange) / MaxEloStep) + 1;
+
+		return NumPassesNeeded * AverageMatchmakingPassDuration;
+	}
+
+	float UpdateAverageMatchmakingPassDuration(const float AverageMatchmakingPassDuration, const float MatchmakingPassDuration)
+	{
+		return AverageMatchmakingPassDuration > 0.0f ? FMath::Lerp(AverageMatchmakingPassDuration, MatchmakingPassDuration, 0.5f) : MatchmakingPassDuration;
+	}
+
+	EKronosMatchmakingRestartDecision GetRestartDecision(const FKronosMatchmakingParams& Params, const int32 CurrentMatchmakingPassIdx, const int32 NextEloRange, const float EstimatedWaitTime, const bool bCanHost)
+	{
+		// Search attempt limit reached.
+		if (CurrentMatchmakingPassIdx >= Params.MaxSearchAttempts)
+		{
+			return bCanHost ? EKronosMatchmakingRestartDecision::HostSearchAttemptLimitReached : EKronosMatchmakingRestartDecision::NoResults;
+		}
+
+		if (bCanHost)
+		{
+			if (NextEloRange >= Params.EloRangeBeforeHosting)
+			{
+				return EKronosMatchmakingRestartDecision::HostEloRangeLimitReached;
+			}
+
+			// Don't keep searching if the population is so sparse that finding enough sessions would take too long.
+			const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+			if (KronosConfig->bAdaptiveEloWidening && KronosConfig->AdaptiveHostingWaitThreshold > 0.0f && EstimatedWaitTime > KronosConfig->AdaptiveHostingWaitThreshold)
+			{
+				return EKronosMatchmakingRestartDecision::HostWaitTimeTooLong;
+			}
+		}
+
+		return EKronosMatchmakingRestartDecision::NextPass;
+	}
+
+	float GetEloScore(const float EloDistance, const int32 EloRange)
+	{
+		return 1.0f - FMath::Clamp(EloDistance / FMath::Max(EloRange, 1), 0.0f, 1.0f);
+	}
+
+	float GetOpenSlotsScore(const int32 NumOpenSlots, const int32 PartySize)
+	{
+		const int32 ClampedPartySize = FMath::Max(PartySize, 1);
+		const int32 ExtraSlots = NumOpenSlots - ClampedPartySize;
+
+		return FMath::Clamp(static_cast<float>(ExtraSlots) / ClampedPartySize, 0.0f, 1.0f);
+	}
+
+	float GetPingScore(const int32 PingInMs)
+	{
+		if (PingInMs < 0 || PingInMs >= MAX_QUERY_PING)
+		{
+			return 0.0f;
+		}
+
+		const float MaxScoredPing = FMath::Max(GetDefault<UKronosConfig>()->SessionScoreMaxPing, 1.0f);
+		return 1.0f - FMath::Clamp(PingInMs / MaxScoredPing, 0.0f, 1.0f);
+	}
+
+	float GetFillRateScore(const int32 NumPlayers, const int32 MaxNumPlayers)
+	{
+		if (MaxNumPlayers <= 0)
+		{
+			return 0.0f;
+		}
+
+		return FMath::Clamp(static_cast<float>(NumPlayers) / MaxNumPlayers, 0.0f, 1.0f);
+	}
+
+	float GetSessionScore(const float EloScore, const float OpenSlotsScore, const float PingScore, const float FillRateScore)
+	{
+		const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+		float Score = 0.0f;
+		Score += KronosConfig->SessionScoreEloWeight * EloScore;
+		Score += KronosConfig->SessionScoreOpenSlotsWeight * OpenSlotsScore;
+		Score += KronosConfig->SessionScorePingWeight * PingScore;
+		Score += KronosConfig->SessionScoreFillRateWeight * FillRateScore;
+
+		return Score;
+	}
+
+	void PackReservationRequests(const TArray<int32>& RequestSizes, const int32 NumFreeSlots, TArray<int32>& OutAdmittedIndices)
+	{
+		OutAdmittedIndices.Reset();
+
+		const int32 NumRequests = RequestSizes.Num();
+		const int32 NumColumns = NumFreeSlots + 1;
+
+		// Subset sum over the free slots. CanFill[RequestIdx * NumColumns + NumSlots] tells whether
+		// the requests from RequestIdx onwards can fill exactly NumSlots slots.
+		TBitArray<> CanFill = TBitArray<>(false, (NumRequests + 1) * NumColumns);
+		CanFill[NumRequests * NumColumns] = true;
+
+		for (int32 RequestIdx = NumRequests - 1; RequestIdx >= 0; RequestIdx--)
+		{
+			const int32 RequestSize = RequestSizes[RequestIdx];
+			for (int32 NumSlots = 0; NumSlots < NumColumns; NumSlots++)
+			{
+				const bool bCanFillWithout = CanFill[(RequestIdx + 1) * NumColumns + NumSlots];
+				const bool bCanFillWith = RequestSize > 0 && RequestSize <= NumSlots && CanFill[(RequestIdx + 1) * NumColumns + NumSlots - RequestSize];
+				CanFill[RequestIdx * NumColumns + NumSlots] = bCanFillWithout || bCanFillWith;
+			}
+		}
+
+		// Find the most slots that can be filled.
+		int32 NumSlotsToFill = NumFreeSlots;
+		while (NumSlotsToFill > 0 && !CanFill[NumSlotsToFill])
+		{
+			NumSlotsToFill--;
+		}
+
+		// Take each request in arrival order if the remaining requests can still fill the rest of the slots.
+		for (int32 RequestIdx = 0; RequestIdx < NumRequests && NumSlotsToFill > 0; RequestIdx++)
+		{
+			const int32 RequestSize = RequestSizes[RequestIdx];
+			if (RequestSize > 0 && RequestSize <= NumSlotsToFill && CanFill[(RequestIdx + 1) * NumColumns + NumSlotsToFill - RequestSize])
+			{
+				OutAdmittedIndices.Add(RequestIdx);
+				NumSlotsToFill -= RequestSize;
+			}
+		}
+	}
+}
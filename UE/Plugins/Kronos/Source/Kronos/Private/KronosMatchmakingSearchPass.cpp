@@ -1,10 +1,13 @@
 // Copyright 2022-2023 Horizon Games. All Rights Reserved.
 
 #include "KronosMatchmakingSearchPass.h"
+#include "KronosMatchmakingRules.h"
 #include "KronosPartyManager.h"
 #include "Kronos.h"
 #include "KronosConfig.h"
 #include "OnlineSubsystem.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
 #include "TimerManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
@@ -20,7 +23,7 @@ UKronosMatchmakingSearchPass::UKronosMatchmakingSearchPass(const FObjectInitiali
 	}
 }
 
-bool UKronosMatchmakingSearchPass::StartSearch(const FName InSessionName, const FKronosSearchParams& InParams)
+bool UKronosMatchmakingSearchPass::StartSearch(const FName InSessionName, const FKronosSearchParams& InParams, const int32 InQueryEloRange)
 {
 	if (InSessionName != NAME_GameSession && InSessionName != NAME_PartySession)
 	{
@@ -43,6 +46,10 @@ bool UKronosMatchmakingSearchPass::StartSearch(const FName InSessionName, const
 
 	SessionName = InSessionName;
 	SearchParams = InParams;
+	QueryEloRange = FMath::Max(InParams.EloRange, InQueryEloRange);
+	QueryMaxSearchResults = KronosMatchmakingRules::GetQueryMaxSearchResults(InParams.MaxSearchResults, InParams.EloRange, QueryEloRange, InParams.bSkipEloChecks);
+
+	CompileSearchFilter();
 
 	if (UE_LOG_ACTIVE(LogKronos, Verbose))
 	{
@@ -80,6 +87,9 @@ bool UKronosMatchmakingSearchPass::CancelSearch()
 	bWasCanceled = true;
 	SearchState = EKronosSearchPassState::Canceling;
 
+	// Canceled stages would only skew the latency stats.
+	Timeline.Reset();
+
 	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SearchDelay);
 
 	if (AsyncStateFlags & static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions))
@@ -88,6 +98,13 @@ bool UKronosMatchmakingSearchPass::CancelSearch()
 		return true;
 	}
 
+	if (AsyncStateFlags & static_cast<uint8>(EKronosSearchPassAsyncStateFlags::PingingSessions))
+	{
+		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_PingTick);
+		OnPingSearchResultsComplete(false);
+		return true;
+	}
+
 	SignalCancelSearchPassCompleteChecked();
 	return true;
 }
@@ -108,6 +125,24 @@ bool UKronosMatchmakingSearchPass::GetSearchResult(const int32 InSessionIdx, FKr
 	return false;
 }
 
+bool UKronosMatchmakingSearchPass::HasCachedSearchResultsFor(const FKronosSearchParams& InParams) const
+{
+	const float CacheLifetime = GetDefault<UKronosConfig>()->SearchResultCacheLifetime;
+	if (CacheLifetime <= 0.0f || CachedSearchTime <= 0.0 || InParams.IsSpecificSessionQuery())
+	{
+		return false;
+	}
+
+	if (FPlatformTime::Seconds() - CachedSearchTime > CacheLifetime)
+	{
+		return false;
+	}
+
+	// Sessions outside of the queried elo range were never returned, so a wider range needs a new query.
+	const bool bEloRangeCovered = InParams.bSkipEloChecks || InParams.EloRange <= CachedQueryEloRange;
+	return bEloRangeCovered && MatchesCachedSearchParams(InParams);
+}
+
 void UKronosMatchmakingSearchPass::Invalidate()
 {
 	OnSearchPassComplete().Unbind();
@@ -126,6 +161,34 @@ void UKronosMatchmakingSearchPass::Invalidate()
 	}
 
 	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+
+	PingProbe.Reset();
+	PingTargetSessionIndices.Reset();
+	Timeline.Reset();
+
+	CachedSearchResults.Empty();
+	CachedSearchTime = 0.0;
+}
+
+void UKronosMatchmakingSearchPass::CompileSearchFilter()
+{
+	FUniqueNetIdPtr PrimaryPlayerId = GetWorld()->GetGameInstance()->GetPrimaryPlayerUniqueIdRepl().GetUniqueNetId();
+
+	// Sessions which we or any of our party members are banned from are filtered.
+	TArray<FUniqueNetIdRepl> PlayersToCheckForBans;
+
+	UKronosPartyManager* PartyManager = UKronosPartyManager::Get(this);
+	if (PartyManager->IsPartyLeader())
+	{
+		PlayersToCheckForBans = PartyManager->GetPartyPlayerUniqueIds();
+	}
+
+	else if (PrimaryPlayerId.IsValid())
+	{
+		PlayersToCheckForBans.Add(FUniqueNetIdRepl(PrimaryPlayerId));
+	}
+
+	SearchFilter.Compile(SessionName, SearchParams, PrimaryPlayerId, PlayersToCheckForBans);
 }
 
 void UKronosMatchmakingSearchPass::BeginSearchAttempt()
@@ -143,11 +206,72 @@ void UKronosMatchmakingSearchPass::BeginSearchAttempt()
 	case EKronosSpecificSessionQueryType::SessionOwnerId:
 		; // intentional fall through
 	default:
+		// Only the first attempt of a search pass may use the cache. Further attempts mean that the cached sessions weren't good enough.
+		if (CurrentAttemptIdx == 1 && HasCachedSearchResultsFor(SearchParams))
+		{
+			UE_LOG(LogKronos, Log, TEXT("Using cached search results for %s..."), *SessionName.ToString());
+
+			SearchState = EKronosSearchPassState::Searching;
+
+			// Complete in the next frame like a real search would, so that the caller never gets a completion from inside StartSearch.
+			// Canceling before then clears the timer.
+			FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this]()
+			{
+				OnSearchComplete(CachedSearchResults);
+			});
+
+			TimerHandle_SearchDelay = GetWorld()->GetTimerManager().SetTimerForNextTick(TimerDelegate);
+			break;
+		}
+
 		FindOnlineSessions();
 		break;
 	}
 }
 
+bool UKronosMatchmakingSearchPass::MatchesCachedSearchParams(const FKronosSearchParams& InParams) const
+{
+	if (SessionName != CachedSearchSessionName ||
+		InParams.Playlist != CachedSearchParams.Playlist ||
+		InParams.MapName != CachedSearchParams.MapName ||
+		InParams.GameMode != CachedSearchParams.GameMode ||
+		InParams.MaxSearchResults != CachedSearchParams.MaxSearchResults ||
+		InParams.MinSlotsRequired != CachedSearchParams.MinSlotsRequired ||
+		InParams.Elo != CachedSearchParams.Elo ||
+		InParams.bIsLanQuery != CachedSearchParams.bIsLanQuery ||
+		InParams.bSearchPresence != CachedSearchParams.bSearchPresence ||
+		InParams.bSkipEloChecks != CachedSearchParams.bSkipEloChecks)
+	{
+		return false;
+	}
+
+	if (InParams.ExtraQuerySettings.Num() != CachedSearchParams.ExtraQuerySettings.Num() || InParams.IgnoredSessions.Num() != CachedSearchParams.IgnoredSessions.Num())
+	{
+		return false;
+	}
+
+	for (int32 SettingIdx = 0; SettingIdx < InParams.ExtraQuerySettings.Num(); SettingIdx++)
+	{
+		const FKronosQuerySetting& Setting = InParams.ExtraQuerySettings[SettingIdx];
+		const FKronosQuerySetting& CachedSetting = CachedSearchParams.ExtraQuerySettings[SettingIdx];
+
+		if (Setting.Key != CachedSetting.Key || Setting.ComparisonOp != CachedSetting.ComparisonOp || Setting.Data != CachedSetting.Data)
+		{
+			return false;
+		}
+	}
+
+	for (int32 SessionIdx = 0; SessionIdx < InParams.IgnoredSessions.Num(); SessionIdx++)
+	{
+		if (InParams.IgnoredSessions[SessionIdx] != CachedSearchParams.IgnoredSessions[SessionIdx])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool UKronosMatchmakingSearchPass::FindOnlineSessions()
 {
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
@@ -160,6 +284,7 @@ bool UKronosMatchmakingSearchPass::FindOnlineSessions()
 
 			AsyncStateFlags |= static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
 			SearchState = EKronosSearchPassState::Searching;
+			Timeline.BeginStage(EKronosMatchmakingStage::Search);
 
 			InitOnlineSessionSearch();
 
@@ -177,7 +302,7 @@ bool UKronosMatchmakingSearchPass::FindOnlineSessions()
 void UKronosMatchmakingSearchPass::InitOnlineSessionSearch()
 {
 	SessionSearch = MakeShareable(new FOnlineSessionSearch());
-	SessionSearch->MaxSearchResults = SearchParams.MaxSearchResults;
+	SessionSearch->MaxSearchResults = QueryMaxSearchResults;
 	SessionSearch->bIsLanQuery = SearchParams.bIsLanQuery;
 	SessionSearch->TimeoutInSeconds = GetDefault<UKronosConfig>()->SearchTimeout;
 
@@ -262,8 +387,9 @@ void UKronosMatchmakingSearchPass::InitOnlineSessionSearch()
 
 		if (!SearchParams.bSkipEloChecks)
 		{
-			SessionSearch->QuerySettings.Set(SETTING_SESSIONELO, FMath::Max(SearchParams.Elo - SearchParams.EloRange, 0), EOnlineComparisonOp::GreaterThanEquals);
-			SessionSearch->QuerySettings.Set(SETTING_SESSIONELO2, SearchParams.Elo + SearchParams.EloRange, EOnlineComparisonOp::LessThanEquals);
+			// The query may use a wider elo range than the search params. The search filter always checks the elo range of the search params.
+			SessionSearch->QuerySettings.Set(SETTING_SESSIONELO, FMath::Max(SearchParams.Elo - QueryEloRange, 0), EOnlineComparisonOp::GreaterThanEquals);
+			SessionSearch->QuerySettings.Set(SETTING_SESSIONELO2, SearchParams.Elo + QueryEloRange, EOnlineComparisonOp::LessThanEquals);
 		}
 	}
 
@@ -294,6 +420,7 @@ void UKronosMatchmakingSearchPass::OnFindOnlineSessionsComplete(bool bWasSuccess
 	UE_LOG(LogKronos, Log, TEXT("OnFindOnlineSessionsComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
 	AsyncStateFlags &= ~static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
+	Timeline.EndStage(EKronosMatchmakingStage::Search, bWasSuccessful);
 
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
@@ -307,6 +434,15 @@ void UKronosMatchmakingSearchPass::OnFindOnlineSessionsComplete(bool bWasSuccess
 
 	if (bWasSuccessful)
 	{
+		if (GetDefault<UKronosConfig>()->SearchResultCacheLifetime > 0.0f && !SearchParams.IsSpecificSessionQuery())
+		{
+			CachedSearchResults = SessionSearch->SearchResults;
+			CachedSearchParams = SearchParams;
+			CachedSearchSessionName = SessionName;
+			CachedQueryEloRange = QueryEloRange;
+			CachedSearchTime = FPlatformTime::Seconds();
+		}
+
 		OnSearchComplete(SessionSearch->SearchResults);
 		return;
 	}
@@ -326,6 +462,7 @@ bool UKronosMatchmakingSearchPass::FindFriendSession()
 
 			AsyncStateFlags |= static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
 			SearchState = EKronosSearchPassState::Searching;
+			Timeline.BeginStage(EKronosMatchmakingStage::Search);
 
 			SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(0, OnFindFriendSessionCompleteDelegateHandle);
 			OnFindFriendSessionCompleteDelegateHandle = SessionInterface->AddOnFindFriendSessionCompleteDelegate_Handle(0, OnFindFriendSessionCompleteDelegate);
@@ -343,6 +480,7 @@ void UKronosMatchmakingSearchPass::OnFindFriendSessionComplete(int32 LocalUserNu
 	UE_LOG(LogKronos, Log, TEXT("OnFindFriendSessionComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
 	AsyncStateFlags &= ~static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
+	Timeline.EndStage(EKronosMatchmakingStage::Search, bWasSuccessful);
 
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
@@ -376,6 +514,7 @@ bool UKronosMatchmakingSearchPass::FindSessionById()
 
 			AsyncStateFlags |= static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
 			SearchState = EKronosSearchPassState::Searching;
+			Timeline.BeginStage(EKronosMatchmakingStage::Search);
 
 			// FUniqueNetId constructor is protected, so we'll get an empty FUniqueNetIdRepl instead and get the unique id from that.
 			static FUniqueNetIdRepl EmptyId = FUniqueNetIdRepl();
@@ -397,6 +536,7 @@ void UKronosMatchmakingSearchPass::OnFindSessionByIdComplete(int32 LocalUserNum,
 	UE_LOG(LogKronos, Log, TEXT("OnFindSessionByIdComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
 	AsyncStateFlags &= ~static_cast<uint8>(EKronosSearchPassAsyncStateFlags::FindingSessions);
+	Timeline.EndStage(EKronosMatchmakingStage::Search, bWasSuccessful);
 
 	if (bWasSuccessful)
 	{
@@ -420,12 +560,13 @@ void UKronosMatchmakingSearchPass::OnSearchComplete(const TArray<FOnlineSessionS
 		// Filter out unwanted or invalid sessions.
 		// This function doesn't contain any async tasks so it can be processed in one frame.
 		// However nothing is stopping us from implementing an async state for this task if needed.
+		Timeline.BeginStage(EKronosMatchmakingStage::Filter);
 		FilterSearchResults(InSearchResults);
+		Timeline.EndStage(EKronosMatchmakingStage::Filter, FilteredSessions.Num() > 0);
 
 		UE_LOG(LogKronos, Log, TEXT("Filtering complete. Valid sessions: %d"), FilteredSessions.Num());
 
 		// Begin pinging the remaining search results.
-		// NOTE: Session pinging is not implemented for now.
 		if (FilteredSessions.Num() > 0)
 		{
 			PingSearchResults();
@@ -461,242 +602,111 @@ bool UKronosMatchmakingSearchPass::FilterSearchResult(const FOnlineSessionSearch
 {
 	UE_LOG(LogKronos, Verbose, TEXT("Filtering session: %s, Owner: %s"), *InSearchResult.GetSessionIdStr(), *InSearchResult.Session.OwningUserName);
 
-	// Filters for any search type:
-	{
-		// Filter invalid sessions.
-		if (!InSearchResult.IsValid())
-		{
-			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Session is invalid."));
-			return false;
-		}
+	// The search params have been compiled into the search filter when the search pass was started.
+	// Additional query settings that are added in InitOnlineSessionSearch() have to be filtered here manually.
+	return SearchFilter.PassesFilter(InSearchResult);
+}
 
-		// Filter our own session.
-		FUniqueNetIdPtr PrimaryPlayerId = GetWorld()->GetGameInstance()->GetPrimaryPlayerUniqueIdRepl().GetUniqueNetId();
-		if (InSearchResult.Session.OwningUserId == PrimaryPlayerId)
-		{
-			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Session is our own."));
-			return false;
-		}
+void UKronosMatchmakingSearchPass::PingSearchResults()
+{
+	UE_LOG(LogKronos, Log, TEXT("Pinging search results..."));
 
-		// Filter for session type.
-		{
-			FString SessionType;
-			InSearchResult.Session.SessionSettings.Get(SETTING_SESSIONTYPE, SessionType);
+	AsyncStateFlags |= static_cast<uint8>(EKronosSearchPassAsyncStateFlags::PingingSessions);
+	SearchState = EKronosSearchPassState::PingingSessions;
 
-			if (SessionType != SessionName.ToString())
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - SessionType didn't match '%s'."), *SessionName.ToString());
-				return false;
-			}
-		}
+	// Pinging is skipped for specific session queries, since there is nothing to choose from.
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+	if (!KronosConfig->bPingSearchResults || SearchParams.IsSpecificSessionQuery())
+	{
+		OnPingSearchResultsComplete(false);
+		return;
+	}
 
-		// Filter ignored sessions.
-		{
-			const FUniqueNetId& OwnerId = *InSearchResult.Session.OwningUserId;
-			const FUniqueNetId& SessionId = InSearchResult.Session.SessionInfo->GetSessionId();
+	PingProbe = MakeUnique<FKronosPingProbe>();
+	PingTargetSessionIndices.Reset();
 
-			if (SearchParams.IgnoredSessions.Contains(OwnerId) || SearchParams.IgnoredSessions.Contains(SessionId))
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Session is in the ignored sessions list."));
-				return false;
-			}
-		}
-	}
-	
-	// Filters for specific session queries:
-	if (SearchParams.IsSpecificSessionQuery())
+	for (int32 SessionIdx = 0; SessionIdx < FilteredSessions.Num() && PingTargetSessionIndices.Num() < KronosConfig->MaxSessionsToPing; SessionIdx++)
 	{
-		// Filter for session owner id.
-		if (SearchParams.SpecificSessionQuery.Type == EKronosSpecificSessionQueryType::SessionOwnerId)
+		TSharedPtr<FInternetAddr> PingAddress;
+		if (GetPingAddress(FilteredSessions[SessionIdx], PingAddress))
 		{
-			FString OwnerId;
-			InSearchResult.Session.SessionSettings.Get(SETTING_OWNERID, OwnerId);
-
-			if (OwnerId != SearchParams.SpecificSessionQuery.UniqueId->ToString())
+			if (PingProbe->AddTarget(PingAddress.ToSharedRef()) != INDEX_NONE)
 			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - SessionOwnerId didn't match '%s'."), *SearchParams.SpecificSessionQuery.UniqueId.ToDebugString());
-				return false;
+				PingTargetSessionIndices.Add(SessionIdx);
 			}
 		}
 	}
 
-	// Filters for regular searches:
-	else
+	if (PingTargetSessionIndices.Num() == 0 || !PingProbe->Start(KronosConfig->PingProbesPerSession, KronosConfig->PingTimeBudget))
 	{
-		// Filter hidden sessions.
-		{
-			bool SessionHidden;
-			InSearchResult.Session.SessionSettings.Get(SETTING_HIDDEN, SessionHidden);
-
-			if (SessionHidden)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Session is hidden."));
-				return false;
-			}
-		}
-
-		// Filter for session slots.
-		if (SearchParams.MinSlotsRequired > 0)
-		{
-			if (InSearchResult.Session.NumOpenPublicConnections < SearchParams.MinSlotsRequired)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Not enough slots in session."));
-				return false;
-			}
-		}
-
-		// Filter for session playlist.
-		if (!SearchParams.Playlist.IsEmpty())
-		{
-			FString SessionPlaylistName;
-			InSearchResult.Session.SessionSettings.Get(SETTING_PLAYLIST, SessionPlaylistName);
-
-			if (SessionPlaylistName != SearchParams.Playlist)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Playlist didn't match '%s'."), *SearchParams.Playlist);
-				return false;
-			}
-		}
-
-		// Filter for session map name.
-		if (!SearchParams.MapName.IsEmpty())
-		{
-			FString SessionMapName;
-			InSearchResult.Session.SessionSettings.Get(SETTING_MAPNAME, SessionMapName);
-
-			if (SessionMapName != SearchParams.MapName)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - MapName didn't match '%s'."), *SearchParams.MapName);
-				return false;
-			}
-		}
-
-		// Filter for session game mode.
-		if (!SearchParams.GameMode.IsEmpty())
-		{
-			FString SessionGameMode;
-			InSearchResult.Session.SessionSettings.Get(SETTING_GAMEMODE, SessionGameMode);
-
-			if (SessionGameMode != SearchParams.GameMode)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - GameMode didn't match '%s'."), *SearchParams.GameMode);
-				return false;
-			}
-		}
-
-		// Filter for session elo.
-		if (!SearchParams.bSkipEloChecks)
-		{
-			int32 EloRangeMin = FMath::Max(SearchParams.Elo - SearchParams.EloRange, 0);
-			int32 EloRangeMax = SearchParams.Elo + SearchParams.EloRange;
+		UE_LOG(LogKronos, Log, TEXT("None of the search results can be pinged."));
 
-			int32 SessionElo;
-			InSearchResult.Session.SessionSettings.Get(SETTING_SESSIONELO, SessionElo);
-
-			int32 SessionElo2;
-			InSearchResult.Session.SessionSettings.Get(SETTING_SESSIONELO2, SessionElo2);
+		PingProbe.Reset();
+		OnPingSearchResultsComplete(false);
+		return;
+	}
 
-			if (SessionElo < EloRangeMin)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - SessionElo too low."));
-				return false;
-			}
+	UE_LOG(LogKronos, Verbose, TEXT("Pinging %d sessions..."), PingTargetSessionIndices.Num());
 
-			if (SessionElo2 > EloRangeMax)
-			{
-				UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - SessionElo too high."));
-				return false;
-			}
-		}
+	Timeline.BeginStage(EKronosMatchmakingStage::Ping);
 
-		// Filter sessions which we or any of our party members are banned from.
-		{
-			FString BannedPlayers;
-			InSearchResult.Session.SessionSettings.Get(SETTING_BANNEDPLAYERS, BannedPlayers);
+	// Poll the probe once per frame until it is complete. The timer is re-armed by every tick.
+	// A looping timer with a tiny interval would catch up and poll multiple times in a single frame.
+	TimerHandle_PingTick = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::TickPingSearchResults);
+}
 
-			if (!BannedPlayers.IsEmpty())
-			{
-				TArray<FString> BannedPlayersArray;
-				if (BannedPlayers.ParseIntoArray(BannedPlayersArray, TEXT(";")) > 0)
-				{
-					UKronosPartyManager* PartyManager = UKronosPartyManager::Get(this);
-					if (PartyManager->IsPartyLeader())
-					{
-						for (FUniqueNetIdRepl& PartyPlayerUniqueId : PartyManager->GetPartyPlayerUniqueIds())
-						{
-							if (BannedPlayersArray.Contains(PartyPlayerUniqueId.ToString()))
-							{
-								UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - A party member is banned from the session."));
-								return false;
-							}
-						}
-					}
-
-					else
-					{
-						FUniqueNetIdPtr PrimaryPlayerId = GetWorld()->GetGameInstance()->GetPrimaryPlayerUniqueIdRepl().GetUniqueNetId();
-						if (BannedPlayersArray.Contains(PrimaryPlayerId->ToString()))
-						{
-							UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - The player is banned from the session."));
-							return false;
-						}
-					}
-				}
-			}
-		}
+bool UKronosMatchmakingSearchPass::GetPingAddress(const FKronosSearchResult& InSearchResult, TSharedPtr<FInternetAddr>& OutAddress) const
+{
+	int32 BeaconPort = 0;
+	if (!InSearchResult.GetSessionSetting(SETTING_BEACONPORT, BeaconPort) || BeaconPort <= 0)
+	{
+		return false;
 	}
 
-	// Filter extra query settings.
-	for (FKronosQuerySetting& ExtraQuery : SearchParams.ExtraQuerySettings)
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineSessionPtr SessionInterface = OnlineSubsystem ? OnlineSubsystem->GetSessionInterface() : nullptr;
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SessionInterface.IsValid() || !SocketSubsystem)
 	{
-		const FOnlineSessionSetting* Setting = InSearchResult.Session.SessionSettings.Settings.Find(ExtraQuery.Key);
-		if (!Setting)
-		{
-			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - %s extra query setting has no corresponding session setting on the session."), *ExtraQuery.Key.ToString());
-			return false;
-		}
+		return false;
+	}
 
-		bool bValid = false;
+	FString ConnectString;
+	if (!SessionInterface->GetResolvedConnectString(InSearchResult.OnlineResult, NAME_BeaconPort, ConnectString))
+	{
+		return false;
+	}
 
-		switch (ExtraQuery.Data.GetType())
-		{
-		case EOnlineKeyValuePairDataType::Int32:
-			bValid = ExtraQuery.CompareAgainst<int32>(Setting);
-			break;
-		case EOnlineKeyValuePairDataType::String:
-			bValid = ExtraQuery.CompareAgainst<FString>(Setting);
-			break;
-		case EOnlineKeyValuePairDataType::Float:
-			bValid = ExtraQuery.CompareAgainst<float>(Setting);
-			break;
-		case EOnlineKeyValuePairDataType::Bool:
-			bValid = ExtraQuery.CompareAgainst<bool>(Setting);
-			break;
-		default:
-			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - %s extra query setting has an invalid value type."), *ExtraQuery.Key.ToString());
-			return false;
-		}
+	// Subsystems that don't resolve to an IP address (e.g. P2P relays) can't be pinged with plain UDP probes.
+	OutAddress = SocketSubsystem->GetAddressFromString(ConnectString);
+	if (!OutAddress.IsValid() || !OutAddress->IsValid())
+	{
+		OutAddress = SocketSubsystem->CreateInternetAddr();
 
-		if (!bValid)
+		bool bIsValid = false;
+		OutAddress->SetIp(*ConnectString, bIsValid);
+		if (!bIsValid)
 		{
-			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - %s extra query setting auto-comparison returned false."), *ExtraQuery.Key.ToString());
+			OutAddress.Reset();
 			return false;
 		}
 	}
 
+	OutAddress->SetPort(BeaconPort + GetDefault<UKronosConfig>()->PingPortOffset);
 	return true;
 }
 
-void UKronosMatchmakingSearchPass::PingSearchResults()
+void UKronosMatchmakingSearchPass::TickPingSearchResults()
 {
-	UE_LOG(LogKronos, Log, TEXT("Pinging search results..."));
-
-	AsyncStateFlags |= static_cast<uint8>(EKronosSearchPassAsyncStateFlags::PingingSessions);
-	SearchState = EKronosSearchPassState::PingingSessions;
+	TimerHandle_PingTick.Invalidate();
 
-	UE_LOG(LogKronos, Log, TEXT("KronosMatchmakingSearchPass::PingSearchResults - not implemented"));
+	if (!PingProbe.IsValid() || PingProbe->Tick())
+	{
+		OnPingSearchResultsComplete(PingProbe.IsValid() && PingProbe->NumAnsweredTargets() > 0);
+		return;
+	}
 
-	OnPingSearchResultsComplete(false);
+	TimerHandle_PingTick = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ThisClass::TickPingSearchResults);
 }
 
 void UKronosMatchmakingSearchPass::OnPingSearchResultsComplete(bool bWasSuccessful)
@@ -704,6 +714,27 @@ void UKronosMatchmakingSearchPass::OnPingSearchResultsComplete(bool bWasSuccessf
 	UE_LOG(LogKronos, Log, TEXT("OnPingSearchResultsComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
 	AsyncStateFlags &= ~static_cast<uint8>(EKronosSearchPassAsyncStateFlags::PingingSessions);
+	Timeline.EndStage(EKronosMatchmakingStage::Ping, bWasSuccessful);
+
+	// Store the measured pings in the search results. Sessions that didn't answer keep the ping reported by the online subsystem.
+	if (PingProbe.IsValid())
+	{
+		PingProbe->Stop();
+
+		for (int32 TargetIdx = 0; TargetIdx < PingTargetSessionIndices.Num(); TargetIdx++)
+		{
+			const int32 PingInMs = PingProbe->GetPingInMs(TargetIdx);
+			if (PingInMs != INDEX_NONE && FilteredSessions.IsValidIndex(PingTargetSessionIndices[TargetIdx]))
+			{
+				FilteredSessions[PingTargetSessionIndices[TargetIdx]].OnlineResult.PingInMs = PingInMs;
+			}
+		}
+
+		UE_LOG(LogKronos, Log, TEXT("Sessions answered ping: %d/%d"), PingProbe->NumAnsweredTargets(), PingProbe->NumTargets());
+
+		PingProbe.Reset();
+		PingTargetSessionIndices.Reset();
+	}
 
 	if (bWasCanceled)
 	{
@@ -720,7 +751,73 @@ void UKronosMatchmakingSearchPass::OnPingSearchResultsComplete(bool bWasSuccessf
 
 void UKronosMatchmakingSearchPass::SortSearchResults()
 {
-	UE_LOG(LogKronos, Log, TEXT("KronosMatchmakingSearchPass::SortSearchResults - not implemented"));
+	// Score every search result once, then sort by the cached scores.
+	TArray<TPair<float, int32>> Scores;
+	Scores.Reserve(FilteredSessions.Num());
+
+	for (int32 SessionIdx = 0; SessionIdx < FilteredSessions.Num(); SessionIdx++)
+	{
+		Scores.Emplace(ScoreSearchResult(FilteredSessions[SessionIdx]), SessionIdx);
+	}
+
+	Scores.StableSort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	TArray<FKronosSearchResult> SortedSessions;
+	SortedSessions.Reserve(FilteredSessions.Num());
+
+	for (const TPair<float, int32>& Score : Scores)
+	{
+		UE_LOG(LogKronos, Verbose, TEXT("Session score: %.3f - %s"), Score.Key, *FilteredSessions[Score.Value].OnlineResult.GetSessionIdStr());
+		SortedSessions.Add(MoveTemp(FilteredSessions[Score.Value]));
+	}
+
+	FilteredSessions = MoveTemp(SortedSessions);
+
+	if (UE_LOG_ACTIVE(LogKronos, Verbose))
+	{
+		DumpFilteredSessions();
+	}
+}
+
+float UKronosMatchmakingSearchPass::ScoreSearchResult(const FKronosSearchResult& InSearchResult) const
+{
+	return KronosMatchmakingRules::GetSessionScore(GetEloScore(InSearchResult), GetOpenSlotsScore(InSearchResult), GetPingScore(InSearchResult), GetFillRateScore(InSearchResult));
+}
+
+float UKronosMatchmakingSearchPass::GetEloScore(const FKronosSearchResult& InSearchResult) const
+{
+	if (SearchParams.bSkipEloChecks)
+	{
+		return 1.0f;
+	}
+
+	int32 SessionElo = 0;
+	int32 SessionElo2 = 0;
+	InSearchResult.GetSessionSetting(SETTING_SESSIONELO, SessionElo);
+	InSearchResult.GetSessionSetting(SETTING_SESSIONELO2, SessionElo2);
+
+	const float SessionEloMidpoint = (SessionElo + SessionElo2) * 0.5f;
+	const float EloDistance = FMath::Abs(SessionEloMidpoint - SearchParams.Elo);
+
+	return KronosMatchmakingRules::GetEloScore(EloDistance, SearchParams.EloRange);
+}
+
+float UKronosMatchmakingSearchPass::GetOpenSlotsScore(const FKronosSearchResult& InSearchResult) const
+{
+	return KronosMatchmakingRules::GetOpenSlotsScore(InSearchResult.OnlineResult.Session.NumOpenPublicConnections, SearchParams.MinSlotsRequired);
+}
+
+float UKronosMatchmakingSearchPass::GetPingScore(const FKronosSearchResult& InSearchResult) const
+{
+	return KronosMatchmakingRules::GetPingScore(InSearchResult.GetPingInMs());
+}
+
+float UKronosMatchmakingSearchPass::GetFillRateScore(const FKronosSearchResult& InSearchResult) const
+{
+	return KronosMatchmakingRules::GetFillRateScore(InSearchResult.GetNumPlayers(), InSearchResult.OnlineResult.Session.SessionSettings.NumPublicConnections);
 }
 
 void UKronosMatchmakingSearchPass::RestartSearch()
@@ -827,6 +924,8 @@ void UKronosMatchmakingSearchPass::DumpSettings() const
 	UE_LOG(LogKronos, Log, TEXT("    MinSlotsRequired: %d"), SearchParams.MinSlotsRequired);
 	UE_LOG(LogKronos, Log, TEXT("    Elo: %d"), SearchParams.Elo);
 	UE_LOG(LogKronos, Log, TEXT("    EloRange: %d"), SearchParams.EloRange);
+	UE_LOG(LogKronos, Log, TEXT("    QueryEloRange: %d"), QueryEloRange);
+	UE_LOG(LogKronos, Log, TEXT("    QueryMaxSearchResults: %d"), QueryMaxSearchResults);
 	UE_LOG(LogKronos, Log, TEXT("    bIsLanQuery: %s"), SearchParams.bIsLanQuery ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogKronos, Log, TEXT("    bSearchPresence: %s"), SearchParams.bSearchPresence ? TEXT("True") : TEXT("False"));
 	UE_LOG(LogKronos, Log, TEXT("    bSkipEloChecks: %s"), SearchParams.bSkipEloChecks ? TEXT("True") : TEXT("False"));
@@ -845,6 +944,8 @@ void UKronosMatchmakingSearchPass::DumpSettings() const
 	{
 		UE_LOG(LogKronos, Log, TEXT("      %s"), *IgnoredSession.ToDebugString());
 	}
+
+	SearchFilter.DumpInstructions();
 }
 
 void UKronosMatchmakingSearchPass::DumpFilteredSessions() const
@@ -857,7 +958,7 @@ void UKronosMatchmakingSearchPass::DumpFilteredSessions() const
 			const FKronosSearchResult& SearchResult = FilteredSessions[Idx];
 			if (SearchResult.OnlineResult.IsValid())
 			{
-				UE_LOG(LogKronos, Log, TEXT("  %d. %s %s"), Idx, *SearchResult.GetSessionType().ToString(), *SearchResult.OnlineResult.GetSessionIdStr());
+				UE_LOG(LogKronos, Log, TEXT("  %d. %s %s (%d ms)"), Idx, *SearchResult.GetSessionType().ToString(), *SearchResult.OnlineResult.GetSessionIdStr(), SearchResult.GetPingInMs());
 			}
 
 			else UE_LOG(LogKronos, Log, TEXT("  %d. %s"), Idx, TEXT("INVALID"));
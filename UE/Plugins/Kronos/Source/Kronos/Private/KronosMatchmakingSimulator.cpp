@@ -0,0 +1,660 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#include "KronosMatchmakingSimulator.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Kronos.h"
+#include "KronosConfig.h"
+#include "KronosMatchmakingRules.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+
+FKronosMatchmakingSimulationParams::FKronosMatchmakingSimulationParams()
+{
+	const UKronosConfig* KronosConfig = GetDefault<UKronosConfig>();
+
+	NumClients = 1000;
+	ArrivalWindow = 60.0f;
+	NumInitialSessions = 20;
+	MaxPlayersPerSession = 10;
+	MaxPartySize = 2;
+	EloMean = 1000;
+	EloStdDev = 200;
+	EloRange = 100;
+	EloSearchStep = 50;
+	MaxSearchAttempts = 5;
+	EloRangeBeforeHosting = 300;
+	MaxSearchResults = 50;
+	MaxParallelReservationRequests = KronosConfig->MaxParallelReservationRequests;
+	RestartMatchmakingPassDelay = KronosConfig->RestartMatchmakingPassDelay;
+	SearchLatency = 1.0f;
+	ReservationLatency = 0.15f;
+	JoinLatency = 0.5f;
+	CreateSessionLatency = 1.0f;
+	Seed = 420;
+}
+
+namespace KronosMatchmakingSimulator
+{
+	/** Simulated events. */
+	enum class EEventType : uint8
+	{
+		StartMatchmaking,
+		SearchComplete,
+		ReservationRequestReceived,
+		ProcessReservationQueue,
+		ReservationCancelReceived,
+		ReservationResponse,
+		JoinComplete,
+		CreateSessionComplete,
+		RestartMatchmakingPass
+	};
+
+	/** A scheduled event. Events at the same time are processed in the order they were scheduled. */
+	struct FEvent
+	{
+		double Time;
+		int64 Sequence;
+		int32 ClientIdx;
+		int32 SessionIdx;
+		int32 BatchIdx;
+		bool bAccepted;
+		EEventType Type;
+
+		bool operator<(const FEvent& Other) const
+		{
+			return Time < Other.Time || (Time == Other.Time && Sequence < Other.Sequence);
+		}
+	};
+
+	/** A reservation request waiting in the reservation queue of a simulated host. */
+	struct FQueuedReservationRequest
+	{
+		int32 ClientIdx;
+		int32 BatchIdx;
+		double QueueTime;
+	};
+
+	/** A simulated session. Reserved slots are only known to the host, the online subsystem only sees the players. */
+	struct FSession
+	{
+		int32 Elo;
+		int32 NumPlayers;
+		int32 NumReserved;
+
+		/** Reservation requests collected during the admission window. */
+		TArray<FQueuedReservationRequest> ReservationQueue;
+
+		/** Whether the reservation queue is scheduled to be processed. */
+		bool bReservationQueueScheduled;
+
+		FSession(const int32 InElo, const int32 InNumPlayers) :
+			Elo(InElo),
+			NumPlayers(InNumPlayers),
+			NumReserved(0),
+			ReservationQueue(TArray<FQueuedReservationRequest>()),
+			bReservationQueueScheduled(false)
+		{}
+	};
+
+	/** A session as the online subsystem returned it. The players of the session may have changed since. */
+	struct FSessionSnapshot
+	{
+		int32 SessionIdx;
+		int32 Elo;
+		int32 NumPlayers;
+	};
+
+	/** A simulated matchmaking client. Mirrors the state of UKronosMatchmakingPolicy and UKronosMatchmakingSearchPass. */
+	struct FClient
+	{
+		FKronosMatchmakingParams MatchmakingParams;
+		int32 PartySize;
+		double StartTime;
+		int32 MatchmakingPassIdx;
+
+		/** See UKronosMatchmakingPolicy. */
+		TArray<int32> EloRangeSchedule;
+		float EstimatedSessionDensity;
+		float AverageMatchmakingPassDuration;
+		float CurrentPassRestartDelay;
+		double MatchmakingPassStartTime;
+
+		/** See UKronosMatchmakingSearchPass. CachedSearchTime is negative while there are no cached search results. */
+		TArray<FSessionSnapshot> CachedSearchResults;
+		double CachedSearchTime;
+		int32 CachedQueryEloRange;
+
+		/** Sorted search results of the current matchmaking pass. */
+		TArray<int32> SearchResults;
+
+		/** Index of the next search result to test. */
+		int32 NextResultIdx;
+
+		/** Index of the current batch of reservation requests. */
+		int32 BatchIdx;
+
+		/** Sessions that the current batch of reservation requests was sent to. */
+		TArray<int32> BatchSessionIndices;
+
+		/** Number of reservation responses we are waiting for. */
+		int32 NumPendingReservations;
+
+		/** Session that accepted our reservation in the current batch. INDEX_NONE if none yet. */
+		int32 AcceptedSessionIdx;
+	};
+
+	/** Runs a single simulation. */
+	class FSimulation
+	{
+	public:
+
+		FSimulation(const FKronosMatchmakingSimulationParams& InParams) :
+			Params(InParams),
+			KronosConfig(GetDefault<UKronosConfig>()),
+			RandomStream(InParams.Seed),
+			NextSequence(0)
+		{}
+
+		FKronosMatchmakingSimulationStats Run()
+		{
+			for (int32 Idx = 0; Idx < Params.NumInitialSessions; Idx++)
+			{
+				const int32 SessionElo = RandomElo();
+				Sessions.Emplace(SessionElo, RandomStream.RandRange(1, Params.MaxPlayersPerSession - 1));
+			}
+
+			Clients.SetNum(Params.NumClients);
+			for (int32 ClientIdx = 0; ClientIdx < Params.NumClients; ClientIdx++)
+			{
+				FClient& Client = Clients[ClientIdx];
+				Client.MatchmakingParams.Elo = RandomElo();
+				Client.PartySize = RandomStream.RandRange(1, FMath::Max(Params.MaxPartySize, 1));
+				Client.StartTime = RandomStream.FRandRange(0.0f, Params.ArrivalWindow);
+				Client.MatchmakingPassIdx = 1;
+				Client.EstimatedSessionDensity = 0.0f;
+				Client.AverageMatchmakingPassDuration = 0.0f;
+				Client.CurrentPassRestartDelay = 0.0f;
+				Client.MatchmakingPassStartTime = 0.0;
+				Client.CachedSearchTime = -1.0;
+				Client.CachedQueryEloRange = 0;
+				Client.NextResultIdx = 0;
+				Client.BatchIdx = 0;
+				Client.NumPendingReservations = 0;
+				Client.AcceptedSessionIdx = INDEX_NONE;
+
+				FKronosMatchmakingParams& MatchmakingParams = Client.MatchmakingParams;
+				MatchmakingParams.MinSlotsRequired = Client.PartySize;
+				MatchmakingParams.EloRange = Params.EloRange;
+				MatchmakingParams.EloSearchStep = Params.EloSearchStep;
+				MatchmakingParams.MaxSearchAttempts = Params.MaxSearchAttempts;
+				MatchmakingParams.EloRangeBeforeHosting = Params.EloRangeBeforeHosting;
+				MatchmakingParams.MaxSearchResults = Params.MaxSearchResults;
+
+				Schedule(Client.StartTime, ClientIdx, EEventType::StartMatchmaking);
+			}
+
+			while (EventQueue.Num() > 0)
+			{
+				FEvent Event;
+				EventQueue.HeapPop(Event, TLess<FEvent>(), false);
+
+				Stats.Duration = Event.Time;
+				ProcessEvent(Event);
+			}
+
+			return Stats;
+		}
+
+	private:
+
+		int32 RandomElo()
+		{
+			// Box-Muller transform.
+			const float U1 = FMath::Max(RandomStream.FRand(), KINDA_SMALL_NUMBER);
+			const float U2 = RandomStream.FRand();
+			const float Normal = FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * PI * U2);
+
+			return FMath::Max(FMath::RoundToInt32(Params.EloMean + Normal * Params.EloStdDev), 0);
+		}
+
+		void Schedule(const double Time, const int32 ClientIdx, const EEventType Type, const int32 SessionIdx = INDEX_NONE, const int32 BatchIdx = INDEX_NONE, const bool bAccepted = false)
+		{
+			EventQueue.HeapPush({ Time, NextSequence++, ClientIdx, SessionIdx, BatchIdx, bAccepted, Type }, TLess<FEvent>());
+		}
+
+		int32 GetEloSearchRangeFor(const FClient& Client, const int32 MatchmakingPassIdx) const
+		{
+			return KronosMatchmakingRules::GetEloSearchRangeFor(Client.MatchmakingParams, Client.EloRangeSchedule, MatchmakingPassIdx);
+		}
+
+		void ProcessEvent(const FEvent& Event)
+		{
+			switch (Event.Type)
+			{
+			case EEventType::StartMatchmaking:
+				StartSearchPass(Event.Time, Event.ClientIdx);
+				break;
+			case EEventType::RestartMatchmakingPass:
+				Clients[Event.ClientIdx].MatchmakingPassIdx++;
+				StartSearchPass(Event.Time, Event.ClientIdx);
+				break;
+			case EEventType::SearchComplete:
+				OnSearchComplete(Event);
+				break;
+			case EEventType::ReservationRequestReceived:
+				OnReservationRequestReceived(Event);
+				break;
+			case EEventType::ProcessReservationQueue:
+				ProcessReservationQueue(Event);
+				break;
+			case EEventType::ReservationCancelReceived:
+				OnReservationCancelReceived(Event);
+				break;
+			case EEventType::ReservationResponse:
+				OnReservationResponse(Event);
+				break;
+			case EEventType::JoinComplete:
+				OnJoinComplete(Event);
+				break;
+			case EEventType::CreateSessionComplete:
+				OnCreateSessionComplete(Event);
+				break;
+			}
+		}
+
+		/** Same conditions as UKronosMatchmakingSearchPass::HasCachedSearchResultsFor(), in simulated time. */
+		bool HasCachedSearchResultsFor(const FClient& Client, const double Time, const int32 EloRange) const
+		{
+			const float CacheLifetime = KronosConfig->SearchResultCacheLifetime;
+			if (CacheLifetime <= 0.0f || Client.CachedSearchTime < 0.0 || Time - Client.CachedSearchTime > CacheLifetime)
+			{
+				return false;
+			}
+
+			return EloRange <= Client.CachedQueryEloRange;
+		}
+
+		void StartSearchPass(const double Time, const int32 ClientIdx)
+		{
+			FClient& Client = Clients[ClientIdx];
+			Client.MatchmakingPassStartTime = Time;
+
+			const int32 EloRange = GetEloSearchRangeFor(Client, Client.MatchmakingPassIdx);
+			if (HasCachedSearchResultsFor(Client, Time, EloRange))
+			{
+				Stats.NumCachedSearches++;
+
+				FilterSearchResults(Client, Client.CachedSearchResults, EloRange);
+				CompleteSearchPass(Time, ClientIdx);
+				return;
+			}
+
+			Stats.NumSearches++;
+			Schedule(Time + Params.SearchLatency, ClientIdx, EEventType::SearchComplete);
+		}
+
+		void OnSearchComplete(const FEvent& Event)
+		{
+			FClient& Client = Clients[Event.ClientIdx];
+			const FKronosMatchmakingParams& MatchmakingParams = Client.MatchmakingParams;
+
+			// Query a wider elo range while search results are cached, same as UKronosMatchmakingPolicy::GetQueryEloRangeFor().
+			const int32 EloRange = GetEloSearchRangeFor(Client, Client.MatchmakingPassIdx);
+			int32 QueryEloRange = EloRange;
+
+			if (KronosConfig->SearchResultCacheLifetime > 0.0f)
+			{
+				QueryEloRange = KronosMatchmakingRules::GetCachedQueryEloRange(MatchmakingParams, Client.MatchmakingPassIdx, EloRange, GetEloSearchRangeFor(Client, MatchmakingParams.MaxSearchAttempts), true);
+			}
+
+			const int32 QueryMaxSearchResults = KronosMatchmakingRules::GetQueryMaxSearchResults(MatchmakingParams.MaxSearchResults, EloRange, QueryEloRange, false);
+
+			// The online subsystem returns the first matching sessions. It doesn't know about pending reservations.
+			TArray<FSessionSnapshot> QueryResults;
+			for (int32 SessionIdx = 0; SessionIdx < Sessions.Num() && QueryResults.Num() < QueryMaxSearchResults; SessionIdx++)
+			{
+				const FSession& Session = Sessions[SessionIdx];
+				if (FMath::Abs(Session.Elo - MatchmakingParams.Elo) <= QueryEloRange && Params.MaxPlayersPerSession - Session.NumPlayers >= Client.PartySize)
+				{
+					QueryResults.Add({ SessionIdx, Session.Elo, Session.NumPlayers });
+				}
+			}
+
+			if (KronosConfig->SearchResultCacheLifetime > 0.0f)
+			{
+				Client.CachedSearchResults = QueryResults;
+				Client.CachedSearchTime = Event.Time;
+				Client.CachedQueryEloRange = QueryEloRange;
+			}
+
+			FilterSearchResults(Client, QueryResults, EloRange);
+			CompleteSearchPass(Event.Time, Event.ClientIdx);
+		}
+
+		/** Filter the search results to the elo range of the current pass, and sort them by their score. */
+		void FilterSearchResults(FClient& Client, const TArray<FSessionSnapshot>& QueryResults, const int32 EloRange)
+		{
+			TArray<TPair<float, int32>> Scores;
+			Scores.Reserve(QueryResults.Num());
+
+			for (const FSessionSnapshot& Snapshot : QueryResults)
+			{
+				const int32 EloDistance = FMath::Abs(Snapshot.Elo - Client.MatchmakingParams.Elo);
+				const int32 NumOpenSlots = Params.MaxPlayersPerSession - Snapshot.NumPlayers;
+
+				if (EloDistance > EloRange || NumOpenSlots < Client.PartySize)
+				{
+					continue;
+				}
+
+				// Ping isn't simulated, so every session gets the score of a session that didn't answer the ping.
+				const float Score = KronosMatchmakingRules::GetSessionScore(
+					KronosMatchmakingRules::GetEloScore(EloDistance, EloRange),
+					KronosMatchmakingRules::GetOpenSlotsScore(NumOpenSlots, Client.PartySize),
+					KronosMatchmakingRules::GetPingScore(-1),
+					KronosMatchmakingRules::GetFillRateScore(Snapshot.NumPlayers, Params.MaxPlayersPerSession));
+
+				Scores.Emplace(Score, Snapshot.SessionIdx);
+			}
+
+			Scores.StableSort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+			{
+				return A.Key > B.Key;
+			});
+
+			Client.SearchResults.Reset();
+			for (const TPair<float, int32>& Score : Scores)
+			{
+				Client.SearchResults.Add(Score.Value);
+			}
+		}
+
+		void CompleteSearchPass(const double Time, const int32 ClientIdx)
+		{
+			FClient& Client = Clients[ClientIdx];
+
+			if (KronosConfig->bAdaptiveEloWidening)
+			{
+				KronosMatchmakingRules::UpdateEloRangeSchedule(Client.MatchmakingParams, Client.EloRangeSchedule, Client.EstimatedSessionDensity, Client.MatchmakingPassIdx, Client.SearchResults.Num());
+			}
+
+			if (Client.SearchResults.Num() == 0)
+			{
+				RestartMatchmaking(Time, ClientIdx);
+				return;
+			}
+
+			Client.NextResultIdx = 0;
+			TestNextSearchResults(Time, ClientIdx);
+		}
+
+		void TestNextSearchResults(const double Time, const int32 ClientIdx)
+		{
+			FClient& Client = Clients[ClientIdx];
+			if (Client.NextResultIdx >= Client.SearchResults.Num())
+			{
+				RestartMatchmaking(Time, ClientIdx);
+				return;
+			}
+
+			const int32 BatchSize = FMath::Min(FMath::Max(Params.MaxParallelReservationRequests, 1), Client.SearchResults.Num() - Client.NextResultIdx);
+
+			Client.BatchIdx++;
+			Client.BatchSessionIndices.Reset();
+			Client.NumPendingReservations = BatchSize;
+			Client.AcceptedSessionIdx = INDEX_NONE;
+
+			for (int32 Idx = 0; Idx < BatchSize; Idx++)
+			{
+				const int32 SessionIdx = Client.SearchResults[Client.NextResultIdx++];
+				Client.BatchSessionIndices.Add(SessionIdx);
+
+				Stats.NumReservationRequests++;
+				Schedule(Time + Params.ReservationLatency * 0.5f, ClientIdx, EEventType::ReservationRequestReceived, SessionIdx, Client.BatchIdx);
+			}
+		}
+
+		/** Same as AKronosReservationHost::ProcessReservationRequest(). */
+		void OnReservationRequestReceived(const FEvent& Event)
+		{
+			FSession& Session = Sessions[Event.SessionIdx];
+
+			const float AdmissionWindow = KronosConfig->ReservationAdmissionWindow;
+			if (AdmissionWindow <= 0.0f)
+			{
+				const int32 PartySize = Clients[Event.ClientIdx].PartySize;
+				const bool bAccepted = Params.MaxPlayersPerSession - Session.NumPlayers - Session.NumReserved >= PartySize;
+				if (bAccepted)
+				{
+					Session.NumReserved += PartySize;
+				}
+
+				SendReservationResponse(Event.Time, Event.ClientIdx, Event.SessionIdx, Event.BatchIdx, bAccepted);
+				return;
+			}
+
+			Session.ReservationQueue.Add({ Event.ClientIdx, Event.BatchIdx, Event.Time });
+
+			if (!Session.bReservationQueueScheduled)
+			{
+				Session.bReservationQueueScheduled = true;
+				Schedule(Event.Time + AdmissionWindow, INDEX_NONE, EEventType::ProcessReservationQueue, Event.SessionIdx);
+			}
+		}
+
+		/** Same as AKronosReservationHost::ProcessReservationQueue(). */
+		void ProcessReservationQueue(const FEvent& Event)
+		{
+			FSession& Session = Sessions[Event.SessionIdx];
+			Session.bReservationQueueScheduled = false;
+
+			TArray<FQueuedReservationRequest> Requests = MoveTemp(Session.ReservationQueue);
+			Session.ReservationQueue.Reset();
+
+			TArray<int32> RequestSizes;
+			RequestSizes.Reserve(Requests.Num());
+
+			for (const FQueuedReservationRequest& Request : Requests)
+			{
+				RequestSizes.Add(Clients[Request.ClientIdx].PartySize);
+			}
+
+			TArray<int32> AdmittedIndices;
+			KronosMatchmakingRules::PackReservationRequests(RequestSizes, FMath::Max(Params.MaxPlayersPerSession - Session.NumPlayers - Session.NumReserved, 0), AdmittedIndices);
+
+			int32 AdmittedIdx = 0;
+			for (int32 RequestIdx = 0; RequestIdx < Requests.Num(); RequestIdx++)
+			{
+				const FQueuedReservationRequest& Request = Requests[RequestIdx];
+
+				if (AdmittedIndices.IsValidIndex(AdmittedIdx) && AdmittedIndices[AdmittedIdx] == RequestIdx)
+				{
+					AdmittedIdx++;
+					Session.NumReserved += RequestSizes[RequestIdx];
+					SendReservationResponse(Event.Time, Request.ClientIdx, Event.SessionIdx, Request.BatchIdx, true);
+					continue;
+				}
+
+				if (RequestSizes[RequestIdx] > Params.MaxPlayersPerSession || Event.Time - Request.QueueTime >= KronosConfig->ReservationQueueTimeout)
+				{
+					SendReservationResponse(Event.Time, Request.ClientIdx, Event.SessionIdx, Request.BatchIdx, false);
+					continue;
+				}
+
+				Session.ReservationQueue.Add(Request);
+			}
+
+			if (Session.ReservationQueue.Num() > 0)
+			{
+				Session.bReservationQueueScheduled = true;
+				Schedule(Event.Time + FMath::Max(KronosConfig->ReservationAdmissionWindow, KINDA_SMALL_NUMBER), INDEX_NONE, EEventType::ProcessReservationQueue, Event.SessionIdx);
+			}
+		}
+
+		void SendReservationResponse(const double Time, const int32 ClientIdx, const int32 SessionIdx, const int32 BatchIdx, const bool bAccepted)
+		{
+			Schedule(Time + Params.ReservationLatency * 0.5f, ClientIdx, EEventType::ReservationResponse, SessionIdx, BatchIdx, bAccepted);
+		}
+
+		/** Requests that haven't been answered yet are removed from the queue. Answered ones are released by the client when the response arrives. */
+		void OnReservationCancelReceived(const FEvent& Event)
+		{
+			Sessions[Event.SessionIdx].ReservationQueue.RemoveAll([&Event](const FQueuedReservationRequest& Request)
+			{
+				return Request.ClientIdx == Event.ClientIdx && Request.BatchIdx == Event.BatchIdx;
+			});
+		}
+
+		void OnReservationResponse(const FEvent& Event)
+		{
+			FClient& Client = Clients[Event.ClientIdx];
+			FSession& Session = Sessions[Event.SessionIdx];
+
+			if (!Event.bAccepted)
+			{
+				Stats.NumReservationCollisions++;
+			}
+
+			else if (Client.AcceptedSessionIdx == INDEX_NONE)
+			{
+				Client.AcceptedSessionIdx = Event.SessionIdx;
+				Schedule(Event.Time + Params.JoinLatency, Event.ClientIdx, EEventType::JoinComplete, Event.SessionIdx);
+
+				// Cancel the other requests of the batch.
+				for (const int32 SessionIdx : Client.BatchSessionIndices)
+				{
+					if (SessionIdx != Event.SessionIdx)
+					{
+						Schedule(Event.Time + Params.ReservationLatency * 0.5f, Event.ClientIdx, EEventType::ReservationCancelReceived, SessionIdx, Client.BatchIdx);
+					}
+				}
+			}
+
+			else
+			{
+				// Another session accepted first, so this reservation is canceled.
+				Session.NumReserved -= Client.PartySize;
+				Stats.NumCanceledReservations++;
+			}
+
+			Client.NumPendingReservations--;
+
+			if (Client.NumPendingReservations == 0 && Client.AcceptedSessionIdx == INDEX_NONE)
+			{
+				TestNextSearchResults(Event.Time, Event.ClientIdx);
+			}
+		}
+
+		void OnJoinComplete(const FEvent& Event)
+		{
+			FClient& Client = Clients[Event.ClientIdx];
+			FSession& Session = Sessions[Event.SessionIdx];
+
+			Session.NumReserved -= Client.PartySize;
+			Session.NumPlayers += Client.PartySize;
+
+			Stats.NumJoined++;
+			Stats.TimesToMatch.Add(Event.Time - Client.StartTime);
+		}
+
+		void OnCreateSessionComplete(const FEvent& Event)
+		{
+			FClient& Client = Clients[Event.ClientIdx];
+			Sessions.Emplace(Client.MatchmakingParams.Elo, Client.PartySize);
+
+			Stats.NumHosted++;
+			Stats.TimesToMatch.Add(Event.Time - Client.StartTime);
+		}
+
+		/** Same as UKronosMatchmakingPolicy::RestartMatchmaking() without the NoHost flag. */
+		void RestartMatchmaking(const double Time, const int32 ClientIdx)
+		{
+			FClient& Client = Clients[ClientIdx];
+			const FKronosMatchmakingParams& MatchmakingParams = Client.MatchmakingParams;
+
+			const float MatchmakingPassDuration = static_cast<float>(Time - Client.MatchmakingPassStartTime) + Client.CurrentPassRestartDelay;
+			Client.AverageMatchmakingPassDuration = KronosMatchmakingRules::UpdateAverageMatchmakingPassDuration(Client.AverageMatchmakingPassDuration, MatchmakingPassDuration);
+
+			const int32 NextEloRange = GetEloSearchRangeFor(Client, Client.MatchmakingPassIdx + 1);
+			const float EstimatedWaitTime = KronosMatchmakingRules::GetEstimatedWaitTime(MatchmakingParams, Client.EstimatedSessionDensity, Client.AverageMatchmakingPassDuration, NextEloRange);
+
+			switch (KronosMatchmakingRules::GetRestartDecision(MatchmakingParams, Client.MatchmakingPassIdx, NextEloRange, EstimatedWaitTime, true))
+			{
+			case EKronosMatchmakingRestartDecision::HostEloRangeLimitReached:
+			case EKronosMatchmakingRestartDecision::HostWaitTimeTooLong:
+			case EKronosMatchmakingRestartDecision::HostSearchAttemptLimitReached:
+				Schedule(Time + Params.CreateSessionLatency, ClientIdx, EEventType::CreateSessionComplete);
+				return;
+			case EKronosMatchmakingRestartDecision::NoResults:
+				return;
+			case EKronosMatchmakingRestartDecision::NextPass:
+				break;
+			}
+
+			// The restart delay is skipped if the next pass can be answered from the cache.
+			Client.CurrentPassRestartDelay = HasCachedSearchResultsFor(Client, Time, NextEloRange) ? 0.0f : Params.RestartMatchmakingPassDelay;
+			Schedule(Time + Client.CurrentPassRestartDelay, ClientIdx, EEventType::RestartMatchmakingPass);
+		}
+
+	private:
+
+		const FKronosMatchmakingSimulationParams& Params;
+		const UKronosConfig* KronosConfig;
+		FRandomStream RandomStream;
+		int64 NextSequence;
+
+		TArray<FEvent> EventQueue;
+		TArray<FSession> Sessions;
+		TArray<FClient> Clients;
+
+		FKronosMatchmakingSimulationStats Stats;
+	};
+
+	FKronosMatchmakingSimulationStats Run(const FKronosMatchmakingSimulationParams& Params)
+	{
+		FSimulation Simulation = FSimulation(Params);
+
+		FKronosMatchmakingSimulationStats Stats = Simulation.Run();
+		Stats.NumFailed = Params.NumClients - Stats.NumJoined - Stats.NumHosted;
+
+		return Stats;
+	}
+
+	void RunAndLog(const FKronosMatchmakingSimulationParams& Params)
+	{
+		UE_LOG(LogKronos, Log, TEXT("Simulating matchmaking with %d clients (Parallel reservations: %d, EloRangeBeforeHosting: %d)..."), Params.NumClients, Params.MaxParallelReservationRequests, Params.EloRangeBeforeHosting);
+
+		const double StartTime = FPlatformTime::Seconds();
+		FKronosMatchmakingSimulationStats Stats = Run(Params);
+		const double WallTime = FPlatformTime::Seconds() - StartTime;
+
+		Stats.TimesToMatch.Sort();
+		auto GetPercentile = [&Stats](const double Percentile) -> double
+		{
+			if (Stats.TimesToMatch.Num() == 0)
+			{
+				return 0.0;
+			}
+
+			const int32 Idx = FMath::Clamp(FMath::CeilToInt32(Percentile * Stats.TimesToMatch.Num()) - 1, 0, Stats.TimesToMatch.Num() - 1);
+			return Stats.TimesToMatch[Idx];
+		};
+
+		const int32 NumMatched = Stats.NumJoined + Stats.NumHosted;
+
+		UE_LOG(LogKronos, Log, TEXT("  Simulated %.1fs in %.2fms."), Stats.Duration, WallTime * 1000.0);
+		UE_LOG(LogKronos, Log, TEXT("  Joined: %d  Hosted: %d  Failed: %d"), Stats.NumJoined, Stats.NumHosted, Stats.NumFailed);
+		UE_LOG(LogKronos, Log, TEXT("  Throughput: %.2f matches/s"), Stats.Duration > 0.0 ? NumMatched / Stats.Duration : 0.0);
+		UE_LOG(LogKronos, Log, TEXT("  Time-to-match: p50=%.2fs  p95=%.2fs  p99=%.2fs  Max=%.2fs"), GetPercentile(0.50), GetPercentile(0.95), GetPercentile(0.99), GetPercentile(1.0));
+		UE_LOG(LogKronos, Log, TEXT("  Searches: %d (%.2f per client)  Answered from cache: %d"), Stats.NumSearches, Params.NumClients > 0 ? static_cast<float>(Stats.NumSearches) / Params.NumClients : 0.0f, Stats.NumCachedSearches);
+		UE_LOG(LogKronos, Log, TEXT("  Reservation requests: %d  Collisions: %d (%.1f%%)  Canceled: %d"),
+			Stats.NumReservationRequests,
+			Stats.NumReservationCollisions,
+			Stats.NumReservationRequests > 0 ? 100.0f * Stats.NumReservationCollisions / Stats.NumReservationRequests : 0.0f,
+			Stats.NumCanceledReservations);
+	}
+}
+
+#endif
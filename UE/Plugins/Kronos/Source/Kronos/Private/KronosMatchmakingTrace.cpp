@@ -0,0 +1,238 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#include "KronosMatchmakingTrace.h"
+#include "Kronos.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(KronosMatchmakingChannel)
+
+UE_TRACE_EVENT_BEGIN(KronosMatchmaking, StageSpan)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+	UE_TRACE_EVENT_FIELD(bool, bWasSuccessful)
+UE_TRACE_EVENT_END()
+
+namespace KronosMatchmakingTrace
+{
+	/**
+	 * Latency histogram with logarithmic buckets.
+	 * Each bucket is 10% wider than the previous one, covering 1 ms to about an hour with a fixed amount of memory.
+	 */
+	struct FLatencyHistogram
+	{
+		/** Number of buckets. */
+		static constexpr int32 NumBuckets = 160;
+
+		/** Ratio between the upper bounds of two neighbouring buckets. */
+		static constexpr double BucketGrowth = 1.1;
+
+		/** Number of samples in each bucket. */
+		uint32 Counts[NumBuckets];
+
+		/** Total number of samples. */
+		uint64 NumSamples;
+
+		/** Sum of all samples in milliseconds. */
+		double SumMs;
+
+		/** Largest sample in milliseconds. */
+		double MaxMs;
+
+		/** Default constructor. */
+		FLatencyHistogram()
+		{
+			Reset();
+		}
+
+		/** Remove all samples. */
+		void Reset()
+		{
+			FMemory::Memzero(Counts);
+			NumSamples = 0;
+			SumMs = 0.0;
+			MaxMs = 0.0;
+		}
+
+		/** Record a sample. */
+		void Add(const double Ms)
+		{
+			int32 BucketIdx = 0;
+			if (Ms > 1.0)
+			{
+				BucketIdx = FMath::Clamp(FMath::CeilToInt32(FMath::Loge(Ms) / FMath::Loge(BucketGrowth)), 0, NumBuckets - 1);
+			}
+
+			Counts[BucketIdx]++;
+			NumSamples++;
+			SumMs += Ms;
+			MaxMs = FMath::Max(MaxMs, Ms);
+		}
+
+		/** @return Upper bound of the bucket that contains the given percentile (0-1) in milliseconds. */
+		double GetPercentile(const double Percentile) const
+		{
+			if (NumSamples == 0)
+			{
+				return 0.0;
+			}
+
+			const uint64 TargetRank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Percentile * NumSamples)));
+
+			uint64 Rank = 0;
+			for (int32 BucketIdx = 0; BucketIdx < NumBuckets; BucketIdx++)
+			{
+				Rank += Counts[BucketIdx];
+				if (Rank >= TargetRank)
+				{
+					// The largest sample is exact, so don't report a bucket bound above it.
+					return FMath::Min(FMath::Pow(BucketGrowth, static_cast<double>(BucketIdx)), MaxMs);
+				}
+			}
+
+			return MaxMs;
+		}
+	};
+
+	/** Latency histograms of successful stages. */
+	static FLatencyHistogram SuccessHistograms[static_cast<int32>(EKronosMatchmakingStage::Num)];
+
+	/** Latency histograms of failed stages. */
+	static FLatencyHistogram FailureHistograms[static_cast<int32>(EKronosMatchmakingStage::Num)];
+
+	/** @return Name of the timing region of the given stage. */
+	static const TCHAR* GetRegionName(const EKronosMatchmakingStage Stage)
+	{
+		switch (Stage)
+		{
+		case EKronosMatchmakingStage::Matchmaking:
+			return TEXT("Kronos.Matchmaking");
+		case EKronosMatchmakingStage::Search:
+			return TEXT("Kronos.Search");
+		case EKronosMatchmakingStage::Filter:
+			return TEXT("Kronos.Filter");
+		case EKronosMatchmakingStage::Ping:
+			return TEXT("Kronos.Ping");
+		case EKronosMatchmakingStage::Reservation:
+			return TEXT("Kronos.Reservation");
+		case EKronosMatchmakingStage::Join:
+			return TEXT("Kronos.Join");
+		case EKronosMatchmakingStage::CreateSession:
+			return TEXT("Kronos.CreateSession");
+		case EKronosMatchmakingStage::Travel:
+			return TEXT("Kronos.Travel");
+		default:
+			return TEXT("Kronos");
+		}
+	}
+
+	/** Log a single histogram. */
+	static void DumpHistogram(const TCHAR* Label, const FLatencyHistogram& Histogram)
+	{
+		if (Histogram.NumSamples == 0)
+		{
+			UE_LOG(LogKronos, Log, TEXT("    %s: -"), Label);
+			return;
+		}
+
+		UE_LOG(LogKronos, Log, TEXT("    %s: Count=%llu  p50=%.1fms  p95=%.1fms  p99=%.1fms  Mean=%.1fms  Max=%.1fms"),
+			Label,
+			Histogram.NumSamples,
+			Histogram.GetPercentile(0.50),
+			Histogram.GetPercentile(0.95),
+			Histogram.GetPercentile(0.99),
+			Histogram.SumMs / Histogram.NumSamples,
+			Histogram.MaxMs);
+	}
+
+	void DumpLatencyStats()
+	{
+		UE_LOG(LogKronos, Log, TEXT("Dumping matchmaking latency..."));
+
+		for (int32 StageIdx = 0; StageIdx < static_cast<int32>(EKronosMatchmakingStage::Num); StageIdx++)
+		{
+			UE_LOG(LogKronos, Log, TEXT("  %s:"), LexToString(static_cast<EKronosMatchmakingStage>(StageIdx)));
+			DumpHistogram(TEXT("Success"), SuccessHistograms[StageIdx]);
+			DumpHistogram(TEXT("Failure"), FailureHistograms[StageIdx]);
+		}
+	}
+
+	void ResetLatencyStats()
+	{
+		for (int32 StageIdx = 0; StageIdx < static_cast<int32>(EKronosMatchmakingStage::Num); StageIdx++)
+		{
+			SuccessHistograms[StageIdx].Reset();
+			FailureHistograms[StageIdx].Reset();
+		}
+	}
+}
+
+FKronosMatchmakingTimeline::FKronosMatchmakingTimeline()
+{
+	FMemory::Memzero(StageStartCycles);
+}
+
+void FKronosMatchmakingTimeline::BeginStage(const EKronosMatchmakingStage Stage)
+{
+	const int32 StageIdx = static_cast<int32>(Stage);
+	if (StageStartCycles[StageIdx] != 0)
+	{
+		TRACE_END_REGION(KronosMatchmakingTrace::GetRegionName(Stage));
+	}
+
+	StageStartCycles[StageIdx] = FPlatformTime::Cycles64();
+	TRACE_BEGIN_REGION(KronosMatchmakingTrace::GetRegionName(Stage));
+}
+
+void FKronosMatchmakingTimeline::EndStage(const EKronosMatchmakingStage Stage, const bool bWasSuccessful)
+{
+	const int32 StageIdx = static_cast<int32>(Stage);
+	if (StageStartCycles[StageIdx] == 0)
+	{
+		return;
+	}
+
+	const uint64 StartCycle = StageStartCycles[StageIdx];
+	const uint64 EndCycle = FPlatformTime::Cycles64();
+	StageStartCycles[StageIdx] = 0;
+
+	TRACE_END_REGION(KronosMatchmakingTrace::GetRegionName(Stage));
+
+	UE_TRACE_LOG(KronosMatchmaking, StageSpan, KronosMatchmakingChannel)
+		<< StageSpan.StartCycle(StartCycle)
+		<< StageSpan.EndCycle(EndCycle)
+		<< StageSpan.Stage(static_cast<uint8>(Stage))
+		<< StageSpan.bWasSuccessful(bWasSuccessful);
+
+	const double DurationMs = FPlatformTime::ToMilliseconds64(EndCycle - StartCycle);
+	if (bWasSuccessful)
+	{
+		KronosMatchmakingTrace::SuccessHistograms[StageIdx].Add(DurationMs);
+	}
+
+	else
+	{
+		KronosMatchmakingTrace::FailureHistograms[StageIdx].Add(DurationMs);
+	}
+
+	UE_LOG(LogKronos, Verbose, TEXT("Matchmaking stage '%s' %s after %.1fms."), LexToString(Stage), bWasSuccessful ? TEXT("succeeded") : TEXT("failed"), DurationMs);
+}
+
+void FKronosMatchmakingTimeline::Reset()
+{
+	for (int32 StageIdx = 0; StageIdx < static_cast<int32>(EKronosMatchmakingStage::Num); StageIdx++)
+	{
+		if (StageStartCycles[StageIdx] != 0)
+		{
+			TRACE_END_REGION(KronosMatchmakingTrace::GetRegionName(static_cast<EKronosMatchmakingStage>(StageIdx)));
+			StageStartCycles[StageIdx] = 0;
+		}
+	}
+}
+
+bool FKronosMatchmakingTimeline::IsStageActive(const EKronosMatchmakingStage Stage) const
+{
+	return StageStartCycles[static_cast<int32>(Stage)] != 0;
+}
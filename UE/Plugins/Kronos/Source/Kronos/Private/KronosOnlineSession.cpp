@@ -12,6 +12,7 @@
 #include "KronosConfig.h"
 #include "OnlineSubsystem.h"
 #include "TimerManager.h"
+#include "Misc/StringBuilder.h"
 #include "Engine/Engine.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/GameModeBase.h"
@@ -71,6 +72,13 @@ void UKronosOnlineSession::RegisterOnlineDelegates()
 	// We are going to use this to signal when the game default map is loaded and kick off auto login if required.
 	GameModeInitializedDelegateHandle = FGameModeEvents::GameModeInitializedEvent.AddUObject(this, &ThisClass::OnGameModeInitialized);
 
+	// Bind the post load map delegate. Used to time the travel to the game session.
+	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMap);
+
+	// Bind the travel and network failure delegates. A failed travel must not be recorded as a success by the next map load.
+	TravelFailureDelegateHandle = GEngine->OnTravelFailure().AddUObject(this, &ThisClass::OnTravelFailure);
+	NetworkFailureDelegateHandle = GEngine->OnNetworkFailure().AddUObject(this, &ThisClass::OnNetworkFailure);
+
 	// Bind online subsystem delegates.
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	IOnlineSessionPtr SessionInterface = OnlineSubsystem ? OnlineSubsystem->GetSessionInterface() : nullptr;
@@ -94,6 +102,15 @@ void UKronosOnlineSession::ClearOnlineDelegates()
 	FGameModeEvents::GameModeInitializedEvent.Remove(GameModeInitializedDelegateHandle);
 	GameModeInitializedDelegateHandle.Reset();
 
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+	PostLoadMapDelegateHandle.Reset();
+
+	GEngine->OnTravelFailure().Remove(TravelFailureDelegateHandle);
+	TravelFailureDelegateHandle.Reset();
+
+	GEngine->OnNetworkFailure().Remove(NetworkFailureDelegateHandle);
+	NetworkFailureDelegateHandle.Reset();
+
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	IOnlineSessionPtr SessionInterface = OnlineSubsystem ? OnlineSubsystem->GetSessionInterface() : nullptr;
 	if (SessionInterface.IsValid())
@@ -125,6 +142,21 @@ void UKronosOnlineSession::OnGameModeInitialized(AGameModeBase* GameMode)
 	}
 }
 
+void UKronosOnlineSession::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	TravelTimeline.EndStage(EKronosMatchmakingStage::Travel, LoadedWorld != nullptr);
+}
+
+void UKronosOnlineSession::OnTravelFailure(UWorld* InWorld, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+	TravelTimeline.EndStage(EKronosMatchmakingStage::Travel, false);
+}
+
+void UKronosOnlineSession::OnNetworkFailure(UWorld* InWorld, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	TravelTimeline.EndStage(EKronosMatchmakingStage::Travel, false);
+}
+
 void UKronosOnlineSession::OnGameDefaultMapLoaded()
 {
 	// Give blueprints a chance to implement custom logic.
@@ -391,6 +423,8 @@ void UKronosOnlineSession::ServerTravelToGameSession()
 						PartyManager->LeavePartyInternal();
 					}
 
+					TravelTimeline.BeginStage(EKronosMatchmakingStage::Travel);
+
 					// Create the travel URL and travel to the session after the delay.
 					FString TravelURL = FString::Printf(TEXT("%s?listen?MaxPlayers=%d"), *LevelName, NamedSession->SessionSettings.NumPublicConnections);
 					FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this, TravelURL]()
@@ -420,6 +454,8 @@ void UKronosOnlineSession::ClientTravelToGameSession()
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("Attempting client travel to game session..."));
 
+	TravelTimeline.BeginStage(EKronosMatchmakingStage::Travel);
+
 	FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda([this]()
 	{
 		// Resolve the connection with the session and travel to it.
@@ -511,6 +547,10 @@ void UKronosOnlineSession::OnCleanupSessionComplete(FName SessionName, bool bWas
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosOnlineSession: OnCleanupSessionComplete with result: %s"), (bWasSuccessful ? TEXT("Success") : TEXT("Failure")));
 
+	// The session is gone, so is any cached data of it.
+	DiscardPendingSessionUpdate(SessionName);
+	BannedPlayersCache.Remove(SessionName);
+
 	UWorld* World = GetWorld();
 	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
 
@@ -596,6 +636,77 @@ bool UKronosOnlineSession::UpdateSession(const FName SessionName, const FKronosS
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosOnlineSession: Updating %s..."), *SessionName.ToString());
 
+	if (GetSessionState(SessionName) == EOnlineSessionState::NoSession)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosOnlineSession: Failed to update %s - No session exists with the given name."), *SessionName.ToString());
+		return false;
+	}
+
+	if (InSessionSettings.MaxNumPlayers <= 0)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosOnlineSession: Failed to update %s - MaxNumPlayers must be greater than zero."), *SessionName.ToString());
+		return false;
+	}
+
+	for (const FKronosSessionSetting& ExtraSetting : InExtraSessionSettings)
+	{
+		if (!ExtraSetting.IsValid())
+		{
+			UE_LOG(LogKronos, Error, TEXT("KronosOnlineSession: Failed to update %s - Extra session setting '%s' is invalid."), *SessionName.ToString(), *ExtraSetting.Key.ToString());
+			return false;
+		}
+	}
+
+	FKronosPendingSessionUpdate& PendingUpdate = PendingSessionUpdates.FindOrAdd(SessionName);
+	PendingUpdate.SessionSettings = InSessionSettings;
+	PendingUpdate.bShouldRefreshOnlineData |= bShouldRefreshOnlineData;
+
+	for (const FKronosSessionSetting& ExtraSetting : InExtraSessionSettings)
+	{
+		PendingUpdate.ChangedSettings.Add(ExtraSetting.Key, FOnlineSessionSetting(ExtraSetting.Data, ExtraSetting.AdvertisementType));
+	}
+
+	ScheduleFlushSessionUpdates();
+	return true;
+}
+
+void UKronosOnlineSession::ScheduleFlushSessionUpdates()
+{
+	// Without a world there is no next frame to wait for.
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		FlushSessionUpdates();
+		return;
+	}
+
+	// Push every change made during this frame together in the next frame.
+	if (!World->GetTimerManager().TimerExists(TimerHandle_FlushSessionUpdates))
+	{
+		TimerHandle_FlushSessionUpdates = World->GetTimerManager().SetTimerForNextTick(this, &ThisClass::FlushSessionUpdates);
+	}
+}
+
+void UKronosOnlineSession::FlushSessionUpdates()
+{
+	UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandle_FlushSessionUpdates);
+	}
+
+	// Move the updates out first, in case a session update completes synchronously and queues new changes.
+	TMap<FName, FKronosPendingSessionUpdate> SessionUpdates = MoveTemp(PendingSessionUpdates);
+	PendingSessionUpdates.Reset();
+
+	for (const TPair<FName, FKronosPendingSessionUpdate>& SessionUpdate : SessionUpdates)
+	{
+		FlushSessionUpdate(SessionUpdate.Key, SessionUpdate.Value);
+	}
+}
+
+bool UKronosOnlineSession::FlushSessionUpdate(const FName SessionName, const FKronosPendingSessionUpdate& PendingUpdate)
+{
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
 	{
@@ -605,59 +716,107 @@ bool UKronosOnlineSession::UpdateSession(const FName SessionName, const FKronosS
 			FOnlineSessionSettings* SessionSettings = SessionInterface->GetSessionSettings(SessionName);
 			if (SessionSettings)
 			{
+				// The online subsystem replaces the session settings as a whole, so a single copy is still needed.
 				FOnlineSessionSettings UpdatedSessionSettings = FOnlineSessionSettings(*SessionSettings);
 
-				// Updating session configuration.
-				// NOTE: Some session settings cannot be updated after session creation (bIsLanMatch, bUsesPresence)
-
-				UpdatedSessionSettings.NumPublicConnections = InSessionSettings.MaxNumPlayers;
-				UpdatedSessionSettings.bShouldAdvertise = InSessionSettings.bShouldAdvertise;
-				UpdatedSessionSettings.bAllowJoinInProgress = InSessionSettings.bAllowJoinInProgress;
-				UpdatedSessionSettings.bAllowInvites = InSessionSettings.bAllowInvites;
-				UpdatedSessionSettings.bAllowJoinViaPresence = InSessionSettings.bAllowJoinViaPresence;
-				UpdatedSessionSettings.bUseLobbiesVoiceChatIfAvailable = InSessionSettings.bUseVoiceChatIfAvailable;
-
-				UpdatedSessionSettings.Set(SETTING_SERVERNAME, InSessionSettings.ServerName, EOnlineDataAdvertisementType::ViaOnlineService);
-				UpdatedSessionSettings.Set(SETTING_PLAYLIST, InSessionSettings.Playlist, EOnlineDataAdvertisementType::ViaOnlineService);
-				UpdatedSessionSettings.Set(SETTING_MAPNAME, InSessionSettings.MapName, EOnlineDataAdvertisementType::ViaOnlineService);
-				UpdatedSessionSettings.Set(SETTING_GAMEMODE, InSessionSettings.GameMode, EOnlineDataAdvertisementType::ViaOnlineService);
-				UpdatedSessionSettings.Set(SETTING_SESSIONELO, InSessionSettings.Elo, EOnlineDataAdvertisementType::ViaOnlineService);
-				UpdatedSessionSettings.Set(SETTING_SESSIONELO2, InSessionSettings.Elo, EOnlineDataAdvertisementType::ViaOnlineService);
-
-				// Converting to int32 because the Steam Subsystem doesn't support bool queries.
-				int32 bHidden = InSessionSettings.bHidden ? 1 : 0;
-				UpdatedSessionSettings.Set(SETTING_HIDDEN, bHidden, EOnlineDataAdvertisementType::ViaOnlineService);
-
-				// Update extra session settings.
-				for (const FKronosSessionSetting& ExtraSetting : InExtraSessionSettings)
+				if (PendingUpdate.SessionSettings.IsSet())
+				{
+					const FKronosSessionSettings& InSessionSettings = PendingUpdate.SessionSettings.GetValue();
+
+					// Updating session configuration.
+					// NOTE: Some session settings cannot be updated after session creation (bIsLanMatch, bUsesPresence)
+
+					UpdatedSessionSettings.NumPublicConnections = InSessionSettings.MaxNumPlayers;
+					UpdatedSessionSettings.bShouldAdvertise = InSessionSettings.bShouldAdvertise;
+					UpdatedSessionSettings.bAllowJoinInProgress = InSessionSettings.bAllowJoinInProgress;
+					UpdatedSessionSettings.bAllowInvites = InSessionSettings.bAllowInvites;
+					UpdatedSessionSettings.bAllowJoinViaPresence = InSessionSettings.bAllowJoinViaPresence;
+					UpdatedSessionSettings.bUseLobbiesVoiceChatIfAvailable = InSessionSettings.bUseVoiceChatIfAvailable;
+
+					UpdatedSessionSettings.Set(SETTING_SERVERNAME, InSessionSettings.ServerName, EOnlineDataAdvertisementType::ViaOnlineService);
+					UpdatedSessionSettings.Set(SETTING_PLAYLIST, InSessionSettings.Playlist, EOnlineDataAdvertisementType::ViaOnlineService);
+					UpdatedSessionSettings.Set(SETTING_MAPNAME, InSessionSettings.MapName, EOnlineDataAdvertisementType::ViaOnlineService);
+					UpdatedSessionSettings.Set(SETTING_GAMEMODE, InSessionSettings.GameMode, EOnlineDataAdvertisementType::ViaOnlineService);
+					UpdatedSessionSettings.Set(SETTING_SESSIONELO, InSessionSettings.Elo, EOnlineDataAdvertisementType::ViaOnlineService);
+					UpdatedSessionSettings.Set(SETTING_SESSIONELO2, InSessionSettings.Elo, EOnlineDataAdvertisementType::ViaOnlineService);
+
+					// Converting to int32 because the Steam Subsystem doesn't support bool queries.
+					int32 bHidden = InSessionSettings.bHidden ? 1 : 0;
+					UpdatedSessionSettings.Set(SETTING_HIDDEN, bHidden, EOnlineDataAdvertisementType::ViaOnlineService);
+				}
+
+				// Update the changed session settings the same way as UpdatedSessionSettings.Set(...) would.
+				for (const TPair<FName, FOnlineSessionSetting>& ChangedSetting : PendingUpdate.ChangedSettings)
 				{
-					// Register the session setting the same way as UpdatedSessionSettings.Set(...) would
+					FOnlineSessionSetting* Setting = UpdatedSessionSettings.Settings.Find(ChangedSetting.Key);
+					if (Setting)
 					{
-						FOnlineSessionSetting* Setting = UpdatedSessionSettings.Settings.Find(ExtraSetting.Key);
-						if (Setting)
-						{
-							Setting->Data = ExtraSetting.Data;
-							Setting->AdvertisementType = ExtraSetting.AdvertisementType;
-						}
-						else
+						Setting->Data = ChangedSetting.Value.Data;
+						Setting->AdvertisementType = ChangedSetting.Value.AdvertisementType;
+					}
+					else
+					{
+						UpdatedSessionSettings.Settings.Add(ChangedSetting.Key, ChangedSetting.Value);
+					}
+				}
+
+				// Add the players to the banned players string in one go.
+				// The expected format is "uniqueid1;uniqueid2;uniqueid3".
+				if (PendingUpdate.PlayersToBan.Num() > 0)
+				{
+					FString CurrentBannedPlayers;
+					UpdatedSessionSettings.Get(SETTING_BANNEDPLAYERS, CurrentBannedPlayers);
+
+					TStringBuilder<512> BannedPlayers;
+					BannedPlayers << CurrentBannedPlayers;
+
+					for (const FString& PlayerToBan : PendingUpdate.PlayersToBan)
+					{
+						if (BannedPlayers.Len() > 0)
 						{
-							UpdatedSessionSettings.Settings.Add(ExtraSetting.Key, FOnlineSessionSetting(ExtraSetting.Data, ExtraSetting.AdvertisementType));
+							BannedPlayers << TEXT(';');
 						}
+
+						BannedPlayers << PlayerToBan;
 					}
+
+					UpdatedSessionSettings.Set(SETTING_BANNEDPLAYERS, FString(BannedPlayers.ToView()), EOnlineDataAdvertisementType::ViaOnlineService);
 				}
 
-				return SessionInterface->UpdateSession(SessionName, UpdatedSessionSettings, bShouldRefreshOnlineData);
+				return SessionInterface->UpdateSession(SessionName, UpdatedSessionSettings, PendingUpdate.bShouldRefreshOnlineData);
 			}
 
-			UE_LOG(LogKronos, Error, TEXT("KronosOnlineSession: Failed to update %s - No session exists with the given name."), *SessionName.ToString());
+			// Whoever requested the update is waiting for the completion delegate, so it must fire even though the update never started.
+			UE_LOG(LogKronos, Warning, TEXT("KronosOnlineSession: Discarding pending update of %s - No session exists with the given name."), *SessionName.ToString());
+			SessionInterface->TriggerOnUpdateSessionCompleteDelegates(SessionName, false);
 			return false;
 		}
 	}
 
 	UE_LOG(LogKronos, Error, TEXT("KronosOnlineSession: Failed to update %s - Session Interface invalid."), *SessionName.ToString());
+	OnUpdateSessionComplete(SessionName, false);
 	return false;
 }
 
+void UKronosOnlineSession::DiscardPendingSessionUpdate(const FName SessionName)
+{
+	if (PendingSessionUpdates.Remove(SessionName) > 0)
+	{
+		UE_LOG(LogKronos, Log, TEXT("KronosOnlineSession: Discarding pending update of %s - Session is being destroyed."), *SessionName.ToString());
+
+		// Whoever requested the update is waiting for the completion delegate.
+		IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+		IOnlineSessionPtr SessionInterface = OnlineSubsystem ? OnlineSubsystem->GetSessionInterface() : nullptr;
+		if (SessionInterface.IsValid())
+		{
+			SessionInterface->TriggerOnUpdateSessionCompleteDelegates(SessionName, false);
+			return;
+		}
+
+		OnUpdateSessionComplete(SessionName, false);
+	}
+}
+
 bool UKronosOnlineSession::RegisterPlayer(const FName SessionName, const FUniqueNetIdRepl& PlayerId, const bool bWasFromInvite)
 {
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
@@ -764,6 +923,10 @@ bool UKronosOnlineSession::UnregisterPlayers(const FName SessionName, const TArr
 
 bool UKronosOnlineSession::DestroySession(const FName SessionName, const FOnDestroySessionCompleteDelegate& CompletionDelegate)
 {
+	// Changes and cached data of a session that is going away are not needed anymore.
+	DiscardPendingSessionUpdate(SessionName);
+	BannedPlayersCache.Remove(SessionName);
+
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
 	{
@@ -794,6 +957,22 @@ bool UKronosOnlineSession::BanPlayerFromSession(const FName SessionName, const F
 			return false;
 	}
 
+	if (GetSessionState(SessionName) == EOnlineSessionState::NoSession)
+	{
+		UE_LOG(LogKronos, Error, TEXT("No '%s' exists."), *SessionName.ToString());
+		return false;
+	}
+
+	FKronosPendingSessionUpdate& PendingUpdate = PendingSessionUpdates.FindOrAdd(SessionName);
+	PendingUpdate.PlayersToBan.Add(PlayerId.ToString());
+	PendingUpdate.bShouldRefreshOnlineData = true;
+
+	ScheduleFlushSessionUpdates();
+	return true;
+}
+
+bool UKronosOnlineSession::IsPlayerBannedFromSession(const FName SessionName, const FUniqueNetId& PlayerId)
+{
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (OnlineSubsystem)
 	{
@@ -803,51 +982,25 @@ bool UKronosOnlineSession::BanPlayerFromSession(const FName SessionName, const F
 			FOnlineSessionSettings* SessionSettings = SessionInterface->GetSessionSettings(SessionName);
 			if (SessionSettings)
 			{
-				FOnlineSessionSettings UpdatedSessionSettings = FOnlineSessionSettings(*SessionSettings);
-
-				FString BannedPlayers;
-				UpdatedSessionSettings.Get(SETTING_BANNEDPLAYERS, BannedPlayers);
-
-				// Add the player to the banned players string.
-				// The expected format is "uniqueid1;uniqueid2;uniqueid3".
+				const FOnlineSessionSetting* Setting = SessionSettings->Settings.Find(SETTING_BANNEDPLAYERS);
+				if (Setting)
 				{
-					bool bAppendComma = !BannedPlayers.IsEmpty(); // Append comma before every unique id except the first
-					BannedPlayers.Appendf(TEXT("%s%s"), bAppendComma ? TEXT(";") : TEXT(""), *PlayerId.ToString());
-				}
-
-				// Apply the changes.
-				UpdatedSessionSettings.Set(SETTING_BANNEDPLAYERS, BannedPlayers, EOnlineDataAdvertisementType::ViaOnlineService);
-
-				return SessionInterface->UpdateSession(SessionName, UpdatedSessionSettings, true);
-			}
-
-			UE_LOG(LogKronos, Error, TEXT("No '%s' exists."), *SessionName.ToString())
-				return false;
-		}
-	}
+					// The cached set is only rebuilt if the value of the setting changed since the last check.
+					FKronosBannedPlayers& BannedPlayers = BannedPlayersCache.FindOrAdd(SessionName);
+					BannedPlayers.Update(Setting->Data);
 
-	UE_LOG(LogKronos, Error, TEXT("Session Interface invalid."));
-	return false;
-}
-
-bool UKronosOnlineSession::IsPlayerBannedFromSession(const FName SessionName, const FUniqueNetId& PlayerId)
-{
-	FString BannedPlayers;
-	GetSessionSetting(SessionName, SETTING_BANNEDPLAYERS, BannedPlayers);
-
-	if (!BannedPlayers.IsEmpty())
-	{
-		TArray<FString> BannedPlayersArray;
-		if (BannedPlayers.ParseIntoArray(BannedPlayersArray, TEXT(";")) > 0)
-		{
-			if (BannedPlayersArray.Contains(PlayerId.ToString()))
-			{
-				return true;
+					if (BannedPlayers.Contains(PlayerId))
+					{
+						return true;
+					}
+				}
 			}
 		}
 	}
 
-	return false;
+	// The player may have been banned during this frame.
+	const FKronosPendingSessionUpdate* PendingUpdate = PendingSessionUpdates.Find(SessionName);
+	return PendingUpdate && PendingUpdate->PlayersToBan.Contains(PlayerId.ToString());
 }
 
 void UKronosOnlineSession::StartOnlineSession(FName SessionName)
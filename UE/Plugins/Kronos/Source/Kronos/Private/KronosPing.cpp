@@ -0,0 +1,457 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#include "KronosPing.h"
+#include "Kronos.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace KronosPing
+{
+	/** Maximum number of packets to process in a single tick. */
+	constexpr int32 MaxPacketsPerTick = 256;
+
+	/** Write the given value into the buffer in little endian byte order. */
+	static void WriteUInt32(uint8* Buffer, const uint32 Value)
+	{
+		Buffer[0] = static_cast<uint8>(Value);
+		Buffer[1] = static_cast<uint8>(Value >> 8);
+		Buffer[2] = static_cast<uint8>(Value >> 16);
+		Buffer[3] = static_cast<uint8>(Value >> 24);
+	}
+
+	/** Read a little endian value from the buffer. */
+	static uint32 ReadUInt32(const uint8* Buffer)
+	{
+		return static_cast<uint32>(Buffer[0]) | (static_cast<uint32>(Buffer[1]) << 8) | (static_cast<uint32>(Buffer[2]) << 16) | (static_cast<uint32>(Buffer[3]) << 24);
+	}
+
+	/** Write the given value into the buffer in little endian byte order. */
+	static void WriteUInt16(uint8* Buffer, const uint16 Value)
+	{
+		Buffer[0] = static_cast<uint8>(Value);
+		Buffer[1] = static_cast<uint8>(Value >> 8);
+	}
+
+	/** Read a little endian value from the buffer. */
+	static uint16 ReadUInt16(const uint8* Buffer)
+	{
+		return static_cast<uint16>(Buffer[0]) | static_cast<uint16>(Buffer[1] << 8);
+	}
+
+	/** Create a non-blocking UDP socket bound to the given address. */
+	static FSocket* CreateBoundSocket(ISocketSubsystem* SocketSubsystem, const FInternetAddr& BindAddress, const TCHAR* Description)
+	{
+		FSocket* NewSocket = SocketSubsystem->CreateSocket(NAME_DGram, Description, BindAddress.GetProtocolType());
+		if (!NewSocket)
+		{
+			return nullptr;
+		}
+
+		if (!NewSocket->SetNonBlocking(true) || !NewSocket->Bind(BindAddress))
+		{
+			SocketSubsystem->DestroySocket(NewSocket);
+			return nullptr;
+		}
+
+		return NewSocket;
+	}
+
+	/** Close and destroy the given socket. */
+	static void DestroySocket(FSocket*& InSocket)
+	{
+		if (InSocket)
+		{
+			InSocket->Close();
+
+			ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+			if (SocketSubsystem)
+			{
+				SocketSubsystem->DestroySocket(InSocket);
+			}
+
+			InSocket = nullptr;
+		}
+	}
+}
+
+FKronosPingResponder::FKronosPingResponder() :
+	Socket(nullptr),
+	Port(0),
+	TickerHandle(FTSTicker::FDelegateHandle())
+{}
+
+FKronosPingResponder::~FKronosPingResponder()
+{
+	Stop();
+}
+
+bool FKronosPingResponder::Start(const int32 InPort, const bool bLoopbackOnly, const bool bAutoTick)
+{
+	Stop();
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosPingResponder: Failed to start - Socket subsystem invalid."));
+		return false;
+	}
+
+	TSharedRef<FInternetAddr> BindAddress = SocketSubsystem->CreateInternetAddr();
+	if (bLoopbackOnly)
+	{
+		BindAddress->SetLoopbackAddress();
+	}
+
+	else
+	{
+		BindAddress->SetAnyAddress();
+	}
+
+	BindAddress->SetPort(InPort);
+
+	Socket = KronosPing::CreateBoundSocket(SocketSubsystem, *BindAddress, TEXT("KronosPingResponder"));
+	if (!Socket)
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosPingResponder: Failed to start - Could not bind port %d."), InPort);
+		return false;
+	}
+
+	Port = Socket->GetPortNo();
+
+	if (bAutoTick)
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FKronosPingResponder::HandleTick));
+	}
+
+	UE_LOG(LogKronos, Log, TEXT("KronosPingResponder: Listening for ping probes on port %d."), Port);
+	return true;
+}
+
+void FKronosPingResponder::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	if (Socket)
+	{
+		UE_LOG(LogKronos, Log, TEXT("KronosPingResponder: Stopped listening on port %d."), Port);
+		KronosPing::DestroySocket(Socket);
+	}
+
+	Port = 0;
+}
+
+void FKronosPingResponder::ProcessProbes()
+{
+	if (!Socket)
+	{
+		return;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	TSharedRef<FInternetAddr> SourceAddress = SocketSubsystem->CreateInternetAddr();
+
+	uint8 Buffer[KronosPing::ProbeSize];
+	int32 BytesRead = 0;
+
+	for (int32 PacketIdx = 0; PacketIdx < KronosPing::MaxPacketsPerTick; PacketIdx++)
+	{
+		if (!Socket->RecvFrom(Buffer, KronosPing::ProbeSize, BytesRead, *SourceAddress))
+		{
+			break;
+		}
+
+		// Echo valid probes back to the sender unchanged.
+		if (BytesRead == KronosPing::ProbeSize && KronosPing::ReadUInt32(Buffer) == KronosPing::ProbeMagic)
+		{
+			int32 BytesSent = 0;
+			Socket->SendTo(Buffer, KronosPing::ProbeSize, BytesSent, *SourceAddress);
+		}
+	}
+}
+
+bool FKronosPingResponder::HandleTick(float DeltaTime)
+{
+	ProcessProbes();
+	return true;
+}
+
+FKronosPingProbe::FKronosPingProbe() :
+	Targets(TArray<FTarget>()),
+	Socket(nullptr),
+	Nonce(0),
+	NumProbesPerTarget(0),
+	ProbeInterval(0.0),
+	StartTime(0.0),
+	EndTime(0.0)
+{}
+
+FKronosPingProbe::~FKronosPingProbe()
+{
+	Stop();
+}
+
+int32 FKronosPingProbe::AddTarget(const TSharedRef<FInternetAddr>& InAddress)
+{
+	if (Socket || !InAddress->IsValid() || Targets.Num() >= MAX_uint16)
+	{
+		return INDEX_NONE;
+	}
+
+	// Every probe is sent from the same socket, so the targets must use the same protocol.
+	if (Targets.Num() > 0 && Targets[0].Address->GetProtocolType() != InAddress->GetProtocolType())
+	{
+		return INDEX_NONE;
+	}
+
+	return Targets.Emplace(InAddress);
+}
+
+bool FKronosPingProbe::Start(const int32 InNumProbesPerTarget, const float InTimeBudget)
+{
+	if (Socket || Targets.Num() == 0)
+	{
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		return false;
+	}
+
+	TSharedRef<FInternetAddr> BindAddress = SocketSubsystem->CreateInternetAddr(Targets[0].Address->GetProtocolType());
+	BindAddress->SetAnyAddress();
+	BindAddress->SetPort(0);
+
+	Socket = KronosPing::CreateBoundSocket(SocketSubsystem, *BindAddress, TEXT("KronosPingProbe"));
+	if (!Socket)
+	{
+		UE_LOG(LogKronos, Warning, TEXT("KronosPingProbe: Failed to create socket."));
+		return false;
+	}
+
+	Nonce = FMath::Rand() ^ static_cast<uint32>(FPlatformTime::Cycles());
+	NumProbesPerTarget = FMath::Clamp(InNumProbesPerTarget, 1, static_cast<int32>(MAX_uint16));
+	ProbeInterval = FMath::Max(InTimeBudget, 0.0f) / (NumProbesPerTarget + 1);
+	StartTime = FPlatformTime::Seconds();
+	EndTime = StartTime + FMath::Max(InTimeBudget, 0.0f);
+
+	// Every target gets its first probe right away.
+	for (int32 TargetIdx = 0; TargetIdx < Targets.Num(); TargetIdx++)
+	{
+		FTarget& Target = Targets[TargetIdx];
+		Target.SendTimes.Init(0.0, NumProbesPerTarget);
+		Target.NumSent = 0;
+		Target.NumReceived = 0;
+		Target.BestRoundTripTime = -1.0;
+
+		SendProbe(TargetIdx, StartTime);
+	}
+
+	return true;
+}
+
+bool FKronosPingProbe::Tick()
+{
+	if (!Socket)
+	{
+		return true;
+	}
+
+	ReceiveAnswers(FPlatformTime::Seconds());
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now >= EndTime || AllTargetsComplete())
+	{
+		Stop();
+		return true;
+	}
+
+	// Send the next probe once the previous one was answered, or after the probe interval if it wasn't.
+	for (int32 TargetIdx = 0; TargetIdx < Targets.Num(); TargetIdx++)
+	{
+		const FTarget& Target = Targets[TargetIdx];
+		if (Target.NumSent < NumProbesPerTarget)
+		{
+			const bool bPreviousAnswered = Target.SendTimes[Target.NumSent - 1] == 0.0;
+			if (bPreviousAnswered || Now - Target.SendTimes[Target.NumSent - 1] >= ProbeInterval)
+			{
+				SendProbe(TargetIdx, Now);
+			}
+		}
+	}
+
+	return false;
+}
+
+void FKronosPingProbe::Stop()
+{
+	KronosPing::DestroySocket(Socket);
+}
+
+int32 FKronosPingProbe::GetPingInMs(const int32 TargetIdx) const
+{
+	if (Targets.IsValidIndex(TargetIdx) && Targets[TargetIdx].BestRoundTripTime >= 0.0)
+	{
+		return FMath::RoundToInt(Targets[TargetIdx].BestRoundTripTime * 1000.0);
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FKronosPingProbe::NumAnsweredTargets() const
+{
+	int32 NumAnswered = 0;
+	for (const FTarget& Target : Targets)
+	{
+		NumAnswered += Target.NumReceived > 0 ? 1 : 0;
+	}
+
+	return NumAnswered;
+}
+
+void FKronosPingProbe::SendProbe(const int32 TargetIdx, const double Now)
+{
+	FTarget& Target = Targets[TargetIdx];
+	const int32 ProbeIdx = Target.NumSent++;
+
+	uint8 Buffer[KronosPing::ProbeSize];
+	KronosPing::WriteUInt32(Buffer, KronosPing::ProbeMagic);
+	KronosPing::WriteUInt32(Buffer + 4, Nonce);
+	KronosPing::WriteUInt16(Buffer + 8, static_cast<uint16>(TargetIdx));
+	KronosPing::WriteUInt16(Buffer + 10, static_cast<uint16>(ProbeIdx));
+
+	int32 BytesSent = 0;
+	if (Socket->SendTo(Buffer, KronosPing::ProbeSize, BytesSent, *Target.Address))
+	{
+		Target.SendTimes[ProbeIdx] = Now;
+	}
+
+	else
+	{
+		// Treat unsendable probes as lost.
+		Target.SendTimes[ProbeIdx] = -1.0;
+	}
+}
+
+void FKronosPingProbe::ReceiveAnswers(const double Now)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	TSharedRef<FInternetAddr> SourceAddress = SocketSubsystem->CreateInternetAddr();
+
+	uint8 Buffer[KronosPing::ProbeSize];
+	int32 BytesRead = 0;
+
+	for (int32 PacketIdx = 0; PacketIdx < KronosPing::MaxPacketsPerTick; PacketIdx++)
+	{
+		if (!Socket->RecvFrom(Buffer, KronosPing::ProbeSize, BytesRead, *SourceAddress))
+		{
+			break;
+		}
+
+		if (BytesRead != KronosPing::ProbeSize || KronosPing::ReadUInt32(Buffer) != KronosPing::ProbeMagic || KronosPing::ReadUInt32(Buffer + 4) != Nonce)
+		{
+			continue;
+		}
+
+		const int32 TargetIdx = KronosPing::ReadUInt16(Buffer + 8);
+		const int32 ProbeIdx = KronosPing::ReadUInt16(Buffer + 10);
+		if (!Targets.IsValidIndex(TargetIdx) || ProbeIdx >= Targets[TargetIdx].NumSent)
+		{
+			continue;
+		}
+
+		FTarget& Target = Targets[TargetIdx];
+		const double SendTime = Target.SendTimes[ProbeIdx];
+		if (SendTime <= 0.0)
+		{
+			continue; // Duplicate answer, or the probe failed to send.
+		}
+
+		const double RoundTripTime = Now - SendTime;
+		Target.BestRoundTripTime = Target.BestRoundTripTime < 0.0 ? RoundTripTime : FMath::Min(Target.BestRoundTripTime, RoundTripTime);
+		Target.SendTimes[ProbeIdx] = 0.0;
+		Target.NumReceived++;
+	}
+}
+
+bool FKronosPingProbe::AllTargetsComplete() const
+{
+	const double Now = FPlatformTime::Seconds();
+	for (const FTarget& Target : Targets)
+	{
+		if (Target.NumReceived >= NumProbesPerTarget)
+		{
+			continue;
+		}
+
+		// The target is complete if every probe was sent and the last one had time to be answered.
+		const bool bAllSent = Target.NumSent >= NumProbesPerTarget;
+		const double LastSendTime = Target.SendTimes[Target.NumSent - 1];
+		if (!bAllSent || (LastSendTime > 0.0 && Now - LastSendTime < ProbeInterval))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+
+void KronosPing::RunLoopbackTest(const int32 NumTargets, const int32 NumProbesPerTarget)
+{
+	UE_LOG(LogKronos, Log, TEXT("Running ping loopback test with %d targets and %d probes per target..."), NumTargets, NumProbesPerTarget);
+
+	FKronosPingResponder Responder = FKronosPingResponder();
+	if (!Responder.Start(0, true, false))
+	{
+		UE_LOG(LogKronos, Error, TEXT("  Failed to start the loopback responder."));
+		return;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	FKronosPingProbe Probe = FKronosPingProbe();
+	for (int32 Idx = 0; Idx < NumTargets; Idx++)
+	{
+		TSharedRef<FInternetAddr> TargetAddress = SocketSubsystem->CreateInternetAddr();
+		TargetAddress->SetLoopbackAddress();
+		TargetAddress->SetPort(Responder.GetPort());
+
+		Probe.AddTarget(TargetAddress);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (!Probe.Start(NumProbesPerTarget, 1.0f))
+	{
+		UE_LOG(LogKronos, Error, TEXT("  Failed to start probing."));
+		return;
+	}
+
+	do
+	{
+		Responder.ProcessProbes();
+		FPlatformProcess::SleepNoStats(0.0005f);
+	}
+	while (!Probe.Tick());
+
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	for (int32 Idx = 0; Idx < Probe.NumTargets(); Idx++)
+	{
+		UE_LOG(LogKronos, Log, TEXT("  Target %d: %d ms"), Idx, Probe.GetPingInMs(Idx));
+	}
+
+	UE_LOG(LogKronos, Log, TEXT("  %d/%d targets answered in %.3f ms."), Probe.NumAnsweredTargets(), Probe.NumTargets(), ElapsedTime * 1000.0);
+}
+
+#endif
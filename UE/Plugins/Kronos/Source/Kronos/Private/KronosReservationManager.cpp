@@ -61,6 +61,16 @@ bool UKronosReservationManager::InitReservationBeaconHost(const int32 MaxReserva
 					KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationManager: Registering host reservations..."));
 					RegisterHostReservations();
 
+					// Answer ping probes next to the beacon so that matchmaking clients can measure their ping to us.
+					if (GetDefault<UKronosConfig>()->bPingSearchResults)
+					{
+						PingResponder = MakeUnique<FKronosPingResponder>();
+						if (!PingResponder->Start(ReservationBeaconListener->GetListenPort() + GetDefault<UKronosConfig>()->PingPortOffset))
+						{
+							PingResponder.Reset();
+						}
+					}
+
 					KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationManager: Reservation host beacon initialized."));
 					return true;
 				}
@@ -86,6 +96,8 @@ void UKronosReservationManager::DestroyReservationBeacons()
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosReservationManager: Destroying reservation beacons..."));
 
+	PingResponder.Reset();
+
 	if (ReservationBeaconHost)
 	{
 		ReservationBeaconHost->Destroy();
@@ -296,10 +308,8 @@ void UKronosReservationManager::RegisterHostReservations()
 		HostReservations.Emplace(PlayerRes);
 	}
 
-	for (const FKronosReservation& Res : HostReservations)
-	{
-		ReservationBeaconHost->RegisterReservation(Res);
-	}
+	TArray<EKronosReservationCompleteResult> Results;
+	ReservationBeaconHost->RegisterReservations(HostReservations, Results);
 	
 	// Reset the array because these are single use only. 
 	HostReservations.Empty();
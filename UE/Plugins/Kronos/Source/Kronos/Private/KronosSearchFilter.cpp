@@ -0,0 +1,529 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#include "KronosSearchFilter.h"
+#include "Kronos.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+
+namespace KronosSearchFilter
+{
+	/** Compare two values with the given comparison op. */
+	template<typename ValueType>
+	static bool CompareValues(const ValueType& SessionValue, const ValueType& QueryValue, const EOnlineComparisonOp::Type ComparisonOp)
+	{
+		switch (ComparisonOp)
+		{
+		case EOnlineComparisonOp::Equals:
+			return SessionValue == QueryValue;
+		case EOnlineComparisonOp::NotEquals:
+			return SessionValue != QueryValue;
+		case EOnlineComparisonOp::GreaterThan:
+			return SessionValue > QueryValue;
+		case EOnlineComparisonOp::GreaterThanEquals:
+			return SessionValue >= QueryValue;
+		case EOnlineComparisonOp::LessThan:
+			return SessionValue < QueryValue;
+		case EOnlineComparisonOp::LessThanEquals:
+			return SessionValue <= QueryValue;
+		default:
+			return false;
+		}
+	}
+
+	/** Compare the value of a session setting against the given query value. */
+	template<typename ValueType>
+	static bool CompareData(const FVariantData& SessionData, const FVariantData& QueryData, const EOnlineComparisonOp::Type ComparisonOp)
+	{
+		ValueType SessionValue;
+		SessionData.GetValue(SessionValue);
+
+		ValueType QueryValue;
+		QueryData.GetValue(QueryValue);
+
+		return CompareValues(SessionValue, QueryValue, ComparisonOp);
+	}
+}
+
+FKronosSearchFilter::FKronosSearchFilter() :
+	Instructions(TArray<FInstruction>()),
+	LocalPlayerId(nullptr),
+	IgnoredSessions(TSet<FUniqueNetIdRepl>()),
+	PlayersToCheckForBans(TArray<TPair<uint32, FString>>()),
+	BannedPlayersCache(TMap<FUniqueNetIdRepl, FKronosBannedPlayers>())
+{}
+
+void FKronosSearchFilter::Compile(const FName InSessionName, const FKronosSearchParams& InParams, const FUniqueNetIdPtr& InLocalPlayerId, const TArray<FUniqueNetIdRepl>& InPlayersToCheckForBans)
+{
+	Reset();
+
+	LocalPlayerId = InLocalPlayerId;
+
+	for (const FUniqueNetIdRepl& IgnoredSession : InParams.IgnoredSessions)
+	{
+		if (IgnoredSession.IsValid())
+		{
+			IgnoredSessions.Add(IgnoredSession);
+		}
+	}
+
+	if (BannedPlayersCache.Num() > MaxBannedPlayersCacheSize)
+	{
+		BannedPlayersCache.Empty();
+	}
+
+	// Filters for any search type:
+	{
+		Instructions.Emplace(EInstruction::NotOwnSession);
+
+		if (IgnoredSessions.Num() > 0)
+		{
+			Instructions.Emplace(EInstruction::NotIgnoredSession);
+		}
+
+		Instructions.Emplace(EInstruction::DataEquals, SETTING_SESSIONTYPE, FVariantData(InSessionName.ToString()));
+	}
+
+	// Filters for specific session queries:
+	if (InParams.IsSpecificSessionQuery())
+	{
+		if (InParams.SpecificSessionQuery.Type == EKronosSpecificSessionQueryType::SessionOwnerId)
+		{
+			Instructions.Emplace(EInstruction::DataEquals, SETTING_OWNERID, FVariantData(InParams.SpecificSessionQuery.UniqueId.ToString()));
+		}
+	}
+
+	// Filters for regular searches:
+	else
+	{
+		Instructions.Emplace(EInstruction::NotHidden, SETTING_HIDDEN);
+
+		if (InParams.MinSlotsRequired > 0)
+		{
+			Instructions.Emplace(EInstruction::MinSlots, NAME_None, FVariantData(), EOnlineComparisonOp::Equals, InParams.MinSlotsRequired);
+		}
+
+		if (!InParams.Playlist.IsEmpty())
+		{
+			Instructions.Emplace(EInstruction::DataEquals, SETTING_PLAYLIST, FVariantData(InParams.Playlist));
+		}
+
+		if (!InParams.MapName.IsEmpty())
+		{
+			Instructions.Emplace(EInstruction::DataEquals, SETTING_MAPNAME, FVariantData(InParams.MapName));
+		}
+
+		if (!InParams.GameMode.IsEmpty())
+		{
+			Instructions.Emplace(EInstruction::DataEquals, SETTING_GAMEMODE, FVariantData(InParams.GameMode));
+		}
+
+		if (!InParams.bSkipEloChecks)
+		{
+			Instructions.Emplace(EInstruction::IntAtLeast, SETTING_SESSIONELO, FVariantData(), EOnlineComparisonOp::GreaterThanEquals, FMath::Max(InParams.Elo - InParams.EloRange, 0));
+			Instructions.Emplace(EInstruction::IntAtMost, SETTING_SESSIONELO2, FVariantData(), EOnlineComparisonOp::LessThanEquals, InParams.Elo + InParams.EloRange);
+		}
+
+		for (const FUniqueNetIdRepl& PlayerId : InPlayersToCheckForBans)
+		{
+			if (PlayerId.IsValid())
+			{
+				const FString PlayerIdString = PlayerId.ToString();
+				PlayersToCheckForBans.Emplace(FKronosBannedPlayers::HashPlayerId(PlayerIdString), PlayerIdString);
+			}
+		}
+
+		if (PlayersToCheckForBans.Num() > 0)
+		{
+			Instructions.Emplace(EInstruction::NotBanned, SETTING_BANNEDPLAYERS);
+		}
+	}
+
+	// Extra query settings.
+	for (const FKronosQuerySetting& ExtraQuery : InParams.ExtraQuerySettings)
+	{
+		Instructions.Emplace(EInstruction::QuerySetting, ExtraQuery.Key, ExtraQuery.Data, ExtraQuery.ComparisonOp);
+	}
+
+	// Order instructions by cost. Plain field reads go first, then numeric setting compares, and string compares last.
+	// The sort is stable so instructions of the same cost keep the order they were added in.
+	auto GetInstructionCost = [](const FInstruction& Instruction) -> int32
+	{
+		const bool bStringCompare = Instruction.Data.GetType() == EOnlineKeyValuePairDataType::String;
+		return static_cast<int32>(Instruction.Type) * 2 + (bStringCompare ? 1 : 0);
+	};
+
+	Instructions.StableSort([&GetInstructionCost](const FInstruction& A, const FInstruction& B)
+	{
+		return GetInstructionCost(A) < GetInstructionCost(B);
+	});
+}
+
+void FKronosSearchFilter::Reset()
+{
+	Instructions.Reset();
+	LocalPlayerId.Reset();
+	IgnoredSessions.Reset();
+	PlayersToCheckForBans.Reset();
+}
+
+bool FKronosSearchFilter::PassesFilter(const FOnlineSessionSearchResult& InSearchResult) const
+{
+	if (!InSearchResult.IsValid())
+	{
+		UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - Session is invalid."));
+		return false;
+	}
+
+	for (const FInstruction& Instruction : Instructions)
+	{
+		if (!ExecuteInstruction(Instruction, InSearchResult))
+		{
+			UE_LOG(LogKronos, Verbose, TEXT("Result: Invalid - %s"), *DescribeInstruction(Instruction));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FKronosSearchFilter::ExecuteInstruction(const FInstruction& Instruction, const FOnlineSessionSearchResult& InSearchResult) const
+{
+	const FOnlineSession& Session = InSearchResult.Session;
+
+	switch (Instruction.Type)
+	{
+	case EInstruction::MinSlots:
+		return Session.NumOpenPublicConnections >= Instruction.IntValue;
+
+	case EInstruction::NotOwnSession:
+		return Session.OwningUserId != LocalPlayerId;
+
+	case EInstruction::NotIgnoredSession:
+		return !IgnoredSessions.Contains(FUniqueNetIdRepl(Session.OwningUserId)) && !IgnoredSessions.Contains(FUniqueNetIdRepl(Session.SessionInfo->GetSessionId().AsShared()));
+
+	case EInstruction::NotHidden:
+	{
+		// The setting is stored as an int32 because the Steam Subsystem doesn't support bool queries.
+		const FOnlineSessionSetting* Setting = Session.SessionSettings.Settings.Find(Instruction.Key);
+		if (Setting)
+		{
+			if (Setting->Data.GetType() == EOnlineKeyValuePairDataType::Bool)
+			{
+				bool bHidden = false;
+				Setting->Data.GetValue(bHidden);
+				return !bHidden;
+			}
+
+			int32 Hidden = 0;
+			Setting->Data.GetValue(Hidden);
+			return Hidden == 0;
+		}
+
+		return true;
+	}
+
+	case EInstruction::IntAtLeast:
+	case EInstruction::IntAtMost:
+	{
+		int32 Value = 0;
+		const FOnlineSessionSetting* Setting = Session.SessionSettings.Settings.Find(Instruction.Key);
+		if (Setting)
+		{
+			Setting->Data.GetValue(Value);
+		}
+
+		return Instruction.Type == EInstruction::IntAtLeast ? Value >= Instruction.IntValue : Value <= Instruction.IntValue;
+	}
+
+	case EInstruction::DataEquals:
+	{
+		// FVariantData compares strings in place, so no copies are made here.
+		const FOnlineSessionSetting* Setting = Session.SessionSettings.Settings.Find(Instruction.Key);
+		return Setting && Setting->Data == Instruction.Data;
+	}
+
+	case EInstruction::QuerySetting:
+	{
+		const FOnlineSessionSetting* Setting = Session.SessionSettings.Settings.Find(Instruction.Key);
+		if (!Setting)
+		{
+			return false;
+		}
+
+		switch (Instruction.Data.GetType())
+		{
+		case EOnlineKeyValuePairDataType::Int32:
+			return KronosSearchFilter::CompareData<int32>(Setting->Data, Instruction.Data, Instruction.ComparisonOp);
+		case EOnlineKeyValuePairDataType::Float:
+			return KronosSearchFilter::CompareData<float>(Setting->Data, Instruction.Data, Instruction.ComparisonOp);
+		case EOnlineKeyValuePairDataType::Bool:
+			return KronosSearchFilter::CompareData<bool>(Setting->Data, Instruction.Data, Instruction.ComparisonOp);
+		case EOnlineKeyValuePairDataType::String:
+			if (Instruction.ComparisonOp == EOnlineComparisonOp::Equals)
+			{
+				return Setting->Data == Instruction.Data;
+			}
+			if (Instruction.ComparisonOp == EOnlineComparisonOp::NotEquals)
+			{
+				return !(Setting->Data == Instruction.Data);
+			}
+			return KronosSearchFilter::CompareData<FString>(Setting->Data, Instruction.Data, Instruction.ComparisonOp);
+		default:
+			return false;
+		}
+	}
+
+	case EInstruction::NotBanned:
+	{
+		const FOnlineSessionSetting* Setting = Session.SessionSettings.Settings.Find(Instruction.Key);
+		if (!Setting || Setting->Data.GetType() != EOnlineKeyValuePairDataType::String)
+		{
+			return true;
+		}
+
+		return !IsAnyPlayerBanned(Session, Setting->Data);
+	}
+
+	default:
+		return false;
+	}
+}
+
+FString FKronosSearchFilter::DescribeInstruction(const FInstruction& Instruction) const
+{
+	switch (Instruction.Type)
+	{
+	case EInstruction::MinSlots:
+		return FString::Printf(TEXT("Not enough slots in session (%d required)."), Instruction.IntValue);
+	case EInstruction::NotOwnSession:
+		return TEXT("Session is our own.");
+	case EInstruction::NotIgnoredSession:
+		return TEXT("Session is in the ignored sessions list.");
+	case EInstruction::NotHidden:
+		return TEXT("Session is hidden.");
+	case EInstruction::IntAtLeast:
+		return FString::Printf(TEXT("%s is lower than %d."), *Instruction.Key.ToString(), Instruction.IntValue);
+	case EInstruction::IntAtMost:
+		return FString::Printf(TEXT("%s is higher than %d."), *Instruction.Key.ToString(), Instruction.IntValue);
+	case EInstruction::DataEquals:
+		return FString::Printf(TEXT("%s didn't match '%s'."), *Instruction.Key.ToString(), *Instruction.Data.ToString());
+	case EInstruction::QuerySetting:
+		return FString::Printf(TEXT("%s extra query setting auto-comparison returned false (%s %s)."), *Instruction.Key.ToString(), EOnlineComparisonOp::ToString(Instruction.ComparisonOp), *Instruction.Data.ToString());
+	case EInstruction::NotBanned:
+		return TEXT("A player is banned from the session.");
+	default:
+		return TEXT("Unknown instruction.");
+	}
+}
+
+bool FKronosSearchFilter::IsAnyPlayerBanned(const FOnlineSession& Session, const FVariantData& BannedPlayersData) const
+{
+	// The cached set is only rebuilt if the value of the setting changed since the session was last filtered.
+	FKronosBannedPlayers& BannedPlayers = BannedPlayersCache.FindOrAdd(FUniqueNetIdRepl(Session.SessionInfo->GetSessionId().AsShared()));
+	BannedPlayers.Update(BannedPlayersData);
+
+	if (BannedPlayers.Num() > 0)
+	{
+		for (const TPair<uint32, FString>& PlayerId : PlayersToCheckForBans)
+		{
+			if (BannedPlayers.ContainsByHash(PlayerId.Key, PlayerId.Value))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void FKronosSearchFilter::DumpInstructions() const
+{
+	UE_LOG(LogKronos, Log, TEXT("  SearchFilter: %s"), Instructions.Num() > 0 ? TEXT("") : TEXT("-"));
+	for (int32 Idx = 0; Idx < Instructions.Num(); Idx++)
+	{
+		UE_LOG(LogKronos, Log, TEXT("    %d. Fails when: %s"), Idx, *DescribeInstruction(Instructions[Idx]));
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+/** Minimal session info used by the synthetic search results of the benchmark. */
+class FKronosBenchmarkSessionInfo : public FOnlineSessionInfo
+{
+public:
+
+	FKronosBenchmarkSessionInfo(const FString& InSessionId) :
+		SessionId(FUniqueNetIdString::Create(InSessionId, NAME_None))
+	{}
+
+	virtual const uint8* GetBytes() const override { return nullptr; }
+	virtual int32 GetSize() const override { return sizeof(FKronosBenchmarkSessionInfo); }
+	virtual bool IsValid() const override { return true; }
+	virtual FString ToString() const override { return SessionId->ToString(); }
+	virtual FString ToDebugString() const override { return SessionId->ToDebugString(); }
+	virtual const FUniqueNetId& GetSessionId() const override { return *SessionId; }
+
+private:
+
+	FUniqueNetIdRef SessionId;
+};
+
+void FKronosSearchFilter::RunBenchmark(const int32 NumResults)
+{
+	UE_LOG(LogKronos, Log, TEXT("Running search filter benchmark with %d synthetic search results..."), NumResults);
+
+	FRandomStream RandomStream = FRandomStream(420);
+
+	FUniqueNetIdRepl LocalPlayerId = FUniqueNetIdRepl(FUniqueNetIdString::Create(TEXT("LocalPlayer"), NAME_None));
+
+	TArray<FUniqueNetIdRepl> PartyPlayerIds;
+	for (int32 Idx = 0; Idx < 8; Idx++)
+	{
+		PartyPlayerIds.Add(FUniqueNetIdRepl(FUniqueNetIdString::Create(FString::Printf(TEXT("PartyPlayer%d"), Idx), NAME_None)));
+	}
+
+	FKronosSearchParams SearchParams = FKronosSearchParams();
+	SearchParams.Playlist = TEXT("Ranked");
+	SearchParams.MapName = TEXT("Map_A");
+	SearchParams.GameMode = TEXT("Deathmatch");
+	SearchParams.MinSlotsRequired = PartyPlayerIds.Num();
+	SearchParams.Elo = 1000;
+	SearchParams.EloRange = 150;
+	SearchParams.ExtraQuerySettings.Add(FKronosQuerySetting(FName(TEXT("REGION")), FString(TEXT("EU")), EOnlineComparisonOp::Equals));
+	SearchParams.ExtraQuerySettings.Add(FKronosQuerySetting(FName(TEXT("VERSION")), 7, EOnlineComparisonOp::GreaterThanEquals));
+
+	// Generate search results. Most of them pass the filter, the rest fail at various stages.
+	TArray<FOnlineSessionSearchResult> SearchResults;
+	SearchResults.Reserve(NumResults);
+
+	for (int32 Idx = 0; Idx < NumResults; Idx++)
+	{
+		FOnlineSessionSearchResult& SearchResult = SearchResults.AddDefaulted_GetRef();
+		SearchResult.Session.OwningUserId = FUniqueNetIdString::Create(FString::Printf(TEXT("Owner%d"), Idx), NAME_None);
+		SearchResult.Session.OwningUserName = FString::Printf(TEXT("Owner%d"), Idx);
+		SearchResult.Session.SessionInfo = MakeShareable(new FKronosBenchmarkSessionInfo(FString::Printf(TEXT("Session%d"), Idx)));
+		SearchResult.Session.SessionSettings.NumPublicConnections = 16;
+		SearchResult.Session.NumOpenPublicConnections = RandomStream.RandRange(0, 16);
+
+		FOnlineSessionSettings& Settings = SearchResult.Session.SessionSettings;
+		Settings.Set(SETTING_SESSIONTYPE, NAME_GameSession.ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_OWNERID, SearchResult.Session.OwningUserId->ToString(), EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_HIDDEN, RandomStream.FRand() < 0.05f ? 1 : 0, EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_PLAYLIST, FString(RandomStream.FRand() < 0.9f ? TEXT("Ranked") : TEXT("Casual")), EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_MAPNAME, FString(RandomStream.FRand() < 0.9f ? TEXT("Map_A") : TEXT("Map_B")), EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_GAMEMODE, FString(TEXT("Deathmatch")), EOnlineDataAdvertisementType::ViaOnlineService);
+
+		const int32 SessionElo = RandomStream.RandRange(700, 1300);
+		Settings.Set(SETTING_SESSIONELO, SessionElo, EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(SETTING_SESSIONELO2, SessionElo, EOnlineDataAdvertisementType::ViaOnlineService);
+
+		FString BannedPlayers;
+		const int32 NumBannedPlayers = RandomStream.RandRange(0, 32);
+		for (int32 BanIdx = 0; BanIdx < NumBannedPlayers; BanIdx++)
+		{
+			BannedPlayers.Appendf(TEXT("%sBannedPlayer%d"), BanIdx > 0 ? TEXT(";") : TEXT(""), RandomStream.RandRange(0, 10000));
+		}
+		Settings.Set(SETTING_BANNEDPLAYERS, BannedPlayers, EOnlineDataAdvertisementType::ViaOnlineService);
+
+		Settings.Set(FName(TEXT("REGION")), FString(TEXT("EU")), EOnlineDataAdvertisementType::ViaOnlineService);
+		Settings.Set(FName(TEXT("VERSION")), 7, EOnlineDataAdvertisementType::ViaOnlineService);
+	}
+
+	// Reference filter. Resolves every setting by name and copies every string, the way search results used to be filtered.
+	auto ReferenceFilter = [&](const FOnlineSessionSearchResult& SearchResult) -> bool
+	{
+		if (!SearchResult.IsValid() || SearchResult.Session.OwningUserId == LocalPlayerId.GetUniqueNetId())
+		{
+			return false;
+		}
+
+		FString SessionType;
+		SearchResult.Session.SessionSettings.Get(SETTING_SESSIONTYPE, SessionType);
+		if (SessionType != NAME_GameSession.ToString())
+		{
+			return false;
+		}
+
+		int32 Hidden = 0;
+		SearchResult.Session.SessionSettings.Get(SETTING_HIDDEN, Hidden);
+		if (Hidden != 0 || SearchResult.Session.NumOpenPublicConnections < SearchParams.MinSlotsRequired)
+		{
+			return false;
+		}
+
+		FString Playlist, MapName, GameMode;
+		SearchResult.Session.SessionSettings.Get(SETTING_PLAYLIST, Playlist);
+		SearchResult.Session.SessionSettings.Get(SETTING_MAPNAME, MapName);
+		SearchResult.Session.SessionSettings.Get(SETTING_GAMEMODE, GameMode);
+		if (Playlist != SearchParams.Playlist || MapName != SearchParams.MapName || GameMode != SearchParams.GameMode)
+		{
+			return false;
+		}
+
+		int32 SessionElo = 0, SessionElo2 = 0;
+		SearchResult.Session.SessionSettings.Get(SETTING_SESSIONELO, SessionElo);
+		SearchResult.Session.SessionSettings.Get(SETTING_SESSIONELO2, SessionElo2);
+		if (SessionElo < FMath::Max(SearchParams.Elo - SearchParams.EloRange, 0) || SessionElo2 > SearchParams.Elo + SearchParams.EloRange)
+		{
+			return false;
+		}
+
+		FString BannedPlayers;
+		SearchResult.Session.SessionSettings.Get(SETTING_BANNEDPLAYERS, BannedPlayers);
+		TArray<FString> BannedPlayersArray;
+		if (BannedPlayers.ParseIntoArray(BannedPlayersArray, TEXT(";")) > 0)
+		{
+			for (const FUniqueNetIdRepl& PartyPlayerId : PartyPlayerIds)
+			{
+				if (BannedPlayersArray.Contains(PartyPlayerId.ToString()))
+				{
+					return false;
+				}
+			}
+		}
+
+		for (const FKronosQuerySetting& ExtraQuery : SearchParams.ExtraQuerySettings)
+		{
+			const FOnlineSessionSetting* Setting = SearchResult.Session.SessionSettings.Settings.Find(ExtraQuery.Key);
+			if (!Setting)
+			{
+				return false;
+			}
+
+			const bool bValid = ExtraQuery.Data.GetType() == EOnlineKeyValuePairDataType::String ? ExtraQuery.CompareAgainst<FString>(Setting) : ExtraQuery.CompareAgainst<int32>(Setting);
+			if (!bValid)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	int32 NumReferencePassed = 0;
+	const double ReferenceStartTime = FPlatformTime::Seconds();
+	for (const FOnlineSessionSearchResult& SearchResult : SearchResults)
+	{
+		NumReferencePassed += ReferenceFilter(SearchResult) ? 1 : 0;
+	}
+	const double ReferenceTime = FPlatformTime::Seconds() - ReferenceStartTime;
+
+	int32 NumCompiledPassed = 0;
+	const double CompileStartTime = FPlatformTime::Seconds();
+	FKronosSearchFilter SearchFilter = FKronosSearchFilter();
+	SearchFilter.Compile(NAME_GameSession, SearchParams, LocalPlayerId.GetUniqueNetId(), PartyPlayerIds);
+	const double CompiledStartTime = FPlatformTime::Seconds();
+	for (const FOnlineSessionSearchResult& SearchResult : SearchResults)
+	{
+		NumCompiledPassed += SearchFilter.PassesFilter(SearchResult) ? 1 : 0;
+	}
+	const double CompiledTime = FPlatformTime::Seconds() - CompiledStartTime;
+	const double CompileTime = CompiledStartTime - CompileStartTime;
+
+	UE_LOG(LogKronos, Log, TEXT("  Reference filter: %.3f ms (%.1f ns/result), %d passed"), ReferenceTime * 1000.0, ReferenceTime * 1e9 / FMath::Max(NumResults, 1), NumReferencePassed);
+	UE_LOG(LogKronos, Log, TEXT("  Compiled filter:  %.3f ms (%.1f ns/result), %d passed, compiled in %.3f ms"), CompiledTime * 1000.0, CompiledTime * 1e9 / FMath::Max(NumResults, 1), NumCompiledPassed, CompileTime * 1000.0);
+	UE_LOG(LogKronos, Log, TEXT("  Speedup: %.2fx"), CompiledTime > 0.0 ? ReferenceTime / CompiledTime : 0.0);
+	UE_CLOG(NumReferencePassed != NumCompiledPassed, LogKronos, Warning, TEXT("  Filter results differ between the reference and compiled filters!"));
+}
+
+#endif
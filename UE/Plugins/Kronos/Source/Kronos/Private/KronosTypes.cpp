@@ -144,6 +144,59 @@ FKronosSearchParams::FKronosSearchParams(const FKronosMatchmakingParams& InMatch
 	IgnoredSessions = InMatchmakingParams.IgnoredSessions;
 }
 
+FKronosBannedPlayers::FKronosBannedPlayers() :
+	SourceData(FVariantData()),
+	BannedPlayerIds(TSet<FString>())
+{}
+
+bool FKronosBannedPlayers::Update(const FVariantData& InBannedPlayersData)
+{
+	// FVariantData compares strings in place, so an unchanged setting costs a single string compare.
+	if (SourceData == InBannedPlayersData)
+	{
+		return false;
+	}
+
+	SourceData = InBannedPlayersData;
+	BannedPlayerIds.Reset();
+
+	if (SourceData.GetType() == EOnlineKeyValuePairDataType::String)
+	{
+		FString BannedPlayers;
+		SourceData.GetValue(BannedPlayers);
+
+		// The expected format is "uniqueid1;uniqueid2;uniqueid3".
+		TArray<FString> BannedPlayersArray;
+		if (BannedPlayers.ParseIntoArray(BannedPlayersArray, TEXT(";")) > 0)
+		{
+			BannedPlayerIds.Reserve(BannedPlayersArray.Num());
+			for (FString& BannedPlayerId : BannedPlayersArray)
+			{
+				BannedPlayerIds.Add(MoveTemp(BannedPlayerId));
+			}
+		}
+	}
+
+	return true;
+}
+
+void FKronosBannedPlayers::Reset()
+{
+	SourceData.Empty();
+	BannedPlayerIds.Reset();
+}
+
+bool FKronosBannedPlayers::Contains(const FUniqueNetId& PlayerId) const
+{
+	if (BannedPlayerIds.Num() == 0)
+	{
+		return false;
+	}
+
+	const FString PlayerIdString = PlayerId.ToString();
+	return BannedPlayerIds.ContainsByHash(HashPlayerId(PlayerIdString), PlayerIdString);
+}
+
 FKronosOnlineFriend::FKronosOnlineFriend()
 {
 	UserId = FUniqueNetIdRepl();
@@ -8,6 +8,15 @@
 #include "OnlineSubsystem.h"
 #include "Interfaces/OnlineIdentityInterface.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Interfaces/OnlinePresenceInterface.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+/** Version of the friends list snapshot format. Snapshots with a different version are ignored. */
+#define FRIENDS_LIST_SNAPSHOT_VERSION 1
 
 #define LOCTEXT_NAMESPACE "Kronos"
 static const FText AuthError_IdentityInterfaceInvalid = LOCTEXT("AuthError_IdentityInterfaceInvalid", "The IdentityInterface of the Online Subsystem was invalid.");
@@ -43,6 +52,45 @@ UKronosUserManager* UKronosUserManager::Get(const UObject* WorldContextObject)
 	return nullptr;
 }
 
+void UKronosUserManager::Initialize()
+{
+	// Keep the cached friends lists up to date with the online subsystem.
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (FriendsInterface.IsValid())
+	{
+		FriendsChangeDelegateHandle = FriendsInterface->AddOnFriendsChangeDelegate_Handle(0, FOnFriendsChangeDelegate::CreateUObject(this, &ThisClass::OnFriendsChange));
+		FriendRemovedDelegateHandle = FriendsInterface->AddOnFriendRemovedDelegate_Handle(FOnFriendRemovedDelegate::CreateUObject(this, &ThisClass::OnFriendRemoved));
+		InviteAcceptedDelegateHandle = FriendsInterface->AddOnInviteAcceptedDelegate_Handle(FOnInviteAcceptedDelegate::CreateUObject(this, &ThisClass::OnInviteAccepted));
+	}
+
+	IOnlinePresencePtr PresenceInterface = OnlineSubsystem ? OnlineSubsystem->GetPresenceInterface() : nullptr;
+	if (PresenceInterface.IsValid())
+	{
+		PresenceReceivedDelegateHandle = PresenceInterface->AddOnPresenceReceivedDelegate_Handle(FOnPresenceReceivedDelegate::CreateUObject(this, &ThisClass::OnPresenceReceived));
+	}
+}
+
+void UKronosUserManager::Deinitialize()
+{
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (FriendsInterface.IsValid())
+	{
+		FriendsInterface->ClearOnFriendsChangeDelegate_Handle(0, FriendsChangeDelegateHandle);
+		FriendsInterface->ClearOnFriendRemovedDelegate_Handle(FriendRemovedDelegateHandle);
+		FriendsInterface->ClearOnInviteAcceptedDelegate_Handle(InviteAcceptedDelegateHandle);
+	}
+
+	IOnlinePresencePtr PresenceInterface = OnlineSubsystem ? OnlineSubsystem->GetPresenceInterface() : nullptr;
+	if (PresenceInterface.IsValid())
+	{
+		PresenceInterface->ClearOnPresenceReceivedDelegate_Handle(PresenceReceivedDelegateHandle);
+	}
+
+	FriendsListCaches.Empty();
+}
+
 bool UKronosUserManager::AuthenticateUser()
 {
 	KRONOS_LOG(LogKronos, Log, COLOR_DARK_CYAN, TEXT("KronosUserManager: Authenticating user..."));
@@ -81,6 +129,20 @@ bool UKronosUserManager::AuthenticateUser()
 	// Notification that user authentication is starting.
 	OnUserAuthStarted(!bIsAuthenticated);
 
+	// Only keep the results that can be reused. Platform login is always redone.
+	uint32 ReusableAuthTasks = 0;
+	for (uint8 TaskIdx = 0; TaskIdx < static_cast<uint8>(EKronosUserAuthTask::Num); TaskIdx++)
+	{
+		if (CanReuseAuthTask(static_cast<EKronosUserAuthTask>(TaskIdx)))
+		{
+			ReusableAuthTasks |= 1 << TaskIdx;
+		}
+	}
+
+	CompletedAuthTasks &= ReusableAuthTasks & ~InvalidAuthTasks;
+	StartedAuthTasks = CompletedAuthTasks;
+	InvalidAuthTasks = 0;
+
 	LastAuthTaskStartTime = GetWorld()->GetTimeSeconds();
 	ChangeAuthState(EKronosUserAuthState::PlatformLogin);
 
@@ -94,11 +156,140 @@ bool UKronosUserManager::AuthenticateUser()
 	}
 #endif
 
-	// User auth flow is: PlatformLogin -> ReadUserFiles -> CustomAuthTasks (implemented by end user of plugin) -> Auth complete.
-	PlatformLogin();
+	// User auth flow is: PlatformLogin -> ReadUserFiles + ReadFriendsList + CustomAuthTasks (implemented by end user of plugin) -> Auth complete.
+	RunAuthTasks();
 	return true;
 }
 
+uint32 UKronosUserManager::GetAuthTaskPrerequisites(EKronosUserAuthTask Task) const
+{
+	switch (Task)
+	{
+	case EKronosUserAuthTask::PlatformLogin:
+		return 0;
+	default:
+		return 1 << static_cast<uint8>(EKronosUserAuthTask::PlatformLogin);
+	}
+}
+
+bool UKronosUserManager::CanReuseAuthTask(EKronosUserAuthTask Task) const
+{
+	switch (Task)
+	{
+	case EKronosUserAuthTask::ReadUserFiles:
+	case EKronosUserAuthTask::ReadFriendsList:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void UKronosUserManager::RunAuthTasks()
+{
+	if (!bAuthInProgress)
+	{
+		return;
+	}
+
+	const uint32 AllAuthTasks = (1 << static_cast<uint8>(EKronosUserAuthTask::Num)) - 1;
+	if (CompletedAuthTasks == AllAuthTasks)
+	{
+		// Will be delayed if the current auth state was displayed for less than the configured min task time.
+		// This is so that the user can see what is happening properly.
+		BeginAuthTaskLatent(FTimerDelegate::CreateLambda([this]()
+		{
+			OnUserAuthComplete(EKronosUserAuthCompleteResult::Success, !bIsAuthenticated, FText::GetEmpty());
+		}));
+
+		return;
+	}
+
+	for (uint8 TaskIdx = 0; TaskIdx < static_cast<uint8>(EKronosUserAuthTask::Num); TaskIdx++)
+	{
+		const EKronosUserAuthTask Task = static_cast<EKronosUserAuthTask>(TaskIdx);
+		const uint32 TaskBit = 1 << TaskIdx;
+		const uint32 Prerequisites = GetAuthTaskPrerequisites(Task);
+
+		if ((StartedAuthTasks & TaskBit) == 0 && (CompletedAuthTasks & Prerequisites) == Prerequisites)
+		{
+			StartedAuthTasks |= TaskBit;
+			BeginAuthTask(Task);
+
+			// The task may have failed immediately.
+			if (!bAuthInProgress)
+			{
+				return;
+			}
+		}
+	}
+
+	UpdateAuthState();
+}
+
+void UKronosUserManager::BeginAuthTask(EKronosUserAuthTask Task)
+{
+	switch (Task)
+	{
+	case EKronosUserAuthTask::PlatformLogin:
+		PlatformLogin();
+		break;
+	case EKronosUserAuthTask::ReadUserFiles:
+		ReadUserFiles(*GetUserId());
+		break;
+	case EKronosUserAuthTask::ReadFriendsList:
+		PrefetchFriendsList();
+		break;
+	case EKronosUserAuthTask::CustomAuthTasks:
+		BeginCustomAuthTasks();
+		break;
+	}
+}
+
+void UKronosUserManager::CompleteAuthTask(EKronosUserAuthTask Task, bool bIsResultValid)
+{
+	const uint32 TaskBit = 1 << static_cast<uint8>(Task);
+	if (!bAuthInProgress || (CompletedAuthTasks & TaskBit) != 0)
+	{
+		return;
+	}
+
+	CompletedAuthTasks |= TaskBit;
+	if (!bIsResultValid)
+	{
+		InvalidAuthTasks |= TaskBit;
+	}
+
+	RunAuthTasks();
+}
+
+void UKronosUserManager::UpdateAuthState()
+{
+	const uint32 PendingAuthTasks = StartedAuthTasks & ~CompletedAuthTasks;
+
+	// Display the first task that is still in progress. Prefetching the friends list has no auth state of its own.
+	EKronosUserAuthState NewAuthState = CurrentAuthState;
+	if (PendingAuthTasks & (1 << static_cast<uint8>(EKronosUserAuthTask::PlatformLogin)))
+	{
+		NewAuthState = EKronosUserAuthState::PlatformLogin;
+	}
+
+	else if (PendingAuthTasks & (1 << static_cast<uint8>(EKronosUserAuthTask::ReadUserFiles)))
+	{
+		NewAuthState = EKronosUserAuthState::ReadUserFiles;
+	}
+
+	else if (PendingAuthTasks & (1 << static_cast<uint8>(EKronosUserAuthTask::CustomAuthTasks)))
+	{
+		NewAuthState = EKronosUserAuthState::CustomAuthTask;
+	}
+
+	if (NewAuthState != CurrentAuthState)
+	{
+		LastAuthTaskStartTime = GetWorld()->GetTimeSeconds();
+		ChangeAuthState(NewAuthState);
+	}
+}
+
 void UKronosUserManager::OnUserAuthStarted(bool bIsInitialAuth)
 {
 	K2_OnUserAuthStarted(bIsInitialAuth);
@@ -195,17 +386,18 @@ void UKronosUserManager::OnPlatformLoginComplete(int32 LocalUserNum, bool bWasSu
 		return;
 	}
 
-	// Go to the next auth state.
-	// Will be delayed if the current auth task finished earlier then the configured min task time.
-	// This is so that the user can see what is happening properly.
-	BeginAuthTaskLatent(FTimerDelegate::CreateLambda([this]()
+	// Results of the previous authentication can't be reused if a different user has logged in.
+	const FUniqueNetIdRepl LoggedInUserId = FUniqueNetIdRepl(UserId.AsShared());
+	if (AuthTasksUserId != LoggedInUserId)
 	{
-		LastAuthTaskStartTime = GetWorld()->GetTimeSeconds();
-		ChangeAuthState(EKronosUserAuthState::ReadUserFiles);
+		CompletedAuthTasks = 0;
+		StartedAuthTasks = 1 << static_cast<uint8>(EKronosUserAuthTask::PlatformLogin);
+		AuthTasksUserId = LoggedInUserId;
+		ClearFriendsListCaches();
+	}
 
-		const FUniqueNetId& UserId = *GetUserId();
-		ReadUserFiles(UserId);
-	}));
+	// Start the tasks that depend on platform login.
+	CompleteAuthTask(EKronosUserAuthTask::PlatformLogin);
 }
 
 void UKronosUserManager::ReadUserFiles(const FUniqueNetId& UserId)
@@ -224,21 +416,43 @@ void UKronosUserManager::OnReadUserFilesComplete(bool bWasSuccessful, const FUni
 	UE_LOG(LogKronos, Verbose, TEXT("OnReadUserFilesComplete with result: %s"), bWasSuccessful ? TEXT("Success") : TEXT("Failure"));
 	UE_CLOG(!ErrorStr.IsEmpty(), LogKronos, Verbose, TEXT("ErrorStr: %s"), *ErrorStr);
 
+	// Authentication may have already failed in another task.
+	if (!bAuthInProgress)
+	{
+		return;
+	}
+
 	if (!bWasSuccessful)
 	{
 		OnUserAuthComplete(EKronosUserAuthCompleteResult::ReadUserFilesFailed, !bIsAuthenticated, AuthError_ReadUserFilesFailed);
 		return;
 	}
 
-	// Go to the next auth state.
-	// Will be delayed if the current auth task finished earlier then the configured min task time.
-	// This is so that the user can see what is happening properly.
-	BeginAuthTaskLatent(FTimerDelegate::CreateLambda([this]()
+	CompleteAuthTask(EKronosUserAuthTask::ReadUserFiles);
+}
+
+void UKronosUserManager::PrefetchFriendsList()
+{
+	UE_LOG(LogKronos, Verbose, TEXT("Prefetching friends list..."));
+
+	// Answer friend queries from the last known friends list until the read is complete.
+	LoadFriendsListSnapshot();
+
+	const FOnReadFriendsListComplete CompletionDelegate = FOnReadFriendsListComplete::CreateUObject(this, &ThisClass::OnPrefetchFriendsListComplete);
+	if (!ReadFriendsList(EFriendsLists::ToString(EFriendsLists::Default), CompletionDelegate))
 	{
-		LastAuthTaskStartTime = GetWorld()->GetTimeSeconds();
-		ChangeAuthState(EKronosUserAuthState::CustomAuthTask);
-		BeginCustomAuthTasks();
-	}));
+		// Not every online subsystem supports friends. This is not a reason to fail authentication.
+		CompleteAuthTask(EKronosUserAuthTask::ReadFriendsList, false);
+	}
+}
+
+void UKronosUserManager::OnPrefetchFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr)
+{
+	UE_LOG(LogKronos, Verbose, TEXT("OnPrefetchFriendsListComplete with result: %s"), bWasSuccessful ? TEXT("Success") : TEXT("Failure"));
+	UE_CLOG(!ErrorStr.IsEmpty(), LogKronos, Verbose, TEXT("ErrorStr: %s"), *ErrorStr);
+
+	// The friends list is read again during the next authentication if this failed.
+	CompleteAuthTask(EKronosUserAuthTask::ReadFriendsList, bWasSuccessful);
 }
 
 void UKronosUserManager::BeginCustomAuthTasks_Implementation()
@@ -250,13 +464,19 @@ void UKronosUserManager::BeginCustomAuthTasks_Implementation()
 
 void UKronosUserManager::OnCustomAuthTasksComplete(bool bWasSuccessful, const FText& ErrorText)
 {
+	// Authentication may have already failed in another task.
+	if (!bAuthInProgress)
+	{
+		return;
+	}
+
 	if (!bWasSuccessful)
 	{
 		OnUserAuthComplete(EKronosUserAuthCompleteResult::CustomAuthTaskFailed, !bIsAuthenticated, ErrorText);
 		return;
 	}
 
-	OnUserAuthComplete(EKronosUserAuthCompleteResult::Success, !bIsAuthenticated, FText::GetEmpty());
+	CompleteAuthTask(EKronosUserAuthTask::CustomAuthTasks);
 }
 
 void UKronosUserManager::OnUserAuthComplete(EKronosUserAuthCompleteResult Result, bool bWasInitialAuth, const FText& ErrorText)
@@ -380,6 +600,11 @@ void UKronosUserManager::OnUserLogoutComplete(bool bWasSuccessful)
 	bLogoutInProgress = false;
 	bIsAuthenticated = false;
 
+	// The next user has to go through every auth task.
+	CompletedAuthTasks = 0;
+	AuthTasksUserId = FUniqueNetIdRepl();
+	ClearFriendsListCaches();
+
 	K2_OnUserLogoutComplete(bWasSuccessful);
 }
 
@@ -429,15 +654,35 @@ bool UKronosUserManager::ReadFriendsList(const FString& ListName, const FOnReadF
 	if (!FriendsInterface.IsValid())
 	{
 		UE_LOG(LogKronos, Warning, TEXT("FriendsInterface invalid (current Online Subsystem may not support it)."));
+		RemoveFriendsListSnapshot(ListName);
 		CompletionDelegate.ExecuteIfBound(0, false, ListName, TEXT("FriendsInterface invalid."));
 		return false;
 	}
 
-	return FriendsInterface->ReadFriendsList(0, ListName, CompletionDelegate);
+	const FOnReadFriendsListComplete ReadFriendsListDelegate = FOnReadFriendsListComplete::CreateUObject(this, &ThisClass::OnReadFriendsListComplete, CompletionDelegate);
+	if (!FriendsInterface->ReadFriendsList(0, ListName, ReadFriendsListDelegate))
+	{
+		RemoveFriendsListSnapshot(ListName);
+		return false;
+	}
+
+	return true;
 }
 
 bool UKronosUserManager::GetFriendsList(const FString& ListName, TArray<FKronosOnlineFriend>& OutFriends)
 {
+	const FKronosFriendsListCache* FriendsListCache = FriendsListCaches.Find(ListName);
+	if (FriendsListCache)
+	{
+		OutFriends.Reserve(OutFriends.Num() + FriendsListCache->Friends.Num());
+		for (const TPair<FUniqueNetIdRepl, FKronosOnlineFriend>& Friend : FriendsListCache->Friends)
+		{
+			OutFriends.Add(Friend.Value);
+		}
+
+		return true;
+	}
+
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
 	if (!FriendsInterface.IsValid())
@@ -463,17 +708,30 @@ bool UKronosUserManager::GetFriendsList(const FString& ListName, TArray<FKronosO
 
 FKronosOnlineFriend UKronosUserManager::GetFriend(const FUniqueNetId& FriendId, const FString& ListName)
 {
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
-	if (!FriendsInterface.IsValid())
+	if (!FriendId.IsValid())
 	{
-		UE_LOG(LogKronos, Warning, TEXT("KronosUserManager: GetFriend failed - FriendsInterface invalid (current Online Subsystem may not support it)."));
+		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: GetFriend failed - FriendId is invalid."));
 		return FKronosOnlineFriend();
 	}
 
-	if (!FriendId.IsValid())
+	const FKronosFriendsListCache* FriendsListCache = FriendsListCaches.Find(ListName);
+	if (FriendsListCache)
 	{
-		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: GetFriend failed - FriendId is invalid."));
+		const FKronosOnlineFriend* CachedFriend = FriendsListCache->Friends.Find(FUniqueNetIdRepl(FriendId.AsShared()));
+		if (!CachedFriend)
+		{
+			UE_LOG(LogKronos, Error, TEXT("KronosUserManager: GetFriend failed - Could not find friend in cached friends list."));
+			return FKronosOnlineFriend();
+		}
+
+		return *CachedFriend;
+	}
+
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (!FriendsInterface.IsValid())
+	{
+		UE_LOG(LogKronos, Warning, TEXT("KronosUserManager: GetFriend failed - FriendsInterface invalid (current Online Subsystem may not support it)."));
 		return FKronosOnlineFriend();
 	}
 
@@ -489,6 +747,12 @@ FKronosOnlineFriend UKronosUserManager::GetFriend(const FUniqueNetId& FriendId,
 
 int32 UKronosUserManager::GetFriendCount(const FString& ListName) const
 {
+	const FKronosFriendsListCache* FriendsListCache = FriendsListCaches.Find(ListName);
+	if (FriendsListCache)
+	{
+		return FriendsListCache->Friends.Num();
+	}
+
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
 	if (!FriendsInterface.IsValid())
@@ -505,17 +769,24 @@ int32 UKronosUserManager::GetFriendCount(const FString& ListName) const
 
 bool UKronosUserManager::IsFriend(const FUniqueNetId& FriendId, const FString& ListName) const
 {
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
-	if (!FriendsInterface.IsValid())
+	if (!FriendId.IsValid())
 	{
-		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: IsFriend failed - FriendsInterface invalid (current Online Subsystem may not support it)."));
+		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: IsFriend failed - FriendId is invalid."));
 		return false;
 	}
 
-	if (!FriendId.IsValid())
+	// Snapshots may be out of date, so they are only used for display. Gameplay decisions (e.g. following a party) rely on this.
+	const FKronosFriendsListCache* FriendsListCache = FriendsListCaches.Find(ListName);
+	if (FriendsListCache && !FriendsListCache->bIsSnapshot)
 	{
-		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: IsFriend failed - FriendId is invalid."));
+		return FriendsListCache->Friends.Contains(FUniqueNetIdRepl(FriendId.AsShared()));
+	}
+
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (!FriendsInterface.IsValid())
+	{
+		UE_LOG(LogKronos, Error, TEXT("KronosUserManager: IsFriend failed - FriendsInterface invalid (current Online Subsystem may not support it)."));
 		return false;
 	}
 
@@ -541,6 +812,260 @@ bool UKronosUserManager::SendSessionInviteToFriend(FName InSessionName, const FU
 	return SessionInterface->SendSessionInviteToFriend(0, InSessionName, FriendId);
 }
 
+void UKronosUserManager::OnReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr, FOnReadFriendsListComplete CompletionDelegate)
+{
+	if (bWasSuccessful)
+	{
+		UpdateFriendsListCache(ListName);
+		SaveFriendsListSnapshot();
+	}
+
+	// The snapshot couldn't be confirmed, so it can't be trusted anymore.
+	else
+	{
+		RemoveFriendsListSnapshot(ListName);
+	}
+
+	CompletionDelegate.ExecuteIfBound(LocalUserNum, bWasSuccessful, ListName, ErrorStr);
+}
+
+void UKronosUserManager::UpdateFriendsListCache(const FString& ListName)
+{
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (!FriendsInterface.IsValid())
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FOnlineFriend>> OnlineFriends = TArray<TSharedRef<FOnlineFriend>>();
+	if (!FriendsInterface->GetFriendsList(0, ListName, OnlineFriends))
+	{
+		// Let queries fall back to the friends interface.
+		FriendsListCaches.Remove(ListName);
+		return;
+	}
+
+	FKronosFriendsListCache& FriendsListCache = FriendsListCaches.FindOrAdd(ListName);
+	FriendsListCache.Friends.Reset();
+	FriendsListCache.Friends.Reserve(OnlineFriends.Num());
+	FriendsListCache.bIsSnapshot = false;
+
+	for (const TSharedRef<FOnlineFriend>& OnlineFriend : OnlineFriends)
+	{
+		FriendsListCache.Friends.Add(FUniqueNetIdRepl(OnlineFriend->GetUserId()), FKronosOnlineFriend(*OnlineFriend));
+	}
+
+	UE_LOG(LogKronos, Verbose, TEXT("KronosUserManager: Cached %d friends of list '%s'."), FriendsListCache.Friends.Num(), *ListName);
+}
+
+void UKronosUserManager::ClearFriendsListCaches()
+{
+	FriendsListCaches.Empty();
+}
+
+void UKronosUserManager::RemoveFriendsListSnapshot(const FString& ListName)
+{
+	const FKronosFriendsListCache* FriendsListCache = FriendsListCaches.Find(ListName);
+	if (FriendsListCache && FriendsListCache->bIsSnapshot)
+	{
+		UE_LOG(LogKronos, Verbose, TEXT("KronosUserManager: Dropping friends list snapshot of list '%s'."), *ListName);
+		FriendsListCaches.Remove(ListName);
+	}
+}
+
+void UKronosUserManager::OnFriendsChange()
+{
+	// The online subsystem has already updated its own friends lists, so we can rebuild ours without reading them again.
+	// Snapshots are replaced as well. If the online subsystem doesn't have the list, the snapshot is dropped.
+	TArray<FString> CachedListNames;
+	FriendsListCaches.GetKeys(CachedListNames);
+
+	for (const FString& ListName : CachedListNames)
+	{
+		UpdateFriendsListCache(ListName);
+	}
+}
+
+void UKronosUserManager::OnFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId)
+{
+	const FUniqueNetIdRepl FriendKey = FUniqueNetIdRepl(FriendId.AsShared());
+	for (TPair<FString, FKronosFriendsListCache>& FriendsListCache : FriendsListCaches)
+	{
+		FriendsListCache.Value.Friends.Remove(FriendKey);
+	}
+}
+
+void UKronosUserManager::OnInviteAccepted(const FUniqueNetId& UserId, const FUniqueNetId& FriendId)
+{
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineFriendsPtr FriendsInterface = OnlineSubsystem ? OnlineSubsystem->GetFriendsInterface() : nullptr;
+	if (!FriendsInterface.IsValid())
+	{
+		return;
+	}
+
+	// Only add the new friend to the lists that it belongs to.
+	for (TPair<FString, FKronosFriendsListCache>& FriendsListCache : FriendsListCaches)
+	{
+		TSharedPtr<FOnlineFriend> OnlineFriend = FriendsInterface->GetFriend(0, FriendId, FriendsListCache.Key);
+		if (OnlineFriend.IsValid())
+		{
+			FriendsListCache.Value.Friends.Add(FUniqueNetIdRepl(OnlineFriend->GetUserId()), FKronosOnlineFriend(*OnlineFriend));
+		}
+	}
+}
+
+void UKronosUserManager::OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence)
+{
+	const FUniqueNetIdRepl FriendKey = FUniqueNetIdRepl(UserId.AsShared());
+	for (TPair<FString, FKronosFriendsListCache>& FriendsListCache : FriendsListCaches)
+	{
+		FKronosOnlineFriend* CachedFriend = FriendsListCache.Value.Friends.Find(FriendKey);
+		if (CachedFriend)
+		{
+			CachedFriend->bIsOnline = Presence->bIsOnline;
+			CachedFriend->bIsInGame = Presence->bIsPlayingThisGame;
+		}
+	}
+}
+
+FString UKronosUserManager::GetFriendsListSnapshotPath() const
+{
+	FUniqueNetIdPtr UserId = GetUserId();
+	if (!UserId.IsValid())
+	{
+		return TEXT("");
+	}
+
+	// Hash the user id, since some online subsystems use characters that are not valid in file names.
+	const FString FileName = FString::Printf(TEXT("FriendsList_%s.sav"), *FMD5::HashAnsiString(*UserId->ToString()));
+	return FPaths::ProjectSavedDir() / TEXT("Kronos") / FileName;
+}
+
+void UKronosUserManager::SaveFriendsListSnapshot() const
+{
+	if (!GetDefault<UKronosConfig>()->bSaveFriendsListSnapshot)
+	{
+		return;
+	}
+
+	const FString SnapshotPath = GetFriendsListSnapshotPath();
+	if (SnapshotPath.IsEmpty())
+	{
+		return;
+	}
+
+	FBufferArchive Ar = FBufferArchive();
+
+	int32 Version = FRIENDS_LIST_SNAPSHOT_VERSION;
+	int32 NumLists = FriendsListCaches.Num();
+	Ar << Version;
+	Ar << NumLists;
+
+	for (const TPair<FString, FKronosFriendsListCache>& FriendsListCache : FriendsListCaches)
+	{
+		FString ListName = FriendsListCache.Key;
+		int32 NumFriends = FriendsListCache.Value.Friends.Num();
+		Ar << ListName;
+		Ar << NumFriends;
+
+		for (const TPair<FUniqueNetIdRepl, FKronosOnlineFriend>& Friend : FriendsListCache.Value.Friends)
+		{
+			FString FriendId = Friend.Key.ToString();
+			FString FriendName = Friend.Value.UserName;
+			Ar << FriendId;
+			Ar << FriendName;
+		}
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Ar, *SnapshotPath))
+	{
+		UE_LOG(LogKronos, Warning, TEXT("KronosUserManager: Failed to save friends list snapshot to '%s'."), *SnapshotPath);
+	}
+}
+
+void UKronosUserManager::LoadFriendsListSnapshot()
+{
+	if (!GetDefault<UKronosConfig>()->bSaveFriendsListSnapshot)
+	{
+		return;
+	}
+
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	IOnlineIdentityPtr IdentityInterface = OnlineSubsystem ? OnlineSubsystem->GetIdentityInterface() : nullptr;
+	if (!IdentityInterface.IsValid())
+	{
+		return;
+	}
+
+	const FString SnapshotPath = GetFriendsListSnapshotPath();
+	TArray<uint8> SnapshotData = TArray<uint8>();
+	if (SnapshotPath.IsEmpty() || !FFileHelper::LoadFileToArray(SnapshotData, *SnapshotPath, FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Ar = FMemoryReader(SnapshotData);
+
+	int32 Version = 0;
+	int32 NumLists = 0;
+	Ar << Version;
+	Ar << NumLists;
+
+	if (Version != FRIENDS_LIST_SNAPSHOT_VERSION)
+	{
+		UE_LOG(LogKronos, Verbose, TEXT("KronosUserManager: Ignoring friends list snapshot with version %d."), Version);
+		return;
+	}
+
+	// Parse the whole snapshot first, so that a corrupted file doesn't leave half of a list behind.
+	TMap<FString, FKronosFriendsListCache> SnapshotCaches = TMap<FString, FKronosFriendsListCache>();
+	for (int32 ListIdx = 0; ListIdx < NumLists && !Ar.IsError(); ListIdx++)
+	{
+		FString ListName = FString();
+		int32 NumFriends = 0;
+		Ar << ListName;
+		Ar << NumFriends;
+
+		FKronosFriendsListCache& SnapshotCache = SnapshotCaches.FindOrAdd(ListName);
+		SnapshotCache.bIsSnapshot = true;
+
+		for (int32 FriendIdx = 0; FriendIdx < NumFriends && !Ar.IsError(); FriendIdx++)
+		{
+			FString FriendIdStr = FString();
+			FString FriendName = FString();
+			Ar << FriendIdStr;
+			Ar << FriendName;
+
+			FUniqueNetIdPtr FriendId = IdentityInterface->CreateUniquePlayerId(FriendIdStr);
+			if (FriendId.IsValid())
+			{
+				FKronosOnlineFriend CachedFriend = FKronosOnlineFriend();
+				CachedFriend.UserId = FUniqueNetIdRepl(FriendId);
+				CachedFriend.UserName = FriendName;
+				SnapshotCache.Friends.Add(CachedFriend.UserId, CachedFriend);
+			}
+		}
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogKronos, Warning, TEXT("KronosUserManager: Friends list snapshot at '%s' is corrupted."), *SnapshotPath);
+		return;
+	}
+
+	for (TPair<FString, FKronosFriendsListCache>& SnapshotCache : SnapshotCaches)
+	{
+		if (!FriendsListCaches.Contains(SnapshotCache.Key))
+		{
+			FriendsListCaches.Add(SnapshotCache.Key, MoveTemp(SnapshotCache.Value));
+		}
+	}
+
+	UE_LOG(LogKronos, Verbose, TEXT("KronosUserManager: Loaded %d friends lists from snapshot."), SnapshotCaches.Num());
+}
+
 UWorld* UKronosUserManager::GetWorld() const
 {
 	// We don't care about the CDO because it's not relevant to world checks.
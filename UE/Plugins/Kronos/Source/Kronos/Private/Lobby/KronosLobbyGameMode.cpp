@@ -46,9 +46,17 @@ void AKronosLobbyGameMode::InitializeLobby()
 			NumPlayersRequired = GameSession->MaxPlayers;
 		}
 
+		// React to player changes right away instead of checking the players every tick.
+		LobbyGameState->OnPlayerConnectedToLobby.AddDynamic(this, &ThisClass::OnPlayerConnectedToLobby);
+		LobbyGameState->OnPlayerDisconnectedFromLobby.AddDynamic(this, &ThisClass::OnPlayerDisconnectedFromLobby);
+		LobbyGameState->OnNumReadyPlayersChanged.AddDynamic(this, &ThisClass::OnNumReadyPlayersChanged);
+
 		SetLobbyState(EKronosLobbyState::WaitingForPlayers);
 
 		GetWorldTimerManager().SetTimer(TimerHandle_TickLobby, this, &ThisClass::TickLobby, 1.0, true);
+
+		// Players may have joined before the lobby was initialized.
+		UpdateLobbyState();
 		return;
 	}
 
@@ -59,9 +67,6 @@ void AKronosLobbyGameMode::TickLobby()
 {
 	switch (LobbyState)
 	{
-	case EKronosLobbyState::WaitingForPlayers:
-		HandleWaitingForPlayers();
-		break;
 	case EKronosLobbyState::WaitingToStart:
 		HandleWaitingToStart();
 		break;
@@ -73,41 +78,75 @@ void AKronosLobbyGameMode::TickLobby()
 	K2_TickLobby();
 }
 
+void AKronosLobbyGameMode::UpdateLobbyState()
+{
+	switch (LobbyState)
+	{
+	case EKronosLobbyState::WaitingForPlayers:
+		HandleWaitingForPlayers();
+		break;
+	case EKronosLobbyState::WaitingToStart:
+	case EKronosLobbyState::StartingMatch:
+		// Not enough players are present, return to waiting for players.
+		if (LobbyGameState->GetNumPlayers() < GetNumPlayersRequired())
+		{
+			SetLobbyState(EKronosLobbyState::WaitingForPlayers);
+			break;
+		}
+
+		// All players are ready, start final countdown.
+		if (LobbyState == EKronosLobbyState::WaitingToStart && LobbyGameState->IsEveryPlayerReady())
+		{
+			SetLobbyState(EKronosLobbyState::StartingMatch, LobbyFinalCountdownTime);
+		}
+		break;
+	}
+}
+
+void AKronosLobbyGameMode::RequestUpdateLobbyState()
+{
+	if (!GetWorldTimerManager().TimerExists(TimerHandle_UpdateLobbyState))
+	{
+		TimerHandle_UpdateLobbyState = GetWorldTimerManager().SetTimerForNextTick(this, &ThisClass::UpdateLobbyState);
+	}
+}
+
+void AKronosLobbyGameMode::OnPlayerConnectedToLobby(AKronosLobbyPlayerState* PlayerState)
+{
+	RequestUpdateLobbyState();
+}
+
+void AKronosLobbyGameMode::OnPlayerDisconnectedFromLobby(AKronosLobbyPlayerState* PlayerState)
+{
+	// The player is removed from the player array after this event, so the update must wait until the next frame anyway.
+	RequestUpdateLobbyState();
+}
+
+void AKronosLobbyGameMode::OnNumReadyPlayersChanged(const int32 NumReadyPlayers)
+{
+	RequestUpdateLobbyState();
+}
+
 void AKronosLobbyGameMode::HandleWaitingForPlayers()
 {
 	// Enough players joined the lobby, start match countdown.
 	if (LobbyGameState->GetNumPlayers() >= GetNumPlayersRequired())
 	{
 		SetLobbyState(EKronosLobbyState::WaitingToStart, LobbyCountdownTime);
+
+		// Everyone may be ready already.
+		UpdateLobbyState();
 		return;
 	}
 }
 
 void AKronosLobbyGameMode::HandleWaitingToStart()
 {
-	// Not enough players are present, return to waiting for players.
-	if (LobbyGameState->GetNumPlayers() < GetNumPlayersRequired())
-	{
-		SetLobbyState(EKronosLobbyState::WaitingForPlayers);
-		return;
-	}
-
 	if (!bCountdownOnlyIfEveryoneReady)
 	{
 		// Update lobby countdown time.
 		SetLobbyTimer(LobbyTimer - 1);
 
-		// Lobby timer hasn't reached critical point yet. Waiting for players to ready.
-		if (LobbyTimer > LobbyFinalCountdownTime)
-		{
-			// All players are ready, start final countdown.
-			if (LobbyGameState->IsEveryPlayerReady())
-			{
-				SetLobbyState(EKronosLobbyState::StartingMatch, LobbyFinalCountdownTime);
-				return;
-			}
-		}
-
 		// Lobby timer reached critical point! Force all players ready and start final countdown.
 		if (LobbyTimer <= LobbyFinalCountdownTime)
 		{
@@ -117,27 +156,10 @@ void AKronosLobbyGameMode::HandleWaitingToStart()
 			return;
 		}
 	}
-	
-	else
-	{
-		// All players are ready, start final countdown.
-		if (LobbyGameState->IsEveryPlayerReady())
-		{
-			SetLobbyState(EKronosLobbyState::StartingMatch, LobbyFinalCountdownTime);
-			return;
-		}
-	}
 }
 
 void AKronosLobbyGameMode::HandleStartingMatch()
 {
-	// Not enough players are present, return to waiting for players.
-	if (LobbyGameState->GetNumPlayers() < GetNumPlayersRequired())
-	{
-		SetLobbyState(EKronosLobbyState::WaitingForPlayers);
-		return;
-	}
-
 	// Update lobby countdown time.
 	SetLobbyTimer(LobbyTimer - 1);
 
@@ -195,6 +217,12 @@ void AKronosLobbyGameMode::SetLobbyState(const EKronosLobbyState InLobbyState, c
 	if (InCountdownTime >= 0)
 	{
 		SetLobbyTimer(InCountdownTime);
+
+		// Restart the lobby tick so that the first second of the new countdown is a full second.
+		if (GetWorldTimerManager().TimerExists(TimerHandle_TickLobby))
+		{
+			GetWorldTimerManager().SetTimer(TimerHandle_TickLobby, this, &ThisClass::TickLobby, 1.0, true);
+		}
 	}
 }
 
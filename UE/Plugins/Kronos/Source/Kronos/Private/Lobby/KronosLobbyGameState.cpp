@@ -5,43 +5,44 @@
 #include "Kronos.h"
 #include "GameFramework/PlayerStart.h"
 #include "Net/UnrealNetwork.h"
-#include "UObject/UObjectIterator.h"
+#include "EngineUtils.h"
 
 APlayerStart* AKronosLobbyGameState::FindPlayerStart(const APawn* PlayerPawn)
 {
 	// Lobby pawns will use this to find an unoccupied local or remote player start, where they can be moved to locally.
-
-	// I'd like to improve this later, as this is bit of a "hacky" solution. Since our own pawn (the local) should always be in a fixed spot, we must relocate
-	// players when they spawn in. We'll check each player start if it's occupied or not by checking if it has an owner. If not, we can spawn there. If it is occupied however, we will have to verify it first.
-	// We have to do this because when a player disconnects, the ref to the pawn stored in that PlayerStart is still in memory (until garbage collection). So if a player joins before GC,
-	// existing players will look at the PlayerStart and think that it is occupied (even though it's not), meaning they would fail to relocate the new player.
+	// Since our own pawn (the local) should always be in a fixed spot, we must relocate players when they spawn in.
 
 	if (PlayerPawn)
 	{
-		for (TObjectIterator<APlayerStart> It; It; ++It)
+		if (PlayerStartSlots.Num() == 0)
+		{
+			RegisterPlayerStarts();
+		}
+
+		// The pawn may already occupy a player start.
+		if (const int32* OccupiedSlotIdx = OccupiedPlayerStartSlots.Find(PlayerPawn))
+		{
+			return PlayerStartSlots[*OccupiedSlotIdx].PlayerStart.Get();
+		}
+
+		// Match player start and player pawn type (local or remote).
+		TArray<int32>& FreeSlots = PlayerPawn->IsLocallyControlled() ? FreeLocalPlayerStartSlots : FreeRemotePlayerStartSlots;
+		if (FreeSlots.Num() == 0)
+		{
+			// Pawns of disconnected players don't always release their player start, so check for those before giving up.
+			ReclaimPlayerStarts();
+		}
+
+		while (FreeSlots.Num() > 0)
 		{
-			if (APlayerStart* PlayerStart = *It)
+			const int32 SlotIdx = FreeSlots.Pop(false);
+
+			FKronosLobbyPlayerStartSlot& Slot = PlayerStartSlots[SlotIdx];
+			if (APlayerStart* PlayerStart = Slot.PlayerStart.Get())
 			{
-				// Match player start and player pawn type (local or remote).
-				if ((PlayerStart->PlayerStartTag == LocalPlayerStartTag) == PlayerPawn->IsLocallyControlled())
-				{
-					// Check if the player start is taken by another player.
-					if (!PlayerStart->GetOwner())
-					{
-						// Player start is free, we can relocate the pawn without any issues.
-						return PlayerStart;
-					}
-
-					// Safety measurement. Confirm that the player start is really taken.
-					else
-					{
-						if (!GetWorld()->EncroachingBlockingGeometry(PlayerPawn, PlayerStart->GetActorLocation(), PlayerStart->GetActorRotation()))
-						{
-							// Player start was in fact NOT taken. More info on why this happens above.
-							return PlayerStart;
-						}
-					}
-				}
+				Slot.Occupant = PlayerPawn;
+				OccupiedPlayerStartSlots.Add(PlayerPawn, SlotIdx);
+				return PlayerStart;
 			}
 		}
 	}
@@ -50,22 +51,82 @@ APlayerStart* AKronosLobbyGameState::FindPlayerStart(const APawn* PlayerPawn)
 	return nullptr;
 }
 
-int32 AKronosLobbyGameState::GetNumReadyPlayers() const
+void AKronosLobbyGameState::ReleasePlayerStart(const APawn* PlayerPawn)
+{
+	int32 SlotIdx = INDEX_NONE;
+	if (OccupiedPlayerStartSlots.RemoveAndCopyValue(PlayerPawn, SlotIdx))
+	{
+		FKronosLobbyPlayerStartSlot& Slot = PlayerStartSlots[SlotIdx];
+		Slot.Occupant.Reset();
+
+		(Slot.bIsLocal ? FreeLocalPlayerStartSlots : FreeRemotePlayerStartSlots).Add(SlotIdx);
+	}
+}
+
+void AKronosLobbyGameState::RegisterPlayerStarts()
+{
+	PlayerStartSlots.Reset();
+	FreeLocalPlayerStartSlots.Reset();
+	FreeRemotePlayerStartSlots.Reset();
+	OccupiedPlayerStartSlots.Reset();
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		const bool bIsLocal = It->PlayerStartTag == LocalPlayerStartTag;
+		PlayerStartSlots.Emplace(*It, bIsLocal);
+	}
+
+	// Free slots are popped from the back, so add them in reverse to hand out player starts in level order.
+	for (int32 SlotIdx = PlayerStartSlots.Num() - 1; SlotIdx >= 0; SlotIdx--)
+	{
+		(PlayerStartSlots[SlotIdx].bIsLocal ? FreeLocalPlayerStartSlots : FreeRemotePlayerStartSlots).Add(SlotIdx);
+	}
+
+	UE_LOG(LogKronos, Verbose, TEXT("KronosLobbyGameState: Registered %d local and %d remote player starts."), FreeLocalPlayerStartSlots.Num(), FreeRemotePlayerStartSlots.Num());
+}
+
+void AKronosLobbyGameState::ReclaimPlayerStarts()
 {
-	int32 NumReadyPlayers = 0;
-	for (APlayerState* PlayerState : PlayerArray)
+	for (auto It = OccupiedPlayerStartSlots.CreateIterator(); It; ++It)
 	{
-		AKronosLobbyPlayerState* LobbyPlayerState = Cast<AKronosLobbyPlayerState>(PlayerState);
-		if (LobbyPlayerState)
+		if (!It.Key().IsValid())
 		{
-			if (LobbyPlayerState->GetPlayerIsReady())
-			{
-				NumReadyPlayers++;
-			}
+			const int32 SlotIdx = It.Value();
+			PlayerStartSlots[SlotIdx].Occupant.Reset();
+
+			(PlayerStartSlots[SlotIdx].bIsLocal ? FreeLocalPlayerStartSlots : FreeRemotePlayerStartSlots).Add(SlotIdx);
+			It.RemoveCurrent();
 		}
 	}
+}
+
+void AKronosLobbyGameState::NotifyPlayerIsReadyChanged(AKronosLobbyPlayerState* LobbyPlayerState, const bool bIsReady)
+{
+	// Players who aren't in the player array yet are counted when they are added.
+	if (LobbyPlayers.Contains(LobbyPlayerState))
+	{
+		UpdateReadyPlayer(LobbyPlayerState, bIsReady);
+	}
+}
+
+void AKronosLobbyGameState::UpdateReadyPlayer(AKronosLobbyPlayerState* LobbyPlayerState, const bool bIsReady)
+{
+	const int32 OldNumReadyPlayers = ReadyPlayers.Num();
+
+	if (bIsReady)
+	{
+		ReadyPlayers.Add(LobbyPlayerState);
+	}
+
+	else
+	{
+		ReadyPlayers.Remove(LobbyPlayerState);
+	}
 
-	return NumReadyPlayers;
+	if (ReadyPlayers.Num() != OldNumReadyPlayers)
+	{
+		OnNumReadyPlayersChanged.Broadcast(ReadyPlayers.Num());
+	}
 }
 
 void AKronosLobbyGameState::SetLobbyState(const EKronosLobbyState InLobbyState)
@@ -104,6 +165,9 @@ void AKronosLobbyGameState::AddPlayerState(APlayerState* PlayerState)
 	AKronosLobbyPlayerState* LobbyPlayerState = Cast<AKronosLobbyPlayerState>(PlayerState);
 	if (LobbyPlayerState)
 	{
+		LobbyPlayers.Add(LobbyPlayerState);
+		UpdateReadyPlayer(LobbyPlayerState, LobbyPlayerState->GetPlayerIsReady());
+
 		OnPlayerConnectedToLobby.Broadcast(LobbyPlayerState);
 	}
 }
@@ -113,6 +177,9 @@ void AKronosLobbyGameState::RemovePlayerState(APlayerState* PlayerState)
 	AKronosLobbyPlayerState* LobbyPlayerState = Cast<AKronosLobbyPlayerState>(PlayerState);
 	if (LobbyPlayerState)
 	{
+		LobbyPlayers.Remove(LobbyPlayerState);
+		UpdateReadyPlayer(LobbyPlayerState, false);
+
 		LobbyPlayerState->OnLobbyPlayerDisconnecting.Broadcast();
 		OnPlayerDisconnectedFromLobby.Broadcast(LobbyPlayerState);
 	}
@@ -36,6 +36,18 @@ void AKronosLobbyPawn::BeginPlay()
 	InitPawnLocation();
 }
 
+void AKronosLobbyPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Free our player start so that the next player can take it.
+	AKronosLobbyGameState* LobbyGameState = GetWorld()->GetGameState<AKronosLobbyGameState>();
+	if (LobbyGameState)
+	{
+		LobbyGameState->ReleasePlayerStart(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AKronosLobbyPawn::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
@@ -86,12 +98,10 @@ void AKronosLobbyPawn::InitPawnLocation()
 			// Finding a proper player start for the given player. Since we want our local player to be in a fixed spot, we'll relocate players locally.
 			// Lobby pawns have movement replication disabled, so moving them won't cause any issues over the network.
 
+			// The game state marks the player start as taken by us.
 			APlayerStart* PlayerStart = LobbyGameState->FindPlayerStart(this);
 			if (PlayerStart)
 			{
-				// Make sure to tell the player start that we are taking it.
-				PlayerStart->SetOwner(this);
-
 				// Move the player.
 				SetActorLocationAndRotation(PlayerStart->GetActorLocation(), PlayerStart->GetActorRotation());
 			}
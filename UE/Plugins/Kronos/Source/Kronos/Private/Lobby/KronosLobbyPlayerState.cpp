@@ -1,6 +1,8 @@
 // Copyright 2022-2023 Horizon Games. All Rights Reserved.
 
 #include "Lobby/KronosLobbyPlayerState.h"
+#include "Lobby/KronosLobbyGameState.h"
+#include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
 
 void AKronosLobbyPlayerState::PostInitializeComponents()
@@ -59,8 +61,7 @@ void AKronosLobbyPlayerState::SetPlayerIsReady(bool bReady)
 {
 	if (!HasAuthority())
 	{
-		bIsReady = bReady;
-		OnLobbyPlayerIsReadyChanged.Broadcast(bIsReady);
+		UpdatePlayerIsReady(bReady);
 
 		ServerSetPlayerIsReady(bIsReady);
 		return;
@@ -89,15 +90,28 @@ void AKronosLobbyPlayerState::OnRep_PlayerData()
 	}
 }
 
-void AKronosLobbyPlayerState::OnRep_IsReady()
+void AKronosLobbyPlayerState::UpdatePlayerIsReady(bool bReady)
 {
-	if (bIsReady != bServerIsReady)
+	if (bIsReady != bReady)
 	{
-		bIsReady = bServerIsReady;
+		bIsReady = bReady;
+
+		// Keep the ready player count of the game state up to date.
+		AKronosLobbyGameState* LobbyGameState = GetWorld()->GetGameState<AKronosLobbyGameState>();
+		if (LobbyGameState)
+		{
+			LobbyGameState->NotifyPlayerIsReadyChanged(this, bIsReady);
+		}
+
 		OnLobbyPlayerIsReadyChanged.Broadcast(bIsReady);
 	}
 }
 
+void AKronosLobbyPlayerState::OnRep_IsReady()
+{
+	UpdatePlayerIsReady(bServerIsReady);
+}
+
 void AKronosLobbyPlayerState::OnRep_PlayerName()
 {
 	Super::OnRep_PlayerName();
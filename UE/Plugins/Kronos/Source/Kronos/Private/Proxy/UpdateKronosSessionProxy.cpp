@@ -44,8 +44,11 @@ void UUpdateKronosSessionProxy::Activate()
 				SessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(OnUpdateSessionCompleteDelegateHandle);
 				OnUpdateSessionCompleteDelegateHandle = SessionInterface->AddOnUpdateSessionCompleteDelegate_Handle(OnUpdateSessionCompleteDelegate);
 
-				KronosOnlineSession->UpdateSession(SessionName, SessionSettings, bShouldRefreshOnlineData, ExtraSessionSettings);
-				return;
+				// The completion delegate only fires for updates that were requested successfully.
+				if (KronosOnlineSession->UpdateSession(SessionName, SessionSettings, bShouldRefreshOnlineData, ExtraSessionSettings))
+				{
+					return;
+				}
 			}
 
 		}
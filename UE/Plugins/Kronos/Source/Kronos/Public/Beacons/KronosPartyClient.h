@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "LobbyBeaconClient.h"
 #include "KronosTypes.h"
+#include "Beacons/KronosPartyPlayerState.h"
 #include "KronosPartyClient.generated.h"
 
+/** Max number of player data slots that a client may request. */
+#define MAX_PLAYER_DATA_SLOTS 256
+
 class AKronosPartyState;
 class AKronosPartyPlayerState;
 
@@ -32,6 +36,9 @@ protected:
 	/** Parameters to be used when following the party to a session. */
 	FKronosFollowPartyParams FollowPartyParams;
 
+	/** Handle used to send the player data changes of the current frame to the server together. */
+	FTimerHandle TimerHandle_SendPlayerDataChanges;
+
 public:
 
 	/**
@@ -54,13 +61,31 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation)
 	virtual void ServerSetPlayerElo(const int32 NewPlayerElo);
 
-	/** Changes player data. */
+	/**
+	 * Changes player data.
+	 * On clients, the changes made during the same frame are sent to the server together, and only the changed slots are sent.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Default")
 	virtual void SetPlayerData(const TArray<int32>& NewPlayerData);
 
-	/** Request a player data change with the server. */
+	/**
+	 * Request a player data change with the server.
+	 *
+	 * @param Changes The slots that changed.
+	 * @param NewNum The number of slots after the change.
+	 * @param Sequence Sequence number of the request. Replicated back once applied, so that the client knows which of its changes the server has.
+	 */
 	UFUNCTION(Server, Reliable, WithValidation)
-	virtual void ServerSetPlayerData(const TArray<int32>& NewPlayerData);
+	virtual void ServerUpdatePlayerData(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence);
+
+	/**
+	 * Tell the client that a player data change request was rejected, so that it doesn't wait for the request to be applied.
+	 *
+	 * @param AuthoritativePlayerData The player data of the client on the server.
+	 * @param Sequence Sequence number of the rejected request.
+	 */
+	UFUNCTION(Client, Reliable)
+	virtual void ClientRejectPlayerDataUpdate(const TArray<int32>& AuthoritativePlayerData, const uint32 Sequence);
 
 	/** Send a chat message to all party members. */
 	UFUNCTION(BlueprintCallable, Category = "Default")
@@ -70,9 +95,9 @@ public:
 	UFUNCTION(Server, Reliable)
 	virtual void ServerSendChatMessage(const FString& Msg);
 
-	/** Replicate the chat message to the client. */
+	/** Replicate a batch of chat messages to the client, from oldest to newest. */
 	UFUNCTION(Client, Reliable)
-	virtual void ClientReceiveChatMessage(const FUniqueNetIdRepl& SenderId, const FString& Msg);
+	virtual void ClientReceiveChatMessages(const TArray<FKronosChatMessage>& ChatMessages);
 
 	/** Tell the client to start following the party to the session. */
 	UFUNCTION(Client, Reliable)
@@ -121,6 +146,9 @@ protected:
 	UFUNCTION()
 	virtual void OnPartyUpdated(bool bWasSuccessful);
 
+	/** Send the difference between the local player data and the player data sent last to the server. */
+	virtual void SendPlayerDataChanges();
+
 	/** Called when the client is told by the server to follow the party to a session. */
 	virtual void HandleJoiningGame();
 
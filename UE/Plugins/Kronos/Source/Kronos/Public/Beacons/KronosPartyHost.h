@@ -7,14 +7,48 @@
 #include "KronosTypes.h"
 #include "KronosPartyHost.generated.h"
 
-/** Time delay between checking whether all players have acknowledged the follow party request or not. */
-#define CONNECT_PARTY_TO_GAMESESSION_TICKRATE 0.1f
 /** Time before the party leader ignores all remaining players who haven't acknowledged the follow party request, and starts traveling. */
 #define CONNECT_PARTY_TO_GAMESESSION_TIMEOUT 10.0f
 
 class UKronosPartyManager;
 class AKronosPartyClient;
 class AKronosPartyState;
+struct FKronosPlayerDataChange;
+
+/**
+ * Token bucket limiting how often a party member may send chat messages.
+ */
+struct FKronosChatRateLimit
+{
+	/** Amount of messages that can be sent right now. */
+	float Tokens;
+
+	/** Time when the tokens were last refilled. */
+	double LastRefillTime;
+
+	/** Whether messages are being dropped. Used to warn only once per throttling episode. */
+	bool bIsThrottled;
+
+	/** Default constructor. */
+	FKronosChatRateLimit() :
+		Tokens(0.0f),
+		LastRefillTime(0.0),
+		bIsThrottled(false)
+	{}
+
+	/** Preferred constructor. */
+	FKronosChatRateLimit(const float InTokens, const double InLastRefillTime) :
+		Tokens(InTokens),
+		LastRefillTime(InLastRefillTime),
+		bIsThrottled(false)
+	{}
+};
+
+/**
+ * Delegate triggered when every party member has started following the party leader to the game session.
+ * Also triggered when connecting the party times out, in which case the remaining players are left behind.
+ */
+DECLARE_EVENT(AKronosPartyHost, FOnKronosPartyConnectedToGameSession);
 
 /**
  * A beacon host object that handles party client connections. Exists only on the server!
@@ -32,12 +66,33 @@ public:
 
 protected:
 
-	/** Handle used when connecting the party to a session. */
-	FTimerHandle TimerHandle_ConnectingPartyToGameSession;
-
 	/** Handle used to timeout the attempt of connecting the party to a session. */
 	FTimerHandle TimerHandle_TimeoutConnectingPartyToGameSession;
 
+	/** Whether the party is being connected to a session. */
+	bool bConnectingPartyToGameSession;
+
+	/** Number of party members who haven't started following the party to the session yet. */
+	int32 NumPlayersPendingGameSession;
+
+	/** Event triggered when every party member has started following the party to the session. */
+	FOnKronosPartyConnectedToGameSession PartyConnectedToGameSessionEvent;
+
+	/** Handle used to send the chat messages of the current frame to the clients together. */
+	FTimerHandle TimerHandle_SendChatMessages;
+
+	/** Chat messages waiting to be sent to the clients. */
+	TArray<FKronosChatMessage> PendingChatMessages;
+
+	/** Ring buffer of the most recent chat messages. Sent to players who join the party. */
+	TArray<FKronosChatMessage> ChatHistory;
+
+	/** Index of the oldest message in the chat history once the ring buffer is full. */
+	int32 ChatHistoryHead;
+
+	/** Chat rate limit of each party member. */
+	TMap<FUniqueNetIdRepl, FKronosChatRateLimit> ChatRateLimits;
+
 public:
 
 	/** Handles a player elo change request. */
@@ -46,9 +101,18 @@ public:
 	/** Handles a player data change request for the given client. */
 	virtual void ProcessPlayerDataChange(AKronosPartyClient* ClientActor, const TArray<int32>& NewPlayerData);
 
-	/** Handles the broadcasting of a chat message. */
+	/** Handles a player data change request for individual slots of the given client. */
+	virtual void ProcessPlayerDataChanges(AKronosPartyClient* ClientActor, const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence);
+
+	/**
+	 * Handles the broadcasting of a chat message.
+	 * Messages are rate limited per sender, and the messages of the current frame are sent to the clients together.
+	 */
 	virtual void ProcessChatMessage(const FUniqueNetIdRepl& SenderId, const FString& Msg);
 
+	/** @return The most recent chat messages, from oldest to newest. */
+	virtual TArray<FKronosChatMessage> GetChatHistory() const;
+
 	/** Handles party leader started/stopped matchmaking. */
 	virtual void ProcessPartyLeaderMatchmaking(bool bMatchmaking);
 
@@ -62,13 +126,37 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Default")
 	virtual AKronosPartyState* GetPartyState() const;
 
+	/** @return Whether the party is being connected to a session. */
+	bool IsConnectingPartyToGameSession() const { return bConnectingPartyToGameSession; }
+
+	/** @return The delegate fired when every party member has started following the party to the session. */
+	FOnKronosPartyConnectedToGameSession& OnPartyConnectedToGameSession() { return PartyConnectedToGameSessionEvent; }
+
 protected:
 
 	/** Called when this host beacon is initialized by the party manager. */
 	virtual void OnInitialized();
 
-	/** Called continuously while connecting the party to a session. Checks if all clients have started following the party or not. */
-	virtual void TickConnectingPartyToGameSession();
+	/** Consume a chat token of the given sender. Returns false if the sender is over the rate limit. */
+	virtual bool ConsumeChatToken(const FUniqueNetIdRepl& SenderId);
+
+	/**
+	 * Remove the chat rate limits that have refilled completely. A full bucket is the same as a new one.
+	 * Buckets are kept for their refill period even after the sender left, so that reconnecting doesn't reset the limit.
+	 */
+	virtual void PruneChatRateLimits();
+
+	/** Add a chat message to the chat history. */
+	virtual void AddToChatHistory(const FKronosChatMessage& ChatMessage);
+
+	/** Send the pending chat messages to the clients in a single RPC each. */
+	virtual void SendChatMessages();
+
+	/**
+	 * Called when a party member stops waiting in the party, either because the member started following the party to the session or because the member left.
+	 * Completes connecting the party to the session once no one is left waiting.
+	 */
+	virtual void NotifyPlayerLeftLobby(ALobbyBeaconPlayerState* Player);
 
 	/** Called when all clients have started following the party to the session. */
 	virtual void OnConnectPartyToGameSessionComplete();
@@ -116,6 +204,7 @@ public:
 	virtual bool PreLogin(const FUniqueNetIdRepl& InUniqueId, const FString& Options) override;
 	virtual ALobbyBeaconPlayerState* HandlePlayerLogin(ALobbyBeaconClient* ClientActor, const FUniqueNetIdRepl& InUniqueId, const FString& Options) override;
 	virtual void PostLogin(ALobbyBeaconClient* ClientActor) override;
+	virtual void ProcessJoinServer(ALobbyBeaconClient* ClientActor) override;
 	virtual void NotifyClientDisconnected(AOnlineBeaconClient* LeavingClientActor) override;
 	//~ End ALobbyBeaconHost Interface
 };
@@ -4,9 +4,124 @@
 
 #include "CoreMinimal.h"
 #include "LobbyBeaconPlayerState.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "KronosPartyPlayerState.generated.h"
 
 class AKronosPartyPlayerActor;
+class AKronosPartyPlayerState;
+
+/**
+ * A change of a single player data slot. Sent by party clients to the server instead of the whole player data.
+ */
+USTRUCT()
+struct FKronosPlayerDataChange
+{
+	GENERATED_BODY()
+
+	/** Index of the changed slot. */
+	UPROPERTY()
+	int32 SlotIdx;
+
+	/** New value of the slot. */
+	UPROPERTY()
+	int32 Value;
+
+	/** Default constructor. */
+	FKronosPlayerDataChange() :
+		SlotIdx(0),
+		Value(0)
+	{}
+
+	/** Preferred constructor. */
+	FKronosPlayerDataChange(const int32 InSlotIdx, const int32 InValue) :
+		SlotIdx(InSlotIdx),
+		Value(InValue)
+	{}
+};
+
+/**
+ * A single replicated player data slot.
+ */
+USTRUCT()
+struct FKronosPlayerDataSlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Index of the slot in the player data. */
+	UPROPERTY()
+	int32 SlotIdx;
+
+	/** Value of the slot. */
+	UPROPERTY()
+	int32 Value;
+
+	/** Default constructor. */
+	FKronosPlayerDataSlot() :
+		SlotIdx(0),
+		Value(0)
+	{}
+
+	/** Preferred constructor. */
+	FKronosPlayerDataSlot(const int32 InSlotIdx, const int32 InValue) :
+		SlotIdx(InSlotIdx),
+		Value(InValue)
+	{}
+};
+
+/**
+ * Replicated player data. Only the slots that changed are sent to the clients.
+ * On the server, the slot of each item matches its index in the array. Clients may receive the items in any order.
+ */
+USTRUCT()
+struct KRONOS_API FKronosPlayerDataArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/** The slots of the player data. */
+	UPROPERTY()
+	TArray<FKronosPlayerDataSlot> Items;
+
+	/** The player state that owns the player data. Notified once after each batch of replicated changes. */
+	UPROPERTY(NotReplicated)
+	AKronosPartyPlayerState* OwnerPlayerState;
+
+	/** Default constructor. */
+	FKronosPlayerDataArray() :
+		OwnerPlayerState(nullptr)
+	{}
+
+	/** Set the value of every slot. Only the slots whose value changed are marked for replication. Server only. */
+	void SetValues(const TArray<int32>& NewValues);
+
+	/**
+	 * Apply changes of individual slots. Server only.
+	 *
+	 * @param Changes The slots to change.
+	 * @param NewNum The number of slots after the change. Slots past this number are removed, new slots start at zero.
+	 */
+	void ApplyChanges(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum);
+
+	/** Get the value of every slot, in slot order. */
+	void GetValues(TArray<int32>& OutValues) const;
+
+	//~ Begin FFastArraySerializer Interface
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+	//~ End FFastArraySerializer Interface
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FKronosPlayerDataSlot, FKronosPlayerDataArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FKronosPlayerDataArray> : public TStructOpsTypeTraitsBase2<FKronosPlayerDataArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
 
 /**
  * Delegate triggered when the party player's elo score changes.
@@ -31,15 +146,24 @@ class KRONOS_API AKronosPartyPlayerState : public ALobbyBeaconPlayerState
 {
 	GENERATED_BODY()
 
+public:
+
+	/** Default constructor. */
+	AKronosPartyPlayerState(const FObjectInitializer& ObjectInitializer);
+
 public:
 
 	/** Elo score representing the player's skill level. */
 	UPROPERTY(ReplicatedUsing = OnRep_PlayerElo)
 	int32 PlayerElo;
 
-	/** The replicated player data. */
-	UPROPERTY(ReplicatedUsing = OnRep_PlayerData)
-	TArray<int32> ServerPlayerData;
+	/** The replicated player data. Replicated per slot, so changing a single value doesn't resend the whole player data. */
+	UPROPERTY(Replicated)
+	FKronosPlayerDataArray ServerPlayerData;
+
+	/** Sequence number of the last player data change request applied by the server. */
+	UPROPERTY(ReplicatedUsing = OnRep_PlayerDataSequence)
+	uint32 ServerPlayerDataSequence;
 
 	/**
 	 * An actor representing this player in the world.
@@ -52,6 +176,18 @@ public:
 	/** The local player data. */
 	TArray<int32> PlayerData;
 
+	/** The player data that was last sent to the server by the owning client. Changes are diffed against this. */
+	TArray<int32> LastSentPlayerData;
+
+	/** Sequence number of the last player data change request sent to the server by the owning client. */
+	uint32 LastSentPlayerDataSequence;
+
+	/** Sequence number of the last player data change request of the owning client that the server rejected. */
+	uint32 RejectedPlayerDataSequence;
+
+	/** Whether the owning client has local player data changes that haven't been sent to the server yet. */
+	bool bHasUnsentPlayerDataChanges;
+
 private:
 
 	/** Delegate triggered when the elo score changes for this player. */
@@ -82,6 +218,15 @@ public:
 	 */
 	virtual void ServerSetPlayerData(const TArray<int32>& NewPlayerData);
 
+	/**
+	 * Called when individual player data slots are being set by the server.
+	 *
+	 * Do not call this directly. Use KronosPartyClient::SetPlayerData() instead.
+	 *
+	 * NOTE: This is not an RPC! BeaconPlayerStates don't have RPC capabilities. The transition from client to server is done in the owning KronosPartyClient.
+	 */
+	virtual void ServerApplyPlayerDataChanges(const TArray<FKronosPlayerDataChange>& Changes, const int32 NewNum, const uint32 Sequence);
+
 	/**
 	 * Called by the owning KronosPartyClient before sending the player data to the server.
 	 * We change the player data locally on the client side so that we can see the changes immediately.
@@ -93,6 +238,14 @@ public:
 	 */
 	virtual void ClientSetPlayerData(const TArray<int32>& NewPlayerData);
 
+	/**
+	 * Called on the owning client when the server rejected a player data change request.
+	 * The client stops waiting for the request and resyncs with the authoritative player data.
+	 *
+	 * NOTE: This is not an RPC! The transition from server to client is done in the owning KronosPartyClient.
+	 */
+	virtual void ClientRejectPlayerDataChanges(const TArray<int32>& AuthoritativePlayerData, const uint32 Sequence);
+
 	/**
 	 * Called by the KronosPartyState when a player actor was created or being destroyed for this player.
 	 * The actor is already owned by the player state when this is called.
@@ -157,6 +310,7 @@ protected:
 	virtual void SignalPartyOwnerChanged();
 
 	friend class AKronosPartyHost;
+	friend struct FKronosPlayerDataArray;
 
 protected:
 
@@ -164,10 +318,19 @@ protected:
 	UFUNCTION()
 	virtual void OnRep_PlayerElo();
 
-	/** Called when the player data replicates from the server. */
-	UFUNCTION()
+	/**
+	 * Called when the player data replicates from the server. Called once for each batch of changed slots.
+	 * While the owning client has change requests in flight, the replicated values are older than the local ones and are ignored.
+	 */
 	virtual void OnRep_PlayerData();
 
+	/** Called when the sequence number of the last applied player data change request replicates from the server. */
+	UFUNCTION()
+	virtual void OnRep_PlayerDataSequence();
+
+	/** @return Whether the owning client has player data changes that the server hasn't applied yet. */
+	bool HasPendingPlayerDataChanges() const;
+
 public:
 
 	//~ Begin ALobbyBeaconPlayerState Interface
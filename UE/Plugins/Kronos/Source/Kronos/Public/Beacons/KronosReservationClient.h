@@ -51,6 +51,9 @@ protected:
 	/** Whether a reservation cancel request is in progress. */
 	bool bCancelReservationPending;
 
+	/** Position of the reservation request in the reservation queue of the host. Zero if the request is not queued. */
+	int32 ReservationQueuePosition;
+
 	/** Handle used to time-out a reservation request. */
 	FTimerHandle TimerHandle_TimeoutReservationRequest;
 
@@ -92,6 +95,9 @@ public:
 	/** @return The pending reservation that has been requested. */
 	const FKronosReservation& GetPendingReservation() const { return PendingReservation; }
 
+	/** @return Position of the reservation request in the reservation queue of the host. Zero if the request is not queued. */
+	int32 GetReservationQueuePosition() const { return ReservationQueuePosition; }
+
 protected:
 
 	/** Tell the server to make a reservation. */
@@ -102,6 +108,10 @@ protected:
 	UFUNCTION(Client, Reliable)
 	virtual void ClientReceiveReservationResponse(EKronosReservationCompleteResult Result);
 
+	/** Update from the server while the reservation request is waiting in the reservation queue. */
+	UFUNCTION(Client, Reliable)
+	virtual void ClientReceiveReservationQueuePosition(int32 QueuePosition);
+
 	/** Tell the server to cancel a reservation. */
 	UFUNCTION(Server, Reliable)
 	virtual void ServerCancelReservation(const FKronosReservation& Reservation);
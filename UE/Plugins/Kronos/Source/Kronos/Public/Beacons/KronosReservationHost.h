@@ -9,6 +9,88 @@
 
 class AKronosReservationClient;
 
+/**
+ * Location of a reservation member inside the reservation store of the reservation host.
+ */
+struct FKronosReservationMemberHandle
+{
+	/** Index of the owning reservation. Stays the same until the reservation is removed. */
+	int32 ReservationIdx;
+
+	/** Index of the member inside the owning reservation. */
+	int32 MemberIdx;
+
+	/** Default constructor. */
+	FKronosReservationMemberHandle() :
+		ReservationIdx(INDEX_NONE),
+		MemberIdx(INDEX_NONE)
+	{}
+
+	/** Preferred constructor. */
+	FKronosReservationMemberHandle(const int32 InReservationIdx, const int32 InMemberIdx) :
+		ReservationIdx(InReservationIdx),
+		MemberIdx(InMemberIdx)
+	{}
+};
+
+/**
+ * Pending timeout of a reservation member.
+ */
+struct FKronosReservationTimeout
+{
+	/** World time when the member times out. */
+	double TimeoutTime;
+
+	/** UniqueId of the member. */
+	FUniqueNetIdRepl PlayerId;
+
+	/** Generation of the member's timeout. Only the timeout matching the member's current generation is valid. */
+	uint32 Generation;
+
+	/** Preferred constructor. */
+	FKronosReservationTimeout(const double InTimeoutTime, const FUniqueNetIdRepl& InPlayerId, const uint32 InGeneration) :
+		TimeoutTime(InTimeoutTime),
+		PlayerId(InPlayerId),
+		Generation(InGeneration)
+	{}
+
+	/** Orders the timeouts by time, so that the earliest one is at the top of the heap. */
+	bool operator<(const FKronosReservationTimeout& Other) const
+	{
+		return TimeoutTime < Other.TimeoutTime;
+	}
+};
+
+/**
+ * Reservation request waiting in the reservation queue of the reservation host.
+ */
+struct FKronosQueuedReservationRequest
+{
+	/** The client that requested the reservation. */
+	TWeakObjectPtr<AKronosReservationClient> Client;
+
+	/** The requested reservation. */
+	FKronosReservation Reservation;
+
+	/** World time when the request was queued. */
+	double QueueTime;
+
+	/** Queue position that was last sent to the client. Zero if none has been sent yet. */
+	int32 LastSentQueuePosition;
+
+	/** World time when the queue position was last sent to the client. */
+	double LastSentQueuePositionTime;
+
+	/** Preferred constructor. */
+	FKronosQueuedReservationRequest(AKronosReservationClient* InClient, const FKronosReservation& InReservation, const double InQueueTime) :
+		Client(InClient),
+		Reservation(InReservation),
+		QueueTime(InQueueTime),
+		LastSentQueuePosition(0),
+		LastSentQueuePositionTime(0.0)
+	{}
+};
+
 /**
  * A beacon host used for taking reservations for an existing game session.
  * Intentionally not using the built-in APartyBeaconHost class because even though it's also for taking reservations, it is designed for use with dedicated servers.
@@ -28,8 +110,32 @@ protected:
 	/** Reservation capacity. */
 	int32 MaxNumReservations;
 
-	/** Registered reservations for the session. */
-	TArray<FKronosReservation> Reservations;
+	/** Registered reservations for the session. Removing a reservation doesn't move the others, so their indices can be used as handles. */
+	TSparseArray<FKronosReservation> Reservations;
+
+	/** Location of each reserved player's reservation, for constant time lookups by player id. */
+	TMap<FUniqueNetIdRepl, FKronosReservationMemberHandle> ReservationMemberHandles;
+
+	/** Number of reservation members across all reservations. Kept up to date as reservations are registered and removed. */
+	int32 NumConsumedReservations;
+
+	/**
+	 * Min-heap of the pending reservation timeouts, earliest first.
+	 * Entries are not removed when a reservation is completed or removed. Those are skipped when they expire instead.
+	 */
+	TArray<FKronosReservationTimeout> ReservationTimeouts;
+
+	/** Generation given to the last registered reservation timeout. Never zero once a timeout has been registered. */
+	uint32 LastReservationTimeoutGeneration;
+
+	/** Handle used to process the reservation timeouts when the earliest one expires. */
+	FTimerHandle TimerHandle_ReservationTimeouts;
+
+	/** Reservation requests that haven't been answered yet, in the order they were received. */
+	TArray<FKronosQueuedReservationRequest> ReservationQueue;
+
+	/** Handle used to process the reservation queue at the end of the admission window. */
+	FTimerHandle TimerHandle_ReservationQueue;
 
 public:
 
@@ -45,18 +151,36 @@ public:
 	 */
 	virtual bool ReconfigureMaxReservations(const int32 InMaxReservations);
 
-	/** Handle a reservation request received from an incoming client. */
+	/**
+	 * Handle a reservation request received from an incoming client.
+	 * The request is queued and answered at the end of the admission window, unless the admission window is disabled.
+	 */
 	virtual void ProcessReservationRequest(AKronosReservationClient* Client, const FKronosReservation& InReservation);
 
 	/** Attempts to register a new reservation. */
 	virtual EKronosReservationCompleteResult RegisterReservation(const FKronosReservation& InReservation);
 
+	/**
+	 * Attempts to register multiple reservations in order.
+	 *
+	 * @param InReservations The reservations to register.
+	 * @param OutResults The result of each reservation, in the same order as the reservations.
+	 */
+	virtual void RegisterReservations(const TArray<FKronosReservation>& InReservations, TArray<EKronosReservationCompleteResult>& OutResults);
+
 	/** Handle a reservation cancel request received from an existing client. */
 	virtual void ProcessCancelReservation(AKronosReservationClient* Client, const FKronosReservation& InReservation);
 
 	/** Attempts to remove an existing reservation. */
 	virtual bool RemoveReservation(const FUniqueNetIdRepl& PlayerId);
 
+	/**
+	 * Attempts to remove the existing reservations of multiple players.
+	 *
+	 * @return Number of reservations that were removed.
+	 */
+	virtual int32 RemoveReservations(const TArray<FUniqueNetIdRepl>& PlayerIds);
+
 	/** Completes the reservation of a given player. This means that the player has arrived in the session. */
 	virtual bool CompleteReservation(const FUniqueNetIdRepl& PlayerId);
 
@@ -90,12 +214,22 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Default")
 	virtual int32 GetNumConsumedReservations() const;
 
-	/** Get all registered reservations. */
+	/** Get a copy of all registered reservations. */
 	UFUNCTION(BlueprintPure, Category = "Default")
-	const TArray<FKronosReservation>& GetReservations() const { return Reservations; }
+	TArray<FKronosReservation> GetReservations() const;
 
 protected:
 
+	/**
+	 * Find the reservation member of the given player.
+	 *
+	 * @param PlayerId The player to look for.
+	 * @param OutOwningReservation Set to the owning reservation of the member if the member was found.
+	 *
+	 * @return The reservation member, or nullptr if the player has no reservation. Only valid until reservations are registered or removed.
+	 */
+	FKronosReservationMember* FindReservationMember(const FUniqueNetIdRepl& PlayerId, FKronosReservation** OutOwningReservation = nullptr);
+
 	/**
 	 * Called when this host beacon is initialized by the reservation manager.
 	 * The HostReservations will be registered immediately after this function.
@@ -115,9 +249,36 @@ protected:
 	 */
 	virtual void PreReservationOwnerRemoved(const FUniqueNetIdRepl& OwnerId, const FKronosReservation& Reservation);
 
-	/** Called when a reservation isn't completed in time. Most likely the player hasn't arrived at the session. */
-	UFUNCTION()
-	virtual void TimeoutReservation(const FUniqueNetIdRepl& PlayerId);
+	/**
+	 * Answers the queued reservation requests in one pass.
+	 * The requests that fill the most free slots are registered. Requests that don't fit keep waiting until the queue timeout.
+	 */
+	virtual void ProcessReservationQueue();
+
+	/**
+	 * Choose the reservation requests to admit.
+	 * The default implementation picks the combination of requests that fills the most free slots, preferring requests that arrived earlier.
+	 *
+	 * @param RequestSizes Number of players in each request, in the order the requests were received.
+	 * @param NumFreeSlots Number of reservation slots that are still free.
+	 * @param OutAdmittedIndices Indices of the requests to admit, in ascending order.
+	 */
+	virtual void PackReservationRequests(const TArray<int32>& RequestSizes, const int32 NumFreeSlots, TArray<int32>& OutAdmittedIndices) const;
+
+	/** Send the result of a reservation request to the client. */
+	virtual void SendReservationResponse(AKronosReservationClient* Client, const EKronosReservationCompleteResult Result);
+
+	/** Set the timer of the reservation timeouts to fire when the earliest timeout expires. */
+	virtual void ScheduleReservationTimeouts();
+
+	/** Collects the expired reservation timeouts, and times out the reservations that are still pending. */
+	virtual void ProcessReservationTimeouts();
+
+	/**
+	 * Called when reservations aren't completed in time. Most likely the players haven't arrived at the session.
+	 * Players that have logged in meanwhile keep their reservation.
+	 */
+	virtual void TimeoutReservations(const TArray<FUniqueNetIdRepl>& PlayerIds);
 
 	friend class UKronosReservationManager;
 
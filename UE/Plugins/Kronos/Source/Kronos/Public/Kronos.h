@@ -93,6 +93,12 @@ private:
 	 */
 	void DumpMatchmakingState(UWorld* World) const;
 
+	/**
+	 * [Console command]
+	 * Dump the p50/p95/p99 latency of each matchmaking stage to the console.
+	 */
+	void DumpMatchmakingLatency(const TArray<FString>& Args) const;
+
 	/**
 	 * [Console command]
 	 * Dump current party state to the console.
@@ -116,4 +122,22 @@ private:
 	 * Start the match immediately regardless of lobby state.
 	 */
 	void LobbyStartMatch(UWorld* World) const;
+
+	/**
+	 * [Console command]
+	 * Benchmark the search result filter with synthetic search results.
+	 */
+	void BenchmarkSearchFilter(const TArray<FString>& Args) const;
+
+	/**
+	 * [Console command]
+	 * Ping a ping responder running on the loopback address.
+	 */
+	void PingLoopback(const TArray<FString>& Args) const;
+
+	/**
+	 * [Console command]
+	 * Simulate many clients matchmaking at the same time against an in-memory session population.
+	 */
+	void SimulateMatchmaking(const TArray<FString>& Args) const;
 };
@@ -96,8 +96,9 @@ public:
 	bool bAuthenticateUserAutomatically;
 
 	/**
-	 * Minimum time to spend on each auth task during user authentication.
+	 * Minimum time to display the last auth state before user authentication completes.
 	 * This is useful if you want to display the current auth state to the player.
+	 * Auth tasks themselves are never delayed, so this adds at most this much time to authentication.
 	 */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Authentication", meta = (ClampMin = "0.0"))
 	float MinTimePerAuthTask;
@@ -116,6 +117,13 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Authentication", AdvancedDisplay, meta = (AllowedClasses = "/Script/Engine.World"))
 	FSoftObjectPath GameDefaultMapOverride;
 
+	/**
+	 * Whether the friends lists of the user should be saved to disk after they are read.
+	 * The saved lists are loaded during the next authentication, so friend queries can be answered before the friends list is read again.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Authentication", AdvancedDisplay)
+	bool bSaveFriendsListSnapshot;
+
 public:
 
 	/**
@@ -144,6 +152,103 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
 	float SearchTimeout;
 
+	/**
+	 * Amount of time in seconds that the raw results of a regular search are kept for later matchmaking passes.
+	 * While cached, the search is queried with the widest elo range matchmaking may reach, and each pass filters the elo range locally.
+	 * Passes that can be answered from the cache skip both the online query and the restart delay. Set to zero to disable.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
+	float SearchResultCacheLifetime;
+
+	/**
+	 * While search results are cached, the max number of search results of the online query is scaled by how much wider the queried elo range is.
+	 * This is the largest allowed multiplier of the MaxSearchResults of the search params.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1.0"))
+	float SearchResultCacheMaxResultsScale;
+
+	/**
+	 * Whether to measure the ping of the filtered search results before sorting them.
+	 * Session hosts answer ping probes next to their reservation beacon.
+	 * Only works with online subsystems that resolve sessions to IP addresses.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking")
+	bool bPingSearchResults;
+
+	/** Amount of time in seconds that pinging the search results may take. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0", EditCondition = "bPingSearchResults"))
+	float PingTimeBudget;
+
+	/** Number of ping probes to send to each session. The lowest round trip time is used. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1", EditCondition = "bPingSearchResults"))
+	int32 PingProbesPerSession;
+
+	/** Maximum number of sessions to ping during a search pass. Sessions past this limit are left unpinged. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1", EditCondition = "bPingSearchResults"))
+	int32 MaxSessionsToPing;
+
+	/**
+	 * Offset of the ping port from the beacon port of the session.
+	 * The beacon port itself is owned by the beacon net driver, so ping probes are answered on a separate port.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", AdvancedDisplay, meta = (ClampMin = "1", EditCondition = "bPingSearchResults"))
+	int32 PingPortOffset;
+
+	/** How much sessions closer to our elo are preferred when sorting search results. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
+	float SessionScoreEloWeight;
+
+	/** How much sessions with room beyond our party size are preferred when sorting search results. Near-full sessions are more likely to reject our reservation. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
+	float SessionScoreOpenSlotsWeight;
+
+	/** How much sessions with lower ping are preferred when sorting search results. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
+	float SessionScorePingWeight;
+
+	/** How much fuller sessions are preferred when sorting search results. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0"))
+	float SessionScoreFillRateWeight;
+
+	/** Ping in milliseconds at which the ping factor of a session's score reaches zero. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1.0"))
+	float SessionScoreMaxPing;
+
+	/**
+	 * Number of sessions to request reservations with at the same time when testing search results.
+	 * The first session that accepts our reservation is joined, and the remaining requests are canceled.
+	 * Set to 1 to test search results one by one.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1"))
+	int32 MaxParallelReservationRequests;
+
+	/**
+	 * Whether the elo range should widen based on the number of sessions found by the previous passes.
+	 * When enabled, the EloSearchStep of the matchmaking params is scaled up when few sessions are found, and scaled down when plenty are found.
+	 * Matchmaking may also switch over to hosting early if the estimated time to find enough sessions is too long.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking")
+	bool bAdaptiveEloWidening;
+
+	/** Number of sessions that a matchmaking pass should ideally find. The elo range is widened towards the range that is expected to yield this many sessions. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1", EditCondition = "bAdaptiveEloWidening"))
+	int32 AdaptiveEloTargetSessions;
+
+	/** Smallest multiplier of the EloSearchStep when widening the elo range. Used when the previous passes found plenty of sessions. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveEloWidening"))
+	float AdaptiveEloMinStepScale;
+
+	/** Largest multiplier of the EloSearchStep when widening the elo range. Used when the previous passes found few or no sessions. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "1.0", EditCondition = "bAdaptiveEloWidening"))
+	float AdaptiveEloMaxStepScale;
+
+	/**
+	 * Switch over to hosting if the estimated time to find enough sessions is longer than this many seconds.
+	 * The estimate is based on the session density of the previous passes and the duration of a matchmaking pass. Set to zero to disable.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Matchmaking", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveEloWidening"))
+	float AdaptiveHostingWaitThreshold;
+
 public:
 
 	/**
@@ -165,6 +270,22 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Party", meta = (ClampMin = "1"))
 	int32 ClientReconnectPartyAttempts;
 
+	/** Amount of chat messages that a party member may send per second on average. Messages over the limit are dropped by the party host. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Party", meta = (ClampMin = "0.0"))
+	float PartyChatMessagesPerSecond;
+
+	/** Amount of chat messages that a party member may send in a quick burst before the rate limit kicks in. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Party", meta = (ClampMin = "1"))
+	int32 PartyChatBurstSize;
+
+	/** Max length of a party chat message. Longer messages are truncated by the party host. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Party", meta = (ClampMin = "1"))
+	int32 PartyChatMaxMessageLength;
+
+	/** Amount of recent chat messages that are sent to players who join the party. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Party", meta = (ClampMin = "0"))
+	int32 PartyChatHistorySize;
+
 public:
 
 	/** Delay in seconds before the session host travels to the session for the first time. */
@@ -180,4 +301,19 @@ public:
 	/** Delay in seconds before removing an incomplete reservation (e.g. player hasn't arrived at the session). */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reservation", meta = (ClampMin = "0.0"))
 	float ReservationTimeout;
+
+	/**
+	 * Amount of time in seconds that reservation requests are collected before they are answered together.
+	 * Collected requests are packed against the free reservation slots so that as many slots are filled as possible.
+	 * Set to zero to answer each request immediately.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reservation", meta = (ClampMin = "0.0"))
+	float ReservationAdmissionWindow;
+
+	/**
+	 * Max amount of time in seconds that a reservation request may wait in the queue for slots to free up.
+	 * Waiting clients are told their position in the queue. Only used if ReservationAdmissionWindow is not zero.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reservation", meta = (ClampMin = "0.0"))
+	float ReservationQueueTimeout;
 };
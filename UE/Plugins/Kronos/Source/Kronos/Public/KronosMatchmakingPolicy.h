@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "KronosTypes.h"
+#include "KronosMatchmakingTrace.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "KronosMatchmakingPolicy.generated.h"
 
@@ -121,15 +122,40 @@ protected:
 	UPROPERTY(Transient)
 	class AKronosReservationClient* ReservationBeaconClient;
 
+	/** Reservation clients of the parallel reservation requests that are in flight, or being canceled after another session accepted our reservation. */
+	UPROPERTY(Transient)
+	TArray<class AKronosReservationClient*> ParallelReservationClients;
+
+	/** Number of parallel reservation requests that haven't responded yet. */
+	int32 NumPendingParallelReservations;
+
 	/** Active async state(s) of the matchmaking policy. See EKronosMatchmakingAsyncStateFlags for possible states. */
 	uint8 MatchmakingAsyncStateFlags;
 
+	/** Timestamps the matchmaking stages handled by the policy. */
+	FKronosMatchmakingTimeline Timeline;
+
 	/** The index of the current matchmaking pass. Basically, 1 + how many times have we hit a matchmaking end point (e.g. zero sessions found). */
 	int32 CurrentMatchmakingPassIdx;
 
 	/** The index of the search result that is currently being tested. */
 	int32 CurrentSessionIdx;
 
+	/** Elo range of each matchmaking pass decided by the adaptive widening so far. Index 0 belongs to the first matchmaking pass. */
+	TArray<int32> EloRangeSchedule;
+
+	/** Estimated number of sessions per elo point around our elo, smoothed over the previous matchmaking passes. Zero until the first pass is complete. */
+	float EstimatedSessionDensity;
+
+	/** Average duration of a matchmaking pass in seconds, including the restart delay that preceded it. Zero until the first pass is exhausted. */
+	float AverageMatchmakingPassDuration;
+
+	/** Restart delay in seconds that preceded the current matchmaking pass. Zero for the first pass and for passes answered from the cache. */
+	float CurrentPassRestartDelay;
+
+	/** Time when the current matchmaking pass has started. */
+	double MatchmakingPassStartTime;
+
 	/** The result of the matchmaking. Only valid after the matchmaking has been completed. */
 	EKronosMatchmakingCompleteResult MatchmakingResult;
 
@@ -252,6 +278,15 @@ protected:
 	/** Starts a new search pass. Called when matchmaking is started, or after a matchmaking pass when restarting. */
 	virtual void StartSearchPass();
 
+	/** @return The search params to be used for the given matchmaking pass. */
+	virtual FKronosSearchParams GetSearchParamsFor(int32 MatchmakingPassIdx);
+
+	/**
+	 * Calculate the Elo range to be used for the online query of the given matchmaking pass.
+	 * Wider than the pass's own range while search results are cached, so that later passes can re-filter them locally.
+	 */
+	virtual int32 GetQueryEloRangeFor(int32 MatchmakingPassIdx);
+
 	/**
 	 * Calculate the Elo range to be used for the given matchmaking pass.
 	 * Called when matchmaking is initially started, or when restarting matchmaking after a matchmaking pass.
@@ -259,6 +294,15 @@ protected:
 	 */
 	virtual int32 GetEloSearchRangeFor(int32 MatchmakingPassIdx);
 
+	/**
+	 * Update the session density estimate with the number of sessions found by the current matchmaking pass,
+	 * and decide the elo range of the next pass. Only used if adaptive elo widening is enabled.
+	 */
+	virtual void UpdateEloRangeSchedule(const int32 NumSessionsFound);
+
+	/** @return Estimated time in seconds until a matchmaking pass finds enough sessions. Zero if there is no estimate yet or the current range is already wide enough. */
+	virtual float GetEstimatedWaitTime();
+
 	/** Entry point after a search pass is complete. */
 	virtual void OnSearchPassComplete(const FName InSessionName, const EKronosSearchPassCompleteResult Result);
 
@@ -312,6 +356,15 @@ protected:
 	/** Entry point after a reservation request is completed. */
 	virtual void OnRequestReservationComplete(const FKronosSearchResult& SearchResult, const EKronosReservationCompleteResult Result);
 
+	/** Starts requesting reservations with all of the given sessions at the same time. The first session that accepts our reservation will be joined. */
+	virtual bool RequestParallelReservations(const TArray<FKronosSearchResult>& InSessions);
+
+	/** Entry point after one of the parallel reservation requests is completed. */
+	virtual void OnParallelReservationComplete(const FKronosSearchResult& SearchResult, const EKronosReservationCompleteResult Result, class AKronosReservationClient* ReservationClient);
+
+	/** Cancels the reservation of the given parallel reservation client (if needed), and destroys the client afterwards. */
+	virtual void ReleaseParallelReservationClient(class AKronosReservationClient* ReservationClient, const bool bCancelReservation);
+
 	/** Starts joining the session through the online subsystem. */
 	virtual bool JoinOnlineSession(const FKronosSearchResult& InSession);
 
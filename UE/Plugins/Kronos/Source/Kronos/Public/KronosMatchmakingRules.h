@@ -0,0 +1,103 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KronosTypes.h"
+
+/**
+ * What to do after a matchmaking pass has exhausted all of its search results.
+ */
+enum class EKronosMatchmakingRestartDecision : uint8
+{
+	/** Widen the elo range and start another matchmaking pass. */
+	NextPass,
+
+	/** Switch over to hosting because the next pass would reach EloRangeBeforeHosting. */
+	HostEloRangeLimitReached,
+
+	/** Switch over to hosting because finding enough sessions is estimated to take longer than AdaptiveHostingWaitThreshold. */
+	HostWaitTimeTooLong,
+
+	/** Switch over to hosting because the search attempt limit has been reached. */
+	HostSearchAttemptLimitReached,
+
+	/** Give up because the search attempt limit has been reached and hosting is not allowed. */
+	NoResults
+};
+
+/**
+ * The decisions of the matchmaking as pure functions of their inputs.
+ * Used by UKronosMatchmakingPolicy, UKronosMatchmakingSearchPass and AKronosReservationHost, and by the matchmaking simulator,
+ * so that the simulated clients make exactly the same decisions as the real ones. Config values are read from UKronosConfig.
+ */
+namespace KronosMatchmakingRules
+{
+	/**
+	 * Calculate the elo range of the given matchmaking pass.
+	 * Passes that have been decided by the adaptive widening use the scheduled range.
+	 * Passes that haven't been decided yet widen linearly from the last decided range.
+	 */
+	KRONOS_API int32 GetEloSearchRangeFor(const FKronosMatchmakingParams& Params, const TArray<int32>& EloRangeSchedule, const int32 MatchmakingPassIdx);
+
+	/**
+	 * Calculate the elo range of the online query of the given matchmaking pass while search results are cached.
+	 * The query covers the widest range that any remaining pass may search with, so that later passes can re-filter the cached results.
+	 *
+	 * @param EloRange Elo range of the given matchmaking pass.
+	 * @param LastPassEloRange Elo range of the last matchmaking pass if it widens linearly.
+	 * @param bCanHost Whether the matchmaking may switch over to hosting.
+	 */
+	KRONOS_API int32 GetCachedQueryEloRange(const FKronosMatchmakingParams& Params, const int32 MatchmakingPassIdx, const int32 EloRange, const int32 LastPassEloRange, const bool bCanHost);
+
+	/** @return Max number of search results of an online query that is wider than the elo range of the matchmaking pass. */
+	KRONOS_API int32 GetQueryMaxSearchResults(const int32 MaxSearchResults, const int32 EloRange, const int32 QueryEloRange, const bool bSkipEloChecks);
+
+	/**
+	 * Update the session density estimate with the number of sessions found by the current matchmaking pass,
+	 * and add the elo range of the next pass to the schedule.
+	 *
+	 * @return The elo range of the next matchmaking pass.
+	 */
+	KRONOS_API int32 UpdateEloRangeSchedule(const FKronosMatchmakingParams& Params, TArray<int32>& EloRangeSchedule, float& EstimatedSessionDensity, const int32 CurrentMatchmakingPassIdx, const int32 NumSessionsFound);
+
+	/** @return Estimated time in seconds until a matchmaking pass finds enough sessions. Zero if there is no estimate yet or the next range is already wide enough. */
+	KRONOS_API float GetEstimatedWaitTime(const FKronosMatchmakingParams& Params, const float EstimatedSessionDensity, const float AverageMatchmakingPassDuration, const int32 NextEloRange);
+
+	/** @return The average matchmaking pass duration updated with the duration of the pass that has just been exhausted. */
+	KRONOS_API float UpdateAverageMatchmakingPassDuration(const float AverageMatchmakingPassDuration, const float MatchmakingPassDuration);
+
+	/**
+	 * Decide what to do after a matchmaking pass has exhausted all of its search results.
+	 *
+	 * @param NextEloRange Elo range of the next matchmaking pass.
+	 * @param EstimatedWaitTime Estimated time until a matchmaking pass finds enough sessions. Only used with adaptive elo widening.
+	 * @param bCanHost Whether the matchmaking may switch over to hosting.
+	 */
+	KRONOS_API EKronosMatchmakingRestartDecision GetRestartDecision(const FKronosMatchmakingParams& Params, const int32 CurrentMatchmakingPassIdx, const int32 NextEloRange, const float EstimatedWaitTime, const bool bCanHost);
+
+	/** @return How close the session elo is to ours, in the [0, 1] range. */
+	KRONOS_API float GetEloScore(const float EloDistance, const int32 EloRange);
+
+	/** @return How much room the session has left beyond our party, in the [0, 1] range. */
+	KRONOS_API float GetOpenSlotsScore(const int32 NumOpenSlots, const int32 PartySize);
+
+	/** @return How good the ping of the session is, in the [0, 1] range. Zero if the session didn't answer the ping. */
+	KRONOS_API float GetPingScore(const int32 PingInMs);
+
+	/** @return How full the session is, in the [0, 1] range. */
+	KRONOS_API float GetFillRateScore(const int32 NumPlayers, const int32 MaxNumPlayers);
+
+	/** @return The final score of a session, weighted by the session score weights of the config. */
+	KRONOS_API float GetSessionScore(const float EloScore, const float OpenSlotsScore, const float PingScore, const float FillRateScore);
+
+	/**
+	 * Choose the reservation requests to admit.
+	 * Picks the combination of requests that fills the most free slots, preferring requests that arrived earlier.
+	 *
+	 * @param RequestSizes Number of players in each request, in the order the requests were received.
+	 * @param NumFreeSlots Number of reservation slots that are still free.
+	 * @param OutAdmittedIndices Indices of the requests to admit, in ascending order.
+	 */
+	KRONOS_API void PackReservationRequests(const TArray<int32>& RequestSizes, const int32 NumFreeSlots, TArray<int32>& OutAdmittedIndices);
+}
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "KronosTypes.h"
+#include "KronosSearchFilter.h"
+#include "KronosPing.h"
+#include "KronosMatchmakingTrace.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "KronosMatchmakingSearchPass.generated.h"
 
@@ -50,6 +53,14 @@ public:
 	UPROPERTY(Transient)
 	FKronosSearchParams SearchParams;
 
+	/** Elo range used for the online query. Can be wider than the elo range of the search params, in which case the results are filtered locally. */
+	UPROPERTY(Transient)
+	int32 QueryEloRange;
+
+	/** Max number of search results of the online query. Scaled up from the search params when the query elo range is wider. */
+	UPROPERTY(Transient)
+	int32 QueryMaxSearchResults;
+
 	/** Current state of the search pass object. */
 	EKronosSearchPassState SearchState;
 
@@ -61,18 +72,48 @@ protected:
 	/** Session search that is being processed by the online subsystem. */
 	TSharedPtr<FOnlineSessionSearch> SessionSearch;
 
+	/** Search params compiled into filter instructions. Compiled once when the search pass is started. */
+	FKronosSearchFilter SearchFilter;
+
 	/** Sessions found by the search pass. Only valid after a successful search. */
 	TArray<FKronosSearchResult> FilteredSessions;
 
+	/** Measures the ping of the filtered sessions. Only valid while pinging. */
+	TUniquePtr<FKronosPingProbe> PingProbe;
+
+	/** Index of the filtered session that belongs to each ping probe target. */
+	TArray<int32> PingTargetSessionIndices;
+
+	/** Raw results of the last regular search. Reused by later search passes while valid. */
+	TArray<FOnlineSessionSearchResult> CachedSearchResults;
+
+	/** Search params that the cached search results were found with. Compared in full on lookup. */
+	FKronosSearchParams CachedSearchParams;
+
+	/** Session name that the cached search results were found for. */
+	FName CachedSearchSessionName;
+
+	/** Elo range that the cached search results were queried with. */
+	int32 CachedQueryEloRange;
+
+	/** Time when the cached search results were found. Zero if nothing is cached. */
+	double CachedSearchTime;
+
 	/** Handle used to delay search attempts. */
 	FTimerHandle TimerHandle_SearchDelay;
 
+	/** Handle used to poll the ping probe. */
+	FTimerHandle TimerHandle_PingTick;
+
 	/** The index of the current search attempt. */
 	int32 CurrentAttemptIdx;
 
 	/** Active async state(s) of the search pass. See EKronosSearchPassAsyncStateFlags for possible states. */
 	uint8 AsyncStateFlags;
 
+	/** Timestamps the search, filter and ping stages of the search pass. */
+	FKronosMatchmakingTimeline Timeline;
+
 protected:
 
 	/** Delegate triggered when the search for online sessions is complete. */
@@ -111,8 +152,9 @@ public:
 	 *
 	 * @param InSessionName Name of the session to matchmaking for. Should be either NAME_GameSession or NAME_PartySession!
 	 * @param InParams Search params. Check out FKronosSearchParams for list of params.
+	 * @param InQueryEloRange Elo range to use for the online query. Ignored if smaller than the elo range of the search params.
 	 */
-	virtual bool StartSearch(const FName InSessionName, const FKronosSearchParams& InParams);
+	virtual bool StartSearch(const FName InSessionName, const FKronosSearchParams& InParams, const int32 InQueryEloRange = 0);
 
 	/** Cancel search pass. */
 	virtual bool CancelSearch();
@@ -133,6 +175,9 @@ public:
 	/** Get all filtered sessions. */
 	virtual TArray<FKronosSearchResult>& GetSearchResults() { return FilteredSessions; }
 
+	/** @return Whether a search with the given params can be answered from the cached search results, without querying the online subsystem. */
+	virtual bool HasCachedSearchResultsFor(const FKronosSearchParams& InParams) const;
+
 	/** Clears all timers and delegates. Called by the associated matchmaking policy object when it is getting invalidated. */
 	virtual void Invalidate();
 
@@ -150,9 +195,15 @@ public:
 
 protected:
 
+	/** Compiles the search params into the search filter. Called once when the search pass is started. */
+	virtual void CompileSearchFilter();
+
 	/** Starts a new search attempt. */
 	virtual void BeginSearchAttempt();
 
+	/** @return Whether the query settings of the given params are the same as the ones of the cached search results, excluding the elo range. */
+	virtual bool MatchesCachedSearchParams(const FKronosSearchParams& InParams) const;
+
 	/** Finds sessions using a regular search. */
 	virtual bool FindOnlineSessions();
 
@@ -188,12 +239,44 @@ protected:
 	/** Ping filtered search results. */
 	virtual void PingSearchResults();
 
+	/**
+	 * Get the address that ping probes should be sent to for the given search result.
+	 *
+	 * @return True if the session can be pinged. False otherwise.
+	 */
+	virtual bool GetPingAddress(const FKronosSearchResult& InSearchResult, TSharedPtr<FInternetAddr>& OutAddress) const;
+
+	/** Polls the ping probe. Called every frame while pinging. */
+	virtual void TickPingSearchResults();
+
 	/** Entry point after pinging search results is complete. */
 	virtual void OnPingSearchResultsComplete(bool bWasSuccessful);
 
-	/** Sort filtered search results. */
+	/**
+	 * Sort filtered search results by their score, highest first.
+	 * Sorting is stable, so search results with the same score keep the order they were returned in.
+	 */
 	virtual void SortSearchResults();
 
+	/**
+	 * Score the given search result. Sessions with higher scores are tried first.
+	 * By default this is a weighted sum of the Elo, open slots, ping and fill rate factors. The weights are set in the Kronos config.
+	 * Override to change how sessions are prioritized.
+	 */
+	virtual float ScoreSearchResult(const FKronosSearchResult& InSearchResult) const;
+
+	/** @return How close the session's elo is to ours, from 0 (edge of the elo range) to 1 (same elo). */
+	virtual float GetEloScore(const FKronosSearchResult& InSearchResult) const;
+
+	/** @return How much room the session has beyond our party size, from 0 (exact fit) to 1 (room for another party of our size). */
+	virtual float GetOpenSlotsScore(const FKronosSearchResult& InSearchResult) const;
+
+	/** @return How good the session's ping is, from 0 (unknown or above the max scored ping) to 1 (zero ping). */
+	virtual float GetPingScore(const FKronosSearchResult& InSearchResult) const;
+
+	/** @return How full the session is, from 0 (empty) to 1 (full). */
+	virtual float GetFillRateScore(const FKronosSearchResult& InSearchResult) const;
+
 	/** Start a new search pass if there are search attempts left. Otherwise completion is signaled. */
 	virtual void RestartSearch();
 
@@ -0,0 +1,145 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Parameters of a matchmaking simulation.
+ * Timings are in simulated seconds, so they don't slow the simulation down.
+ */
+struct KRONOS_API FKronosMatchmakingSimulationParams
+{
+	/** Number of simulated matchmaking clients. */
+	int32 NumClients;
+
+	/** Clients start matchmaking at random times within this window. */
+	float ArrivalWindow;
+
+	/** Number of sessions that exist before the first client arrives. */
+	int32 NumInitialSessions;
+
+	/** Max number of players in a session. */
+	int32 MaxPlayersPerSession;
+
+	/** Largest party size. Party sizes are uniformly distributed between 1 and this value. */
+	int32 MaxPartySize;
+
+	/** Mean elo of the clients and the initial sessions. */
+	int32 EloMean;
+
+	/** Standard deviation of the elo of the clients and the initial sessions. */
+	int32 EloStdDev;
+
+	/** Mirrors FKronosMatchmakingParams::EloRange. */
+	int32 EloRange;
+
+	/** Mirrors FKronosMatchmakingParams::EloSearchStep. */
+	int32 EloSearchStep;
+
+	/** Mirrors FKronosMatchmakingParams::MaxSearchAttempts. */
+	int32 MaxSearchAttempts;
+
+	/** Mirrors FKronosMatchmakingParams::EloRangeBeforeHosting. */
+	int32 EloRangeBeforeHosting;
+
+	/** Mirrors FKronosMatchmakingParams::MaxSearchResults. */
+	int32 MaxSearchResults;
+
+	/** Mirrors UKronosConfig::MaxParallelReservationRequests. */
+	int32 MaxParallelReservationRequests;
+
+	/** Mirrors UKronosConfig::RestartMatchmakingPassDelay. */
+	float RestartMatchmakingPassDelay;
+
+	/** Time it takes the online subsystem to return search results. */
+	float SearchLatency;
+
+	/** Round trip time of a reservation request, not counting the time the request waits in the reservation queue of the host. */
+	float ReservationLatency;
+
+	/** Time it takes the online subsystem to join a session. */
+	float JoinLatency;
+
+	/** Time it takes the online subsystem to create a session. */
+	float CreateSessionLatency;
+
+	/** Random seed of the simulation. */
+	int32 Seed;
+
+	/** Default constructor. Initializes the params from the Kronos config where possible. */
+	FKronosMatchmakingSimulationParams();
+};
+
+/**
+ * Results of a matchmaking simulation.
+ */
+struct KRONOS_API FKronosMatchmakingSimulationStats
+{
+	/** Number of clients that joined a session. */
+	int32 NumJoined;
+
+	/** Number of clients that became hosts. */
+	int32 NumHosted;
+
+	/** Number of clients that gave up. */
+	int32 NumFailed;
+
+	/** Number of searches sent to the online subsystem. */
+	int32 NumSearches;
+
+	/** Number of matchmaking passes answered from the search result cache instead of a new search. */
+	int32 NumCachedSearches;
+
+	/** Number of reservation requests sent. */
+	int32 NumReservationRequests;
+
+	/** Number of reservation requests rejected because the session filled up after it was found, or because they timed out in the reservation queue. */
+	int32 NumReservationCollisions;
+
+	/** Number of accepted reservations that were canceled because another session accepted first. */
+	int32 NumCanceledReservations;
+
+	/** Simulated time when the last client finished matchmaking. */
+	double Duration;
+
+	/** Time-to-match of every client that joined or hosted a session. */
+	TArray<double> TimesToMatch;
+
+	/** Default constructor. */
+	FKronosMatchmakingSimulationStats() :
+		NumJoined(0),
+		NumHosted(0),
+		NumFailed(0),
+		NumSearches(0),
+		NumCachedSearches(0),
+		NumReservationRequests(0),
+		NumReservationCollisions(0),
+		NumCanceledReservations(0),
+		Duration(0.0),
+		TimesToMatch(TArray<double>())
+	{}
+};
+
+/**
+ * Headless, discrete-event simulation of many clients matchmaking at the same time.
+ *
+ * Each client makes its decisions through KronosMatchmakingRules, the same functions UKronosMatchmakingPolicy, UKronosMatchmakingSearchPass
+ * and AKronosReservationHost use: elo range of each pass including adaptive widening, reuse of cached search results, session scoring,
+ * switching over to hosting, and packing of the reservation requests collected by each host during the admission window.
+ * The online subsystem and the reservation hosts are replaced with an in-memory session population, so the simulation runs without
+ * Steam or EOS and without a world. Ping is not simulated. Settings that aren't part of the simulation params are read from UKronosConfig.
+ * Use it to see how changes to the elo widening, the hosting threshold or the reservation batching affect time-to-match.
+ */
+namespace KronosMatchmakingSimulator
+{
+	/** Run a simulation with the given params. */
+	KRONOS_API FKronosMatchmakingSimulationStats Run(const FKronosMatchmakingSimulationParams& Params);
+
+	/** Run a simulation with the given params and log the results. */
+	KRONOS_API void RunAndLog(const FKronosMatchmakingSimulationParams& Params);
+}
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Traced stages of the matchmaking flow.
+ */
+enum class EKronosMatchmakingStage : uint8
+{
+	/** From starting matchmaking until the matchmaking is complete. */
+	Matchmaking,
+
+	/** Waiting for the online subsystem to return search results. */
+	Search,
+
+	/** Filtering the search results. */
+	Filter,
+
+	/** Pinging the filtered search results. */
+	Ping,
+
+	/** Waiting for reservation responses. */
+	Reservation,
+
+	/** Waiting for the online subsystem to join a session. */
+	Join,
+
+	/** Waiting for the online subsystem to create a session. */
+	CreateSession,
+
+	/** From starting the travel to the game session until the map is loaded. */
+	Travel,
+
+	/** Number of stages. */
+	Num
+};
+
+/** @return Converts enum into a character array that can easily be turned into strings. */
+inline const TCHAR* LexToString(const EKronosMatchmakingStage Value)
+{
+	switch (Value)
+	{
+	case EKronosMatchmakingStage::Matchmaking:
+		return TEXT("Matchmaking");
+	case EKronosMatchmakingStage::Search:
+		return TEXT("Search");
+	case EKronosMatchmakingStage::Filter:
+		return TEXT("Filter");
+	case EKronosMatchmakingStage::Ping:
+		return TEXT("Ping");
+	case EKronosMatchmakingStage::Reservation:
+		return TEXT("Reservation");
+	case EKronosMatchmakingStage::Join:
+		return TEXT("Join");
+	case EKronosMatchmakingStage::CreateSession:
+		return TEXT("CreateSession");
+	case EKronosMatchmakingStage::Travel:
+		return TEXT("Travel");
+	default:
+		return TEXT("");
+	}
+}
+
+/**
+ * Timestamps the stages of a single matchmaking flow.
+ *
+ * Every completed stage is emitted as a timing region and a span event on the KronosMatchmaking trace channel,
+ * so it shows up in Unreal Insights. The duration is also recorded into a per-stage latency histogram that
+ * is shared by every timeline. Use the kronos.DumpMatchmakingLatency console command to view the histograms.
+ *
+ * Game thread only.
+ */
+class KRONOS_API FKronosMatchmakingTimeline
+{
+public:
+
+	/** Default constructor. */
+	FKronosMatchmakingTimeline();
+
+	/** Begin the given stage. Restarts the stage if it has already begun. */
+	void BeginStage(const EKronosMatchmakingStage Stage);
+
+	/**
+	 * End the given stage and record its duration. Does nothing if the stage hasn't begun.
+	 *
+	 * @param Stage The stage to end.
+	 * @param bWasSuccessful Whether the stage ended successfully. Failed stages are recorded into separate histograms.
+	 */
+	void EndStage(const EKronosMatchmakingStage Stage, const bool bWasSuccessful = true);
+
+	/** Abandon all active stages without recording them. Used when the matchmaking is canceled. */
+	void Reset();
+
+	/** @return Whether the given stage has begun but hasn't ended yet. */
+	bool IsStageActive(const EKronosMatchmakingStage Stage) const;
+
+private:
+
+	/** CPU cycle counter when each stage has begun. Zero for stages that are not active. */
+	uint64 StageStartCycles[static_cast<int32>(EKronosMatchmakingStage::Num)];
+};
+
+namespace KronosMatchmakingTrace
+{
+	/** Log the p50/p95/p99 latency of each stage recorded so far. */
+	KRONOS_API void DumpLatencyStats();
+
+	/** Clear all recorded latencies. */
+	KRONOS_API void ResetLatencyStats();
+}
@@ -4,7 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/OnlineSession.h"
+#include "Engine/EngineBaseTypes.h"
 #include "KronosTypes.h"
+#include "KronosMatchmakingTrace.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "KronosOnlineSession.generated.h"
 
@@ -24,6 +26,33 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUpdateKronosMatchComplete, bool,
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUpdateKronosPartyComplete, bool, bWasSuccessful);
 
+/**
+ * Session setting changes that are waiting to be pushed to the online subsystem.
+ * Changes made during the same frame are merged, so that the session settings are copied and submitted only once.
+ */
+struct FKronosPendingSessionUpdate
+{
+	/** Session configuration to apply. Only set if the session configuration was updated. */
+	TOptional<FKronosSessionSettings> SessionSettings;
+
+	/** Session settings to add or change. Later changes of the same key overwrite earlier ones. */
+	TMap<FName, FOnlineSessionSetting> ChangedSettings;
+
+	/** Stringified unique ids of the players to add to the banned players setting. */
+	TArray<FString> PlayersToBan;
+
+	/** Whether the update should be submitted to the backend. */
+	bool bShouldRefreshOnlineData;
+
+	/** Default constructor. */
+	FKronosPendingSessionUpdate() :
+		SessionSettings(TOptional<FKronosSessionSettings>()),
+		ChangedSettings(TMap<FName, FOnlineSessionSetting>()),
+		PlayersToBan(TArray<FString>()),
+		bShouldRefreshOnlineData(false)
+	{}
+};
+
 /**
  * KronosOnlineSession is the primary manager of online services.
  * It hosts multiple smaller online managers that each handle one aspect of the online service such as the online user, matchmaking, parties, and more.
@@ -92,12 +121,33 @@ protected:
 	/** Handle for session invitation accepted delegate. */
 	FDelegateHandle OnSessionUserInviteAcceptedDelegateHandle;
 
+	/** Handle for post load map delegate. */
+	FDelegateHandle PostLoadMapDelegateHandle;
+
+	/** Handle for travel failure delegate. */
+	FDelegateHandle TravelFailureDelegateHandle;
+
+	/** Handle for network failure delegate. */
+	FDelegateHandle NetworkFailureDelegateHandle;
+
 	/** Handle used to delay the enter game event after user auth is complete. */
 	FTimerHandle TimerHandle_EnterGame;
 
 	/** Handle used to delay travel to session calls. */
 	FTimerHandle TimerHandle_TravelToSession;
 
+	/** Handle used to push the pending session updates at the end of the frame. */
+	FTimerHandle TimerHandle_FlushSessionUpdates;
+
+	/** Session setting changes of each session that haven't been pushed to the online subsystem yet. */
+	TMap<FName, FKronosPendingSessionUpdate> PendingSessionUpdates;
+
+	/** Parsed banned players of each session. Rebuilt when the banned players setting of the session changes. */
+	TMap<FName, FKronosBannedPlayers> BannedPlayersCache;
+
+	/** Timestamps the travel to the game session. */
+	FKronosMatchmakingTimeline TravelTimeline;
+
 private:
 
 	/** Event when a game session's settings have been updated. */
@@ -137,6 +187,15 @@ protected:
 	/** Entry point when the game mode has been initialized for the recently loaded map. */
 	void OnGameModeInitialized(AGameModeBase* GameMode);
 
+	/** Entry point after a map has been loaded. Ends the travel stage of the matchmaking timeline. */
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	/** Entry point when a travel has failed. Ends the travel stage of the matchmaking timeline as a failure. */
+	void OnTravelFailure(UWorld* InWorld, ETravelFailure::Type FailureType, const FString& ErrorString);
+
+	/** Entry point when a network error has occurred. Ends the travel stage of the matchmaking timeline as a failure. */
+	void OnNetworkFailure(UWorld* InWorld, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
+
 	/**
 	 * Called when the recently loaded map is the game default map.
 	 * For most games this is going to be the game's main menu.
@@ -291,6 +350,9 @@ public:
 	 * Updates the configuration of an existing session.
 	 * NOTE: This operation is async.
 	 *
+	 * The changes are pushed to the online subsystem in the next frame, together with any other session changes made during this frame.
+	 * Call FlushSessionUpdates() to push them right away.
+	 *
 	 * Do NOT attempt to update a session while it is brand new (created / joined in the current frame).
 	 * Otherwise you may experience weird issues. (E.g. the session cannot be found by others).
 	 *
@@ -299,6 +361,8 @@ public:
 	 * @param bShouldRefreshOnlineData Whether to submit the data to the backend or not.
 	 * @param InExtraSessionSettings List of session settings to update on the session.
 	 *
+	 * If the pending changes are discarded or fail to be pushed, the update session complete delegates are fired with a failure.
+	 *
 	 * @return True if the update was requested successfully, false otherwise.
 	 */
 	virtual bool UpdateSession(const FName SessionName, const FKronosSessionSettings& InSessionSettings, const bool bShouldRefreshOnlineData = true, const TArray<FKronosSessionSetting>& InExtraSessionSettings = TArray<FKronosSessionSetting>());
@@ -325,13 +389,34 @@ public:
 	 * @param SessionName The name of the session to ban the player from.
 	 * @param PlayerId Unique id of the player we want to ban.
 	 *
+	 * The ban is pushed to the online subsystem in the next frame, together with any other session changes made during this frame.
+	 * The result is reported through the update session complete delegates.
+	 *
 	 * @return True if the ban was requested successfully, false otherwise.
 	 */
 	virtual bool BanPlayerFromSession(const FName SessionName, const FUniqueNetId& PlayerId);
 
-	/** Check if the given player is banned from the session. */
+	/** Check if the given player is banned from the session. Players whose ban hasn't been pushed yet are considered banned. */
 	virtual bool IsPlayerBannedFromSession(const FName SessionName, const FUniqueNetId& PlayerId);
 
+	/** Push the pending changes of every session to the online subsystem right away. */
+	virtual void FlushSessionUpdates();
+
+protected:
+
+	/** Schedule the pending session updates to be pushed in the next frame. */
+	virtual void ScheduleFlushSessionUpdates();
+
+	/**
+	 * Copy the current settings of the session once, apply the pending changes, and submit them with a single UpdateSession call.
+	 *
+	 * @return True if the update was requested successfully, false otherwise.
+	 */
+	virtual bool FlushSessionUpdate(const FName SessionName, const FKronosPendingSessionUpdate& PendingUpdate);
+
+	/** Discard the pending changes of the given session. Fires the update session complete delegates with a failure if there were any. */
+	virtual void DiscardPendingSessionUpdate(const FName SessionName);
+
 public:
 
 	//~ Begin UObject interface
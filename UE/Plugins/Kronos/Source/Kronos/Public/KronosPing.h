@@ -0,0 +1,210 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FSocket;
+class FInternetAddr;
+class ISocketSubsystem;
+
+/**
+ * Answers the ping probes of matchmaking clients.
+ *
+ * Session hosts run a responder next to their reservation beacon. The beacon net driver owns the beacon port itself,
+ * so the responder listens on the beacon port plus UKronosConfig::PingPortOffset. Probes are echoed back unchanged.
+ *
+ * @see FKronosPingProbe
+ */
+class KRONOS_API FKronosPingResponder
+{
+public:
+
+	/** Default constructor. */
+	FKronosPingResponder();
+
+	/** Destructor. Stops the responder if it is running. */
+	~FKronosPingResponder();
+
+	/**
+	 * Start listening for ping probes.
+	 *
+	 * @param InPort Port to listen on. Pass 0 to bind any free port.
+	 * @param bLoopbackOnly Whether to only accept probes from the local machine.
+	 * @param bAutoTick Whether to process incoming probes from the core ticker. If false, ProcessProbes() must be called manually.
+	 *
+	 * @return True if the responder was started successfully. False otherwise.
+	 */
+	bool Start(const int32 InPort, const bool bLoopbackOnly = false, const bool bAutoTick = true);
+
+	/** Stop listening for ping probes. */
+	void Stop();
+
+	/** Answer all pending ping probes. */
+	void ProcessProbes();
+
+	/** @return Whether the responder is running. */
+	bool IsRunning() const { return Socket != nullptr; }
+
+	/** @return The port that the responder is bound to. Only valid while the responder is running. */
+	int32 GetPort() const { return Port; }
+
+private:
+
+	/** Core ticker callback. */
+	bool HandleTick(float DeltaTime);
+
+private:
+
+	/** The socket that probes are received on. */
+	FSocket* Socket;
+
+	/** The port that the socket is bound to. */
+	int32 Port;
+
+	/** Handle for the core ticker delegate. */
+	FTSTicker::FDelegateHandle TickerHandle;
+};
+
+/**
+ * Measures the round trip time to a set of session hosts with lightweight UDP probes.
+ *
+ * Every target is probed at the same time. Each target gets a fixed number of probes, and the lowest round trip time
+ * is kept. Probing ends when every target answered all of its probes, or when the time budget runs out.
+ *
+ * Round trip times are measured when the socket is polled, so the accuracy depends on how often Tick() is called.
+ *
+ * @see FKronosPingResponder
+ */
+class KRONOS_API FKronosPingProbe
+{
+public:
+
+	/** Default constructor. */
+	FKronosPingProbe();
+
+	/** Destructor. Stops probing if in progress. */
+	~FKronosPingProbe();
+
+	/**
+	 * Add a host to probe. Targets can only be added before probing is started.
+	 *
+	 * @return Index of the target. INDEX_NONE if the target could not be added.
+	 */
+	int32 AddTarget(const TSharedRef<FInternetAddr>& InAddress);
+
+	/**
+	 * Start probing the targets.
+	 *
+	 * @param InNumProbesPerTarget Number of probes to send to each target.
+	 * @param InTimeBudget Amount of time in seconds that probing may take.
+	 *
+	 * @return True if probing was started successfully. False otherwise.
+	 */
+	bool Start(const int32 InNumProbesPerTarget, const float InTimeBudget);
+
+	/**
+	 * Send pending probes and read the answers that have arrived.
+	 *
+	 * @return True if probing is complete. False otherwise.
+	 */
+	bool Tick();
+
+	/** Stop probing. Round trip times measured so far are kept. */
+	void Stop();
+
+	/** @return Whether probing is in progress. */
+	bool IsRunning() const { return Socket != nullptr; }
+
+	/** @return Number of targets. */
+	int32 NumTargets() const { return Targets.Num(); }
+
+	/** @return The lowest round trip time measured for the given target in milliseconds. INDEX_NONE if the target didn't answer. */
+	int32 GetPingInMs(const int32 TargetIdx) const;
+
+	/** @return Number of targets that answered at least one probe. */
+	int32 NumAnsweredTargets() const;
+
+private:
+
+	/** A single probed host. */
+	struct FTarget
+	{
+		/** Address of the host. */
+		TSharedRef<FInternetAddr> Address;
+
+		/** Time when each probe was sent. Zero for probes not sent yet. */
+		TArray<double> SendTimes;
+
+		/** Number of probes sent. */
+		int32 NumSent;
+
+		/** Number of answers received. */
+		int32 NumReceived;
+
+		/** Lowest round trip time measured in seconds. Negative if no answer was received. */
+		double BestRoundTripTime;
+
+		/** Constructor. */
+		FTarget(const TSharedRef<FInternetAddr>& InAddress) :
+			Address(InAddress),
+			SendTimes(TArray<double>()),
+			NumSent(0),
+			NumReceived(0),
+			BestRoundTripTime(-1.0)
+		{}
+	};
+
+	/** Send the next probe to the given target. */
+	void SendProbe(const int32 TargetIdx, const double Now);
+
+	/** Read all answers that have arrived. */
+	void ReceiveAnswers(const double Now);
+
+	/** @return Whether every target has answered all of its probes. */
+	bool AllTargetsComplete() const;
+
+private:
+
+	/** Probed hosts. */
+	TArray<FTarget> Targets;
+
+	/** The socket that probes are sent on. */
+	FSocket* Socket;
+
+	/** Random value identifying this probe run. Answers with a different nonce are ignored. */
+	uint32 Nonce;
+
+	/** Number of probes to send to each target. */
+	int32 NumProbesPerTarget;
+
+	/** Time between two probes sent to the same target when no answer arrives. */
+	double ProbeInterval;
+
+	/** Time when probing was started. */
+	double StartTime;
+
+	/** Time when probing must end. */
+	double EndTime;
+};
+
+namespace KronosPing
+{
+	/** Size of a ping probe packet in bytes. */
+	constexpr int32 ProbeSize = 12;
+
+	/** Magic value at the start of every ping probe packet. */
+	constexpr uint32 ProbeMagic = 0x4B50494E; // "KPIN"
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Start a responder on the loopback address, probe it, and log the measured round trip times.
+	 * Both ends are ticked in place, so this blocks until probing is complete.
+	 *
+	 * @param NumTargets Number of targets to probe. Every target points at the same responder.
+	 * @param NumProbesPerTarget Number of probes to send to each target.
+	 */
+	KRONOS_API void RunLoopbackTest(const int32 NumTargets, const int32 NumProbesPerTarget);
+#endif
+}
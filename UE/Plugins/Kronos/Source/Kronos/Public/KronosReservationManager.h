@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "KronosTypes.h"
+#include "KronosPing.h"
 #include "KronosReservationManager.generated.h"
 
 class AKronosReservationListener;
@@ -45,6 +46,9 @@ protected:
 	/** Reservations that should automatically be registered when creating a reservation host beacon. */
 	TArray<FKronosReservation> HostReservations;
 
+	/** Answers the ping probes of matchmaking clients. Only running while we have a reservation host beacon. */
+	TUniquePtr<FKronosPingResponder> PingResponder;
+
 public:
 
 	/** Get the reservation manager from the KronosOnlineSession. */
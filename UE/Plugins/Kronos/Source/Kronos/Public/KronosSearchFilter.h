@@ -0,0 +1,152 @@
+// Copyright 2022-2023 Horizon Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KronosTypes.h"
+
+/**
+ * A search params object compiled into a flat list of filter instructions.
+ *
+ * Compiling is done once per search pass. Setting keys are resolved into FNames, expected string values are stored
+ * as variant data so that they can be compared without copying, and the instructions are ordered so that the cheapest
+ * and most selective checks run first. Filtering a search result is a single loop over the instructions.
+ *
+ * @see UKronosMatchmakingSearchPass::FilterSearchResult
+ */
+struct KRONOS_API FKronosSearchFilter
+{
+public:
+
+	/** Default constructor. */
+	FKronosSearchFilter();
+
+	/**
+	 * Compile the given search params into filter instructions. Previously compiled instructions are discarded.
+	 *
+	 * @param InSessionName Name of the session that we are searching for.
+	 * @param InParams Search params to compile.
+	 * @param InLocalPlayerId UniqueId of the local player. Sessions owned by this player are filtered.
+	 * @param InPlayersToCheckForBans Players who must not be banned from the session (e.g. the party members).
+	 */
+	void Compile(const FName InSessionName, const FKronosSearchParams& InParams, const FUniqueNetIdPtr& InLocalPlayerId, const TArray<FUniqueNetIdRepl>& InPlayersToCheckForBans);
+
+	/** Discard all compiled instructions. */
+	void Reset();
+
+	/**
+	 * Run the compiled instructions against the given search result.
+	 *
+	 * @return True if the search result passed every instruction. False otherwise.
+	 */
+	bool PassesFilter(const FOnlineSessionSearchResult& InSearchResult) const;
+
+	/** @return Number of compiled instructions. */
+	int32 Num() const { return Instructions.Num(); }
+
+	/** Dumps the compiled instructions to the console. */
+	void DumpInstructions() const;
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Filter a number of synthetic search results with both the compiled filter and a reference filter that resolves
+	 * every setting by name, and log the time spent by each.
+	 *
+	 * @param NumResults Number of synthetic search results to generate.
+	 */
+	static void RunBenchmark(const int32 NumResults);
+#endif
+
+private:
+
+	/** Possible filter instructions. Listed roughly in the order of their cost. */
+	enum class EInstruction : uint8
+	{
+		/** Session must have at least IntValue open public slots. */
+		MinSlots,
+
+		/** Session must not be owned by the local player. */
+		NotOwnSession,
+
+		/** Session must not be in the ignored sessions list. */
+		NotIgnoredSession,
+
+		/** Session must not be hidden. */
+		NotHidden,
+
+		/** The int32 setting under Key must be greater than or equal to IntValue. */
+		IntAtLeast,
+
+		/** The int32 setting under Key must be less than or equal to IntValue. */
+		IntAtMost,
+
+		/** The setting under Key must be equal to Data. */
+		DataEquals,
+
+		/** Generic query setting comparison. Used for extra query settings. */
+		QuerySetting,
+
+		/** None of the players to check for bans may be in the setting under Key. */
+		NotBanned
+	};
+
+	/** A single filter instruction. */
+	struct FInstruction
+	{
+		/** Type of the instruction. */
+		EInstruction Type;
+
+		/** Pre-resolved session setting key. */
+		FName Key;
+
+		/** Pre-built value to compare against. */
+		FVariantData Data;
+
+		/** Comparison to use for QuerySetting instructions. */
+		EOnlineComparisonOp::Type ComparisonOp;
+
+		/** Integer operand of the instruction. */
+		int32 IntValue;
+
+		/** Constructor. */
+		FInstruction(const EInstruction InType, const FName InKey = NAME_None, const FVariantData& InData = FVariantData(), const EOnlineComparisonOp::Type InComparisonOp = EOnlineComparisonOp::Equals, const int32 InIntValue = 0) :
+			Type(InType),
+			Key(InKey),
+			Data(InData),
+			ComparisonOp(InComparisonOp),
+			IntValue(InIntValue)
+		{}
+	};
+
+	/** Run a single instruction against the given search result. */
+	bool ExecuteInstruction(const FInstruction& Instruction, const FOnlineSessionSearchResult& InSearchResult) const;
+
+	/** @return Human readable description of the given instruction. Used for logging. */
+	FString DescribeInstruction(const FInstruction& Instruction) const;
+
+	/** @return Whether any of the players to check for bans is in the banned players setting of the given session. */
+	bool IsAnyPlayerBanned(const FOnlineSession& Session, const FVariantData& BannedPlayersData) const;
+
+private:
+
+	/** Compiled instructions in the order they are executed. */
+	TArray<FInstruction> Instructions;
+
+	/** UniqueId of the local player. */
+	FUniqueNetIdPtr LocalPlayerId;
+
+	/** Sessions to ignore. */
+	TSet<FUniqueNetIdRepl> IgnoredSessions;
+
+	/** Stringified unique ids of the players who must not be banned from the session, paired with their pre-calculated hashes. */
+	TArray<TPair<uint32, FString>> PlayersToCheckForBans;
+
+	/**
+	 * Parsed banned players of the sessions that we have filtered, keyed by session id.
+	 * Kept between compiles so that sessions found again by later search passes don't have to be parsed again.
+	 */
+	mutable TMap<FUniqueNetIdRepl, FKronosBannedPlayers> BannedPlayersCache;
+
+	/** Maximum number of sessions to keep in the banned players cache. The cache is emptied when compiling if there are more. */
+	static constexpr int32 MaxBannedPlayersCacheSize = 1024;
+};
@@ -1039,6 +1039,50 @@ struct KRONOS_API FKronosSessionSettings
 	}
 };
 
+/**
+ * Parsed set of players banned from a session.
+ * The banned players session setting is a ';' separated list of unique ids. Instead of parsing the list for every check,
+ * it is parsed into a hash set once and only parsed again when the value of the setting changes.
+ */
+struct KRONOS_API FKronosBannedPlayers
+{
+public:
+
+	/** Default constructor. */
+	FKronosBannedPlayers();
+
+	/**
+	 * Update the set from the value of the banned players session setting.
+	 * Does nothing if the value is the same as it was during the last update.
+	 *
+	 * @return True if the set was rebuilt. False otherwise.
+	 */
+	bool Update(const FVariantData& InBannedPlayersData);
+
+	/** Clear the set and forget the last parsed value. */
+	void Reset();
+
+	/** @return Whether the given player is in the set. */
+	bool Contains(const FUniqueNetId& PlayerId) const;
+
+	/** @return Whether the given stringified unique id is in the set. The hash must be calculated with HashPlayerId(). */
+	bool ContainsByHash(const uint32 PlayerIdHash, const FString& PlayerIdString) const { return BannedPlayerIds.ContainsByHash(PlayerIdHash, PlayerIdString); }
+
+	/** @return Number of banned players. */
+	int32 Num() const { return BannedPlayerIds.Num(); }
+
+	/** @return The hash of the given stringified unique id as used by the set. */
+	static uint32 HashPlayerId(const FString& PlayerIdString) { return GetTypeHash(PlayerIdString); }
+
+private:
+
+	/** Value of the banned players session setting that the set was built from. */
+	FVariantData SourceData;
+
+	/** Stringified unique ids of the banned players. */
+	TSet<FString> BannedPlayerIds;
+};
+
 /**
  * Blueprint wrapper around the native FOnlineSessionSearchResult class.
  * Exposes native search results to blueprints and implements some helper functions.
@@ -1079,17 +1123,18 @@ struct KRONOS_API FKronosSearchResult
 	/** @return Whether any of the given players are banned from this session or not. */
 	bool IsPlayerBannedFromSession(const TArray<FUniqueNetIdRepl>& PlayerIds) const
 	{
-		FString BannedPlayers;
-		GetSessionSetting(SETTING_BANNEDPLAYERS, BannedPlayers);
-
-		if (!BannedPlayers.IsEmpty())
+		const FOnlineSessionSetting* Setting = OnlineResult.Session.SessionSettings.Settings.Find(SETTING_BANNEDPLAYERS);
+		if (Setting)
 		{
-			TArray<FString> BannedPlayersArray;
-			if (BannedPlayers.ParseIntoArray(BannedPlayersArray, TEXT(";")) > 0)
+			// Decoded on demand. Hot paths such as the search filter keep their own cache keyed by session.
+			FKronosBannedPlayers BannedPlayers;
+			BannedPlayers.Update(Setting->Data);
+
+			if (BannedPlayers.Num() > 0)
 			{
 				for (const FUniqueNetIdRepl& PlayerId : PlayerIds)
 				{
-					if (BannedPlayersArray.Contains(PlayerId->ToString()))
+					if (PlayerId.IsValid() && BannedPlayers.Contains(*PlayerId))
 					{
 						return true;
 					}
@@ -1130,6 +1175,12 @@ struct KRONOS_API FKronosSearchResult
 		return OnlineResult.Session.OwningUserName.Left(20);
 	}
 
+	/** @return The session's ping in milliseconds. */
+	int32 GetPingInMs() const
+	{
+		return OnlineResult.PingInMs;
+	}
+
 	/** @return Current number of players in the session. */
 	int32 GetNumPlayers() const
 	{
@@ -1509,21 +1560,26 @@ struct KRONOS_API FKronosReservationMember
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Default")
 	bool bIsCompleted;
 
-	/** Handle used to time-out the member. */
-	FTimerHandle TimerHandle_ReservationTimeout;
+	/** World time when the member times out unless the member has arrived by then. Zero if the member never times out. */
+	double TimeoutTime;
+
+	/** Identifies the pending timeout of the member. Set by the reservation host when the reservation is registered. Zero if there is none. */
+	uint32 TimeoutGeneration;
 
 	/** Default constructor. */
 	FKronosReservationMember() :
 		PlayerId(FUniqueNetIdRepl()),
 		bIsCompleted(false),
-		TimerHandle_ReservationTimeout(FTimerHandle())
+		TimeoutTime(0.0),
+		TimeoutGeneration(0)
 	{}
 
 	/** Preferred constructor. */
 	FKronosReservationMember(const FUniqueNetIdRepl& InPlayerId) :
 		PlayerId(InPlayerId),
 		bIsCompleted(false),
-		TimerHandle_ReservationTimeout(FTimerHandle())
+		TimeoutTime(0.0),
+		TimeoutGeneration(0)
 	{}
 
 	/** @return Whether the reservation member is valid or not. */
@@ -1679,3 +1735,32 @@ struct KRONOS_API FKronosOnlineFriend
 		return UserId.IsValid();
 	}
 };
+
+/**
+ * A party chat message.
+ */
+USTRUCT(BlueprintType)
+struct KRONOS_API FKronosChatMessage
+{
+	GENERATED_BODY()
+
+	/** UniqueId of the player who sent the message. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Default")
+	FUniqueNetIdRepl SenderId;
+
+	/** The message. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Default")
+	FString Msg;
+
+	/** Default constructor. */
+	FKronosChatMessage() :
+		SenderId(FUniqueNetIdRepl()),
+		Msg(FString())
+	{}
+
+	/** Preferred constructor. */
+	FKronosChatMessage(const FUniqueNetIdRepl& InSenderId, const FString& InMsg) :
+		SenderId(InSenderId),
+		Msg(InMsg)
+	{}
+};
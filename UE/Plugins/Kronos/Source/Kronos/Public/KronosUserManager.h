@@ -5,13 +5,59 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Interfaces/OnlineFriendsInterface.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "KronosTypes.h"
 #include "KronosUserManager.generated.h"
 
 class UKronosUserAuthWidget;
 class AGameModeBase;
-struct FKronosOnlineFriend;
+class FOnlineUserPresence;
 using FTimerDelegate = TDelegate<void(), FNotThreadSafeNotCheckedDelegateUserPolicy>;
 
+/**
+ * Tasks of the user authentication pipeline.
+ * Each task starts as soon as the tasks it depends on are complete, so independent tasks run at the same time.
+ */
+enum class EKronosUserAuthTask : uint8
+{
+	/** Login with the online platform. */
+	PlatformLogin,
+
+	/** Read user files from the cloud. */
+	ReadUserFiles,
+
+	/** Read the default friends list, so that it is ready when the user reaches the main menu. Failure doesn't fail authentication. */
+	ReadFriendsList,
+
+	/** Custom auth tasks (implemented by end user of plugin). */
+	CustomAuthTasks,
+
+	/** Number of auth tasks. */
+	Num
+};
+
+/**
+ * Local copy of a friends list, hashed by the unique id of the friends.
+ */
+struct FKronosFriendsListCache
+{
+	/** Friends in the list. */
+	TMap<FUniqueNetIdRepl, FKronosOnlineFriend> Friends;
+
+	/**
+	 * Whether the list was loaded from the on-disk snapshot and hasn't been read from the online subsystem yet.
+	 * Friends of a snapshot are always offline, since presence is not saved.
+	 * Snapshots are for display only. They are dropped if the list can't be read, and never used to answer IsFriend().
+	 */
+	bool bIsSnapshot;
+
+	/** Default constructor. */
+	FKronosFriendsListCache() :
+		Friends(TMap<FUniqueNetIdRepl, FKronosOnlineFriend>()),
+		bIsSnapshot(false)
+	{}
+};
+
 /**
  * Delegate triggered when user authentication is started.
  * 
@@ -99,11 +145,26 @@ protected:
 	EKronosUserAuthState CurrentAuthState;
 
 	/**
-	 * Time when the last auth task was started.
-	 * Used to delay the next auth task if the current task finished earlier that the configured min time.
+	 * Time when the auth state was last changed.
+	 * Used to delay the completion of authentication if the last auth state was displayed for less than the configured min task time.
 	 */
 	float LastAuthTaskStartTime;
 
+	/** Auth tasks that have been started during the current authentication. Bitmask of EKronosUserAuthTask. */
+	uint32 StartedAuthTasks;
+
+	/**
+	 * Auth tasks that have been completed. Bitmask of EKronosUserAuthTask.
+	 * Kept between authentications, so that authenticating the same user again only redoes the tasks that can't be reused.
+	 */
+	uint32 CompletedAuthTasks;
+
+	/** Auth tasks that have been completed without a valid result, and must be redone during the next authentication. Bitmask of EKronosUserAuthTask. */
+	uint32 InvalidAuthTasks;
+
+	/** The user that the completed auth tasks belong to. */
+	FUniqueNetIdRepl AuthTasksUserId;
+
 	/** Handle for platform login complete delegate. */
 	FDelegateHandle PlatformLoginDelegateHandle;
 
@@ -113,6 +174,25 @@ protected:
 	/** Handle used when the user auth flow doesn't want to go into the next state immediately. */
 	FTimerHandle TimerHandle_ChangeAuthState;
 
+	/**
+	 * Friends lists that have been read from the online subsystem, keyed by list name.
+	 * Friend queries are answered from here without going through the friends interface.
+	 * Kept up to date with the friend change events of the online subsystem.
+	 */
+	TMap<FString, FKronosFriendsListCache> FriendsListCaches;
+
+	/** Handle for friends list changed delegate. */
+	FDelegateHandle FriendsChangeDelegateHandle;
+
+	/** Handle for friend removed delegate. */
+	FDelegateHandle FriendRemovedDelegateHandle;
+
+	/** Handle for friend invite accepted delegate. */
+	FDelegateHandle InviteAcceptedDelegateHandle;
+
+	/** Handle for presence received delegate. */
+	FDelegateHandle PresenceReceivedDelegateHandle;
+
 private:
 
 	/** Event when user authentication is started. */
@@ -137,13 +217,13 @@ public:
 	 * Initialize the KronosUserManager during game startup.
 	 * Called by the KronosOnlineSession.
 	 */
-	virtual void Initialize() {};
+	virtual void Initialize();
 
 	/**
 	 * Deinitialize the KronosUserManager before game shutdown.
 	 * Called by the KronosOnlineSession.
 	 */
-	virtual void Deinitialize() {};
+	virtual void Deinitialize();
 
 public:
 
@@ -208,6 +288,38 @@ protected:
 	/** Called when user authentication state is changed. */
 	virtual void OnUserAuthStateChanged(EKronosUserAuthState NewState, EKronosUserAuthState PrevState, bool bIsInitialAuth);
 
+	/**
+	 * Get the auth tasks that must be complete before the given task can start.
+	 * By default every task only depends on platform login, so the remaining tasks run at the same time.
+	 * Override this if your custom auth tasks depend on the user files, for example.
+	 *
+	 * @return Bitmask of EKronosUserAuthTask.
+	 */
+	virtual uint32 GetAuthTaskPrerequisites(EKronosUserAuthTask Task) const;
+
+	/**
+	 * Whether the result of the given auth task can be reused when the same user authenticates again (e.g. returning to main menu from a match).
+	 * Platform login is always redone to confirm the login status of the user.
+	 */
+	virtual bool CanReuseAuthTask(EKronosUserAuthTask Task) const;
+
+	/** Start every auth task whose prerequisites are complete. Completes authentication once every task is complete. */
+	void RunAuthTasks();
+
+	/** Start the given auth task. The task must call CompleteAuthTask once it's done. */
+	virtual void BeginAuthTask(EKronosUserAuthTask Task);
+
+	/**
+	 * Mark the given auth task as complete, and start the tasks that depend on it.
+	 *
+	 * @param Task The completed task.
+	 * @param bIsResultValid Whether the result of the task can be reused later. Tasks without a valid result are redone during the next authentication.
+	 */
+	void CompleteAuthTask(EKronosUserAuthTask Task, bool bIsResultValid = true);
+
+	/** Update the auth state to reflect the first auth task that is still in progress. */
+	void UpdateAuthState();
+
 	/**
 	 * Entry point for user authentication.
 	 * Ensures that the user is logged in with the online subsystem.
@@ -234,7 +346,16 @@ protected:
 	virtual void OnReadUserFilesComplete(bool bWasSuccessful, const FUniqueNetId& UserId, const FString& ErrorStr);
 
 	/**
-	 * Begin any custom authentication tasks. Called after reading user files from cloud.
+	 * Begin reading the default friends list of the user.
+	 * Called after platform login.
+	 */
+	virtual void PrefetchFriendsList();
+
+	/** Called when reading the default friends list is complete. */
+	virtual void OnPrefetchFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr);
+
+	/**
+	 * Begin any custom authentication tasks. Called after platform login, while user files are being read from cloud.
 	 * You can override this function to implement any additional tasks for your game (e.g. read values from your custom backend service).
 	 * Once you are done with everything, make sure to end by calling OnCustomAuthTasksComplete.
 	 */
@@ -259,8 +380,8 @@ protected:
 	void ChangeAuthState(EKronosUserAuthState NewState);
 
 	/**
-	 * Helper function to start the next auth task while adhering to the configured min task time.
-	 * The given delegate will be executed latently if the current auth task finished earlier then the configured min task time.
+	 * Helper function to continue authentication while adhering to the configured min task time.
+	 * The given delegate will be executed latently if the current auth state was displayed for less than the configured min task time.
 	 */
 	void BeginAuthTaskLatent(const FTimerDelegate& NextAuthTaskDelegate);
 
@@ -305,27 +426,28 @@ public:
 
 	/**
 	 * Get the given cached friends list.
-	 * Only valid after reading friends list!
+	 * Only valid after reading friends list, or after its snapshot was loaded during authentication!
 	 * For possible list names see EFriendsLists.
 	 */
 	virtual bool GetFriendsList(const FString& ListName, TArray<FKronosOnlineFriend>& OutFriends);
 
 	/**
 	 * Get a specific friend from the given cached friends list.
-	 * Only valid after reading friends list!
+	 * Only valid after reading friends list, or after its snapshot was loaded during authentication!
 	 * For possible list names see EFriendsLists.
 	 */
 	virtual FKronosOnlineFriend GetFriend(const FUniqueNetId& FriendId, const FString& ListName);
 
 	/**
 	 * Get the number of friends contained in the given cached friends list.
-	 * Only valid after reading friends list!
+	 * Only valid after reading friends list, or after its snapshot was loaded during authentication!
 	 * For possible list names see EFriendsLists.
 	 */
 	virtual int32 GetFriendCount(const FString& ListName) const;
 
 	/**
 	 * Get whether the user is friends with the given player.
+	 * Never answered from a friends list snapshot, since the snapshot may be out of date.
 	 * An additional list name can be provided for the online subsystem for further processing.
 	 * Steam doesn't make use of this list, while EOS can use "onlinePlayers" and "inGamePlayers" names to filter friends.
 	 * For possible list names see EFriendsLists.
@@ -338,6 +460,41 @@ public:
 	 */
 	virtual bool SendSessionInviteToFriend(FName InSessionName, const FUniqueNetId& FriendId);
 
+protected:
+
+	/** Called when reading a friends list is complete. Updates the friends list cache before notifying the caller. */
+	virtual void OnReadFriendsListComplete(int32 LocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& ErrorStr, FOnReadFriendsListComplete CompletionDelegate);
+
+	/** Rebuild the cache of the given friends list from the friends list of the online subsystem. */
+	void UpdateFriendsListCache(const FString& ListName);
+
+	/** Remove every cached friends list. Called when the user changes or logs out. */
+	void ClearFriendsListCaches();
+
+	/** Remove the cached friends list with the given name if it was loaded from the snapshot. Called when the list couldn't be read. */
+	void RemoveFriendsListSnapshot(const FString& ListName);
+
+	/** Called when the friends list of the user has changed in the online subsystem. */
+	virtual void OnFriendsChange();
+
+	/** Called when a friend has been removed from the friends list of the user. */
+	virtual void OnFriendRemoved(const FUniqueNetId& UserId, const FUniqueNetId& FriendId);
+
+	/** Called when a friend invite of the user has been accepted. */
+	virtual void OnInviteAccepted(const FUniqueNetId& UserId, const FUniqueNetId& FriendId);
+
+	/** Called when the presence of a user has been received. Updates the online status of the cached friend. */
+	virtual void OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence);
+
+	/** @return Path of the friends list snapshot of the current user. Empty if the user is not logged in. */
+	FString GetFriendsListSnapshotPath() const;
+
+	/** Save the cached friends lists to disk, so that they are available before the friends lists are read during the next startup. */
+	void SaveFriendsListSnapshot() const;
+
+	/** Load the cached friends lists from disk. Lists that have already been read from the online subsystem are not overwritten. */
+	void LoadFriendsListSnapshot();
+
 protected:
 
 	/**
@@ -6,6 +6,8 @@
 #include "GameFramework/GameModeBase.h"
 #include "KronosLobbyGameMode.generated.h"
 
+class AKronosLobbyPlayerState;
+
 /**
  * Possible lobby states.
  */
@@ -81,6 +83,9 @@ protected:
 	/** Handle used to tick the lobby. Runs on a one sec timer. */
 	FTimerHandle TimerHandle_TickLobby;
 
+	/** Handle used to update the lobby state once after the players have changed during a frame. */
+	FTimerHandle TimerHandle_UpdateLobbyState;
+
 public:
 
 	/** Starts the lobby. */
@@ -119,10 +124,19 @@ protected:
 	/** Initializes the lobby. */
 	virtual void InitializeLobby();
 
-	/** Called when the lobby ticks (once every sec). */
+	/** Called when the lobby ticks (once every sec). Counts down the lobby timer. */
 	virtual void TickLobby();
 
-	/** Called when the lobby ticks while waiting for players. */
+	/**
+	 * Moves the lobby to the next state based on the number of players and ready players.
+	 * Called when a player joins, leaves or changes ready state, so that the lobby doesn't have to wait for the next tick.
+	 */
+	virtual void UpdateLobbyState();
+
+	/** Schedule a lobby state update for the next frame. Changes during the same frame are handled together. */
+	virtual void RequestUpdateLobbyState();
+
+	/** Called when the lobby state is updated while waiting for players. */
 	virtual void HandleWaitingForPlayers();
 
 	/** Called when the lobby ticks while waiting to start. */
@@ -131,6 +145,18 @@ protected:
 	/** Called when the lobby ticks while the lobby is starting- */
 	virtual void HandleStartingMatch();
 
+	/** Called when a player joins the lobby. */
+	UFUNCTION()
+	virtual void OnPlayerConnectedToLobby(AKronosLobbyPlayerState* PlayerState);
+
+	/** Called when a player leaves the lobby. */
+	UFUNCTION()
+	virtual void OnPlayerDisconnectedFromLobby(AKronosLobbyPlayerState* PlayerState);
+
+	/** Called when the number of ready players changes. */
+	UFUNCTION()
+	virtual void OnNumReadyPlayersChanged(const int32 NumReadyPlayers);
+
 	/** Called when the lobby started. */
 	virtual void OnMatchStarted();
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
+#include "UObject/ObjectKey.h"
 #include "KronosLobbyGameState.generated.h"
 
 class AKronosLobbyPlayerState;
@@ -24,6 +25,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerConnectedToKronosLobby, AKr
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerDisconnectedFromKronosLobby, AKronosLobbyPlayerState*, PlayerState);
 
+/**
+ * Delegate triggered when the number of ready players changes.
+ *
+ * @param NumReadyPlayers The new number of ready players.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnKronosLobbyNumReadyPlayersChanged, const int32, NumReadyPlayers);
+
 /**
  * Delegate triggered when the lobby state changes.
  *
@@ -39,6 +47,35 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnKronosLobbyStateChanged, const EK
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnKronosLobbyUpdated, const EKronosLobbyState, LobbyState, const int32, LobbyCountdownTime);
 
+/**
+ * A lobby player start and the pawn that occupies it.
+ */
+struct FKronosLobbyPlayerStartSlot
+{
+	/** The player start. */
+	TWeakObjectPtr<APlayerStart> PlayerStart;
+
+	/** The pawn that occupies the player start. Invalid if the player start is free. */
+	TWeakObjectPtr<const APawn> Occupant;
+
+	/** Whether the player start is reserved for the local player. */
+	bool bIsLocal;
+
+	/** Default constructor. */
+	FKronosLobbyPlayerStartSlot() :
+		PlayerStart(nullptr),
+		Occupant(nullptr),
+		bIsLocal(false)
+	{}
+
+	/** Preferred constructor. */
+	FKronosLobbyPlayerStartSlot(APlayerStart* InPlayerStart, const bool bInIsLocal) :
+		PlayerStart(InPlayerStart),
+		Occupant(nullptr),
+		bIsLocal(bInIsLocal)
+	{}
+};
+
 /**
  * Game state to be paired with the LobbyGameMode class.
  */
@@ -67,6 +104,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnPlayerDisconnectedFromKronosLobby OnPlayerDisconnectedFromLobby;
 
+	/** Event when the number of ready players changes. */
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnKronosLobbyNumReadyPlayersChanged OnNumReadyPlayersChanged;
+
 	/** Event when the lobby state changes. */
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnKronosLobbyStateChanged OnLobbyStateChanged;
@@ -85,12 +126,37 @@ protected:
 	UPROPERTY(ReplicatedUsing = OnRep_LobbyCountdownTime)
 	int32 LobbyTimer;
 
+	/** Player starts of the lobby. Registered once, when the first pawn is looking for a player start. */
+	TArray<FKronosLobbyPlayerStartSlot> PlayerStartSlots;
+
+	/** Indices of the free local player starts. */
+	TArray<int32> FreeLocalPlayerStartSlots;
+
+	/** Indices of the free remote player starts. */
+	TArray<int32> FreeRemotePlayerStartSlots;
+
+	/** Index of the player start occupied by each pawn. */
+	TMap<TWeakObjectPtr<const APawn>, int32> OccupiedPlayerStartSlots;
+
+	/** Lobby players that have been added to the player array. */
+	TSet<TObjectKey<AKronosLobbyPlayerState>> LobbyPlayers;
+
+	/** Lobby players who are ready. Updated when a player joins, leaves, or changes ready state, so the players don't have to be counted. */
+	TSet<TObjectKey<AKronosLobbyPlayerState>> ReadyPlayers;
+
 public:
 
-	/** Find a new player start for the given pawn. This is used when we want to have the local player in a fix spot. */
+	/**
+	 * Find a new player start for the given pawn, and mark it occupied by the pawn. This is used when we want to have the local player in a fix spot.
+	 * Returns the same player start if the pawn already occupies one.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Default")
 	virtual APlayerStart* FindPlayerStart(const APawn* PlayerPawn);
 
+	/** Free the player start occupied by the given pawn. */
+	UFUNCTION(BlueprintCallable, Category = "Default")
+	virtual void ReleasePlayerStart(const APawn* PlayerPawn);
+
 	/** Get the current lobby state. */
 	UFUNCTION(BlueprintPure, Category = "Default")
 	EKronosLobbyState GetLobbyState() const { return LobbyState; }
@@ -105,7 +171,7 @@ public:
 
 	/** Get the number of players who are ready. */
 	UFUNCTION(BlueprintPure, Category = "Default")
-	virtual int32 GetNumReadyPlayers() const;
+	virtual int32 GetNumReadyPlayers() const { return ReadyPlayers.Num(); }
 
 	/** Check whether all players are ready or not. */
 	UFUNCTION(BlueprintPure, Category = "Default")
@@ -119,7 +185,20 @@ protected:
 	/** Changes lobby countdown time. Called by the game mode. */
 	virtual void SetLobbyCountdownTime(const int32 InLobbyCountdownTime);
 
+	/** Register the player starts of the world, sorted into local and remote player starts by their tag. */
+	virtual void RegisterPlayerStarts();
+
+	/** Free the player starts whose pawn has been destroyed without releasing them. */
+	virtual void ReclaimPlayerStarts();
+
+	/** Called by lobby player states when their ready state changes. */
+	virtual void NotifyPlayerIsReadyChanged(AKronosLobbyPlayerState* LobbyPlayerState, const bool bIsReady);
+
+	/** Add or remove the given player from the ready players. */
+	virtual void UpdateReadyPlayer(AKronosLobbyPlayerState* LobbyPlayerState, const bool bIsReady);
+
 	friend class AKronosLobbyGameMode;
+	friend class AKronosLobbyPlayerState;
 
 protected:
 
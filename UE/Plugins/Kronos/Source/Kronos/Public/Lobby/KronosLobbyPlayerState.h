@@ -113,6 +113,9 @@ protected:
 	UFUNCTION(Server, Reliable)
 	virtual void ServerSetPlayerIsReady(bool bReady);
 
+	/** Changes the local ready state, and notifies the game state and listeners if it changed. */
+	virtual void UpdatePlayerIsReady(bool bReady);
+
 	/** Called when the player data replicates from the server. */
 	UFUNCTION()
 	virtual void OnRep_PlayerData();